@@ -10,7 +10,7 @@
 
 #define configUSE_PREEMPTION                    1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
-#define configUSE_TICKLESS_IDLE                 0
+#define configUSE_TICKLESS_IDLE                 1
 #define configCPU_CLOCK_HZ                      ( ( unsigned long ) BCLK__BUS_CLK__HZ  )
 #define configTICK_RATE_HZ                      1000
 #define configMAX_PRIORITIES                    11
@@ -31,23 +31,41 @@
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
 
 /* Memory allocation related definitions. */
-#define configSUPPORT_STATIC_ALLOCATION         0   /* Static and dynamic are different sides of the same */
-#define configSUPPORT_DYNAMIC_ALLOCATION        1   /*    coin and must always be set opposite each other */
-#define configTOTAL_HEAP_SIZE                   30000
+/* Every task, queue and semaphore is created static (see main.c), the heap */
+/*  only holds the FreeRTOS+CLI command list. Run tools/ram_map.c on the   */
+/*  build output for the RAM used by each task and object.                 */
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configTOTAL_HEAP_SIZE                   256
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                     0
-#define configUSE_TICK_HOOK                     0
+#define configUSE_TICK_HOOK                     1
 #define configCHECK_FOR_STACK_OVERFLOW          0
-#define configUSE_MALLOC_FAILED_HOOK            0
+#define configUSE_MALLOC_FAILED_HOOK            1
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+#define configGENERATE_RUN_TIME_STATS           1
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    1
 
+/* Run-time counter from SysTick, see console.h */
+extern void consoleRunTimeStart( void );
+extern uint32_t consoleRunTime( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() consoleRunTimeStart()
+#define portGET_RUN_TIME_COUNTER_VALUE()        consoleRunTime()
+
+/* Tickless idle: the idle task sleeps through power.c, which stops the  */
+/*  tick (port SysTick tickless) unless a tick hook needs every tick, and  */
+/*  counts the time asleep per navigation state, see power.h               */
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+extern void powerSuppressTicksAndSleep( uint32_t expectedIdle );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) powerSuppressTicksAndSleep( xExpectedIdleTime )
+extern uint32_t powerPreSleep( uint32_t idle );
+#define configPRE_SLEEP_PROCESSING( x )         ( x ) = powerPreSleep( x )
+
 /* Co-routine "intended for use on very small processors" so disabled */
 #define configUSE_CO_ROUTINES                   0
 #define configMAX_CO_ROUTINE_PRIORITIES         1
@@ -83,14 +101,14 @@ See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 /* Optional functions - most linkers will remove unused functions anyway. */
 #define INCLUDE_vTaskPrioritySet                1
 #define INCLUDE_uxTaskPriorityGet               1
-#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskDelete                     0   /* tasks live for the whole run */
 #define INCLUDE_vTaskSuspend                    1
 #define INCLUDE_xResumeFromISR                  1
 #define INCLUDE_vTaskDelayUntil                 1
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
 #define INCLUDE_xTaskGetIdleTaskHandle          1
 #define INCLUDE_eTaskGetState                   1
 #define INCLUDE_xEventGroupSetBitFromISR        1
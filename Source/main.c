@@ -32,10 +32,28 @@
 #include "battery_level.h"
 #include "mode.h"
 #include "path.h"
+#include "navigation.h"
+#include "console.h"
+#include "periodic.h"
+#include "power.h"
+#include "rate_policy.h"
+#include "dead_reckoning.h"
+#include "kalman_filter.h"
+#include "heading_fusion.h"
+#include "trace.h"
+#include "debug_tx.h"
+#include "task_config.h"
+
+#if SPEECH_STORE_MODE == 1
+    #include "speech_store.h"
+#endif
 
 #if OBJ_DETECT_MODE == 1
     #include "distance.h"
     #include "motor.h"
+    #include "obstacle.h"
+    #include "haptic.h"
+    #include "occupancy.h"
 #endif
 
 #include "FreeRTOS.h"
@@ -43,12 +61,22 @@
 #include "semphr.h"
 #include "queue.h"
 
+#if CONSOLE_MODE == 1
+    #include "FreeRTOS_CLI.h"
+#endif
+
 /*******************************************************************************
 *                               CONSTANT DEFINITIONS
 *******************************************************************************/
 #define TABLE_LENGTH 720
 #define SOUND_VOLUME 1.5
 #define PATH_PROXIMITY 5 // (meters) For way point updates and destination check
+#define SOUND_BLOCKED_CM 150 // (cm) Obstacle range that blocks the way to the target
+#define SOUND_BLOCKED_ARC 20 // (degrees) Half width of the arc checked towards the target
+#define ACCEL_COUNTS_PER_MG 16 // +-2 g high resolution, 12 bits left justified
+#define METRES_PER_DEGREE 111320.0 // (meters) Per degree of latitude, for dead reckoning
+#define KNOTS_TO_MMS 514.444 // (mm/s) Per knot, RMC speed over ground
+#define CYCLES_PER_US ( configCPU_CLOCK_HZ / 1000000UL ) // DWT cycle counter
 
 #define ON();       { AMux_1_Start(); AMux_2_Start(); }
 #define OFF();      { AMux_1_DisconnectAll(); AMux_2_DisconnectAll();}
@@ -58,28 +86,13 @@
 // Speech sythesiser output - SPEECH for short
 #define SPEECH();   { AMux_1_FastSelect(1); AMux_2_FastSelect(1); } 
 
-/*******************************************************************************
-*                               TASK PRIORITIES
-*******************************************************************************/
-#define TASK_GPS_PRIO           (configMAX_PRIORITIES - 2)
-#define TASK_PATH_PRIO          (configMAX_PRIORITIES - 3)
-#define TASK_DIRECTION_PRIO     (configMAX_PRIORITIES - 4)
-#define TASK_SOUND_PRIO         (configMAX_PRIORITIES - 5)
-#define TASK_SPEECH_PRIO        (configMAX_PRIORITIES - 6)
-#define TASK_BATTERY_LEVEL_PRIO (configMAX_PRIORITIES - 7)
-#define TASK_BUTTON_PRIO        (configMAX_PRIORITIES - 1)
-#define TASK_LED_PRIO           (configMAX_PRIORITIES - 10)
-#if OBJ_DETECT_MODE == 1
-    #define TASK_MOTOR_PRIO     (configMAX_PRIORITIES - 8)
-    #define TASK_DIS_PRIO       (configMAX_PRIORITIES - 9)
-#endif
-
 /*******************************************************************************
 *                               TASK STACK SIZES
 *******************************************************************************/
 #define TASK_GPS_STK_SIZE           500
 #define TASK_SPEECH_STK_SIZE        500
 #define TASK_PATH_STK_SIZE          500
+#define TASK_MOTION_STK_SIZE        300
 #define TASK_DIRECTION_STK_SIZE     500
 #define TASK_SOUND_STK_SIZE         500
 #define TASK_BATTERY_LEVEL_STK_SIZE 500
@@ -89,6 +102,42 @@
     #define TASK_MOTOR_STK_SIZE     200
     #define TASK_DIS_STK_SIZE       200
 #endif
+#if CONSOLE_MODE == 1
+    #define TASK_CONSOLE_STK_SIZE   300
+#endif
+#if TRACE_MODE == 1
+    #define TASK_TRACE_STK_SIZE     200
+#endif
+#define TASK_DEBUG_TX_STK_SIZE      200
+
+/*******************************************************************************
+*                               QUEUE LENGTHS
+*******************************************************************************/
+#define GPS_SEMAPHORE_MAX           10  // received characters not yet read
+#define BUTTON_TIME_QUEUE_LENGTH    1
+#if OBJ_DETECT_MODE == 1
+    #define OBSTACLE_QUEUE_LENGTH   1   // mailbox, newest frame only
+#endif
+#if CONSOLE_MODE == 1
+    #define CONSOLE_QUEUE_LENGTH    2
+#endif
+
+/*******************************************************************************
+*                              DEBUG TX BENCHMARK
+*******************************************************************************/
+#if CONSOLE_MODE == 1
+    #define TXBENCH_MS              5000    // flood duration (ms)
+    #define TXBENCH_LINE_MS         2       // time between flood lines (ms)
+#endif
+
+/*******************************************************************************
+*                           OBSTACLE LATENCY HISTOGRAM
+*******************************************************************************/
+#if OBJ_DETECT_MODE == 1
+    #define LATENCY_BIN_MS          10  // histogram bin width (ms)
+    #define LATENCY_BINS            11  // last bin counts everything >= 100 ms
+    #define LATENCY_PRINT_FRAMES    50  // frames between histogram prints
+#endif
 
 /*******************************************************************************
 *                               GLOBAL VARIABLES
@@ -117,34 +166,45 @@ struct Path path = {
     .atDestination = pdFALSE,
 };
 
-/* GPS variables */
+/* GPS variables, the position is dead reckoned between fixes during a walk */
 long double latitudeInDec, longitudeInDec;
-int firstFix = 0;
 double direction = 0;
 
+/* Dead reckoning origin, the first fix of the walk, and cos of its latitude */
+long double originLat, originLon;
+double originCos = 1;
+
 /* Path variables */
 int nextCheckpoint = 0; // stores the next checkpoint array index
 
-/* Sound variables */
-BaseType_t soundState = pdFALSE;
+/* Periodic task timing, reported by the console timing command */
+periodicTask pathTiming, directionTiming, soundTiming, motionTiming;
+#if TRACE_MODE == 1
+    periodicTask traceTiming;
+#endif
+
+/* Speech variables */
+TickType_t speechBlockedTicks = 0; // time navigation audio was held by speech this walk
 
 /* Battery Level variables */
 int batteryLevelValue = 0;
 
 /* Variables for debugging/testing */
 #if DEBUG_PRINT_MODE == 1
-    /* Checkpoint name printing */
-    int checkpointName[15] = { 
-        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 
-    };
-    
     /* PC UART printing */
     char tempStr[100]; 
 #endif
 
+/* GPS receive statistics, reported by the txbench command */
+#if CONSOLE_MODE == 1
+    volatile uint32_t gpsSentences = 0;     // NMEA sentences received
+    volatile TickType_t gpsLongestGap = 0;  // longest time between sentences (ticks)
+#endif
+
 /* Variables for object detection */
 #if OBJ_DETECT_MODE == 1
-    ultrasonicSensor ultrasonicReadings;
+    /* Sample to PWM update latency histogram, LATENCY_BIN_MS wide bins */
+    uint32_t obstacleLatency[LATENCY_BINS];
 #endif
 
 /*******************************************************************************
@@ -152,6 +212,7 @@ int batteryLevelValue = 0;
 *******************************************************************************/
 TaskHandle_t vTaskGPSHandle           = NULL;
 TaskHandle_t vTaskPathHandle          = NULL;
+TaskHandle_t vTaskMotionHandle        = NULL;
 TaskHandle_t vTaskSpeechHandle        = NULL;
 TaskHandle_t vTaskDirectionHandle     = NULL;
 TaskHandle_t vTaskSoundHandle         = NULL;
@@ -162,32 +223,102 @@ TaskHandle_t vTaskLEDHandle           = NULL;
     TaskHandle_t xTaskMotorHandle     = NULL;
     TaskHandle_t xTaskDistanceHandle  = NULL;
 #endif
+#if CONSOLE_MODE == 1
+    TaskHandle_t xTaskConsoleHandle   = NULL;
+#endif
+#if TRACE_MODE == 1
+    TaskHandle_t xTaskTraceHandle     = NULL;
+#endif
+TaskHandle_t xTaskDebugTxHandle       = NULL;
 
 /*******************************************************************************
 *                               SEMAPHORE HANDLERS
 *******************************************************************************/
 SemaphoreHandle_t xGPSSemaphore;
-SemaphoreHandle_t xUARTMutex;
-SemaphoreHandle_t xBatteryLevelMutex;
 SemaphoreHandle_t xDirectionMutex;
 SemaphoreHandle_t xCoordinatesMutex;
-SemaphoreHandle_t xObstacleDistanceMutex;
+SemaphoreHandle_t xCompassMutex;            // I2C to the LSM303, shared by direction and motion
 
 /*******************************************************************************
 *                               QUEUE HANDLERS
 *******************************************************************************/
 QueueHandle_t xButtonTimeQueue;
+#if OBJ_DETECT_MODE == 1
+    QueueHandle_t xObstacleDistanceQueue;   // newest filtered distance frame (mailbox)
+#endif
+#if CONSOLE_MODE == 1
+    QueueHandle_t xConsoleQueue;            // command lines received on the UART
+#endif
+
+/*******************************************************************************
+*                             STATIC KERNEL OBJECTS
+*******************************************************************************/
+/* Every task, queue and semaphore lives here rather than on the heap. Names
+   are <object>Stack / <object>Tcb for tasks and <object>Storage /
+   <object>Buffer for queues, which tools/ram_map.c groups by object. */
+#define TASK_MEMORY( name, depth ) \
+    static StackType_t name##Stack[ depth ]; \
+    static StaticTask_t name##Tcb
+#define QUEUE_MEMORY( name, length, itemSize ) \
+    static uint8_t name##Storage[ (length) * (itemSize) ]; \
+    static StaticQueue_t name##Buffer
+
+TASK_MEMORY( vTaskGPS,          TASK_GPS_STK_SIZE );
+TASK_MEMORY( vTaskPath,         TASK_PATH_STK_SIZE );
+TASK_MEMORY( vTaskMotion,       TASK_MOTION_STK_SIZE );
+TASK_MEMORY( vTaskSpeech,       TASK_SPEECH_STK_SIZE );
+TASK_MEMORY( vTaskDirection,    TASK_DIRECTION_STK_SIZE );
+TASK_MEMORY( vTaskSound,        TASK_SOUND_STK_SIZE );
+TASK_MEMORY( vTaskBatteryLevel, TASK_BATTERY_LEVEL_STK_SIZE );
+TASK_MEMORY( vTaskButton,       TASK_BUTTON_STK_SIZE );
+TASK_MEMORY( vTaskLED,          TASK_LED_STK_SIZE );
+#if OBJ_DETECT_MODE == 1
+    TASK_MEMORY( vTaskDistance, TASK_DIS_STK_SIZE );
+    TASK_MEMORY( vTaskMotor,    TASK_MOTOR_STK_SIZE );
+#endif
+#if CONSOLE_MODE == 1
+    TASK_MEMORY( vTaskConsole,  TASK_CONSOLE_STK_SIZE );
+#endif
+#if TRACE_MODE == 1
+    TASK_MEMORY( vTaskTrace,    TASK_TRACE_STK_SIZE );
+#endif
+TASK_MEMORY( vTaskDebugTx,      TASK_DEBUG_TX_STK_SIZE );
+
+/* Kernel tasks, handed over in vApplicationGet...TaskMemory() */
+TASK_MEMORY( xIdleTask,         configMINIMAL_STACK_SIZE );
+TASK_MEMORY( xTimerTask,        configTIMER_TASK_STACK_DEPTH );
+
+/* Semaphores and mutexes need no storage */
+static StaticSemaphore_t xGPSSemaphoreBuffer;
+static StaticSemaphore_t xDirectionMutexBuffer;
+static StaticSemaphore_t xCoordinatesMutexBuffer;
+static StaticSemaphore_t xCompassMutexBuffer;
+
+QUEUE_MEMORY( xButtonTimeQueue, BUTTON_TIME_QUEUE_LENGTH, sizeof(portFLOAT) );
+#if OBJ_DETECT_MODE == 1
+    QUEUE_MEMORY( xObstacleDistanceQueue, OBSTACLE_QUEUE_LENGTH, sizeof(ultrasonicSensor) );
+#endif
+#if CONSOLE_MODE == 1
+    QUEUE_MEMORY( xConsoleQueue, CONSOLE_QUEUE_LENGTH, CONSOLE_LINE_LENGTH );
+#endif
 
 /*******************************************************************************
 *                             FUNCTION DECLARATIONS
 *******************************************************************************/
 extern void RTOS_Start( void );
+static navState navigationPost( navEvent event );
+static void periodicRestart( periodicTask *task, TickType_t *wake );
+static void periodicWait( periodicTask *task, TickType_t *wake );
+static void rateApply( void );
+static void positionToLocal( long double lat, long double lon, int32_t *east, int32_t *north );
+static void positionFromLocal( int32_t east, int32_t north, long double *lat, long double *lon );
 
 /*******************************************************************************
 *                               TASK DECLARATIONS
 *******************************************************************************/
 static void vTaskGPS            ( void *pvParameter );
 static void vTaskPath           ( void *pvParameter );
+static void vTaskMotion         ( void *pvParameter );
 static void vTaskSpeech         ( void *pvParameter );
 static void vTaskDirection      ( void *pvParameter );
 static void vTaskSound          ( void *pvParameter );
@@ -200,6 +331,39 @@ static void vTaskDistance       ( void *pvParameter );
 static void vTaskMotor          ( void *pvParameter );
 #endif
 
+#if CONSOLE_MODE == 1
+static void vTaskConsole        ( void *pvParameter );
+#endif
+
+#if TRACE_MODE == 1
+static void vTaskTrace          ( void *pvParameter );
+#endif
+
+static void vTaskDebugTx        ( void *pvParameter );
+
+/*******************************************************************************
+*                              CONSOLE COMMANDS
+*******************************************************************************/
+#if CONSOLE_MODE == 1
+static BaseType_t txbenchCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+
+static const CLI_Command_Definition_t TXBENCH_COMMAND = {
+    "txbench",
+    "txbench: flood debug output for 5 s, report TX drops and GPS sentences received\r\n",
+    txbenchCommand,
+    0
+};
+
+static BaseType_t rateCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+
+static const CLI_Command_Definition_t RATE_COMMAND = {
+    "rate",
+    "rate <50..200>: set the speech playback rate (%), report speech blocked time this walk\r\n",
+    rateCommand,
+    1
+};
+#endif
+
 /*******************************************************************************
 *                           INTERRUPT SERVICE ROUTINES
 *******************************************************************************/
@@ -235,6 +399,41 @@ CY_ISR( ISR_Button )
     portYIELD_FROM_ISR( xHigherPriorityTaskWoken );  
 }
 
+/*******************************************************************************
+*                                   RTOS HOOKS
+*******************************************************************************/
+/* Tick hook, runs every tick even while the scheduler is suspended */
+void vApplicationTickHook( void )
+{
+    #if OBJ_DETECT_MODE == 1
+        distanceTickHook();                       // Continuous ultrasonic sampling
+        hapticTickHook();                         // Haptic envelope playback
+    #endif
+}
+
+/* Heap only holds the console command list, running out is a sizing bug */
+void vApplicationMallocFailedHook( void )
+{
+    taskDISABLE_INTERRUPTS();
+    for(;;);
+}
+
+/* Idle task memory, required with configSUPPORT_STATIC_ALLOCATION */
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTcb;
+    *ppxIdleTaskStackBuffer = xIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+/* Timer service task memory, required with configSUPPORT_STATIC_ALLOCATION */
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+{
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTcb;
+    *ppxTimerTaskStackBuffer = xTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
 /*******************************************************************************
 *                               PSOC START FUNCTION
 *******************************************************************************/
@@ -242,6 +441,7 @@ void PSOC_Start( void )
 {
     /* Start UART for GPS and debug printing */
     UART_Start();
+    debugTxStart();
     
     /* Start Button */
     Timer_1_Start();
@@ -250,8 +450,30 @@ void PSOC_Start( void )
     startSoundComponents();
     dmaConfiguration();
     
-    /* Start and Initialize Speech */
+    /* Start and Initialize Speech. The scheduler is not running yet, so
+       output is blocking: debugPrint() needs its critical sections */
     synthInitialize();
+    #if SPEECH_STORE_MODE == 1
+        if ( !speechStoreStart() )
+        {
+            #if DEBUG_PRINT_MODE == 1
+                UART_PutString( "Speech store image not found\n" );
+            #endif
+        }
+    #endif
+    #if SYNTH_PROFILE_MODE == 1 && DEBUG_PRINT_MODE == 1
+        {
+            uint32_t referenceCycles, blockCycles;
+            
+            /* Check the lattice kernel against the C reference and time both */
+            sprintf( tempStr, "Lattice kernel mismatches: %u\n", (unsigned)lpc_lattice_compare() );
+            UART_PutString( tempStr );
+            synth_benchmark( &referenceCycles, &blockCycles );
+            sprintf( tempStr, "Lattice cycles/sample: reference %lu, block %lu\n",
+                (unsigned long)referenceCycles, (unsigned long)blockCycles );
+            UART_PutString( tempStr );
+        }
+    #endif
     
     /* Start and Initialize Compass */
     compassStart();
@@ -273,10 +495,13 @@ int main( void )
     /* System Initialization */
     RTOS_Start();
     PSOC_Start();
+    powerStart();                                 // Energy counters, audio blocks off until claimed
     
+    powerClaim( POWER_SPEECH );
     SPEECH();
     sayWelocome(); sayPause();                    // Vocalize Welcome greeting
     OFF();
+    powerRelease( POWER_SPEECH );
     
     /* Interrupts */
     isr_GPS_Received_ClearPending();              // Cancel any pending isr_RxSignal interrupts
@@ -286,21 +511,50 @@ int main( void )
     isr_button_StartEx( ISR_Button );             // Enable the interrupt service routine
     
     /* Creating Semaphores and Mutxes */
-    xGPSSemaphore = xSemaphoreCreateCounting( 10, 0 );
-    xUARTMutex = xSemaphoreCreateMutex();
-    xBatteryLevelMutex = xSemaphoreCreateMutex();
-    xDirectionMutex = xSemaphoreCreateMutex();
-    xCoordinatesMutex = xSemaphoreCreateMutex();
-    xObstacleDistanceMutex = xSemaphoreCreateMutex();
-    xButtonTimeQueue = xQueueCreate( 1, sizeof(portFLOAT) );
+    xGPSSemaphore = xSemaphoreCreateCountingStatic( GPS_SEMAPHORE_MAX, 0, &xGPSSemaphoreBuffer );
+    xDirectionMutex = xSemaphoreCreateMutexStatic( &xDirectionMutexBuffer );
+    xCoordinatesMutex = xSemaphoreCreateMutexStatic( &xCoordinatesMutexBuffer );
+    xCompassMutex = xSemaphoreCreateMutexStatic( &xCompassMutexBuffer );
+    #if OBJ_DETECT_MODE == 1
+        xObstacleDistanceQueue = xQueueCreateStatic( OBSTACLE_QUEUE_LENGTH, sizeof(ultrasonicSensor),
+            xObstacleDistanceQueueStorage, &xObstacleDistanceQueueBuffer );
+    #endif
+    xButtonTimeQueue = xQueueCreateStatic( BUTTON_TIME_QUEUE_LENGTH, sizeof(portFLOAT),
+        xButtonTimeQueueStorage, &xButtonTimeQueueBuffer );
+    #if CONSOLE_MODE == 1
+        xConsoleQueue = xQueueCreateStatic( CONSOLE_QUEUE_LENGTH, CONSOLE_LINE_LENGTH,
+            xConsoleQueueStorage, &xConsoleQueueBuffer );
+        
+        /* Report every queue and semaphore on the console */
+        consoleWatchQueue( xGPSSemaphore, "gps" );
+        consoleWatchQueue( xDirectionMutex, "direction" );
+        consoleWatchQueue( xCoordinatesMutex, "coordinates" );
+        consoleWatchQueue( xCompassMutex, "compass" );
+        consoleWatchQueue( xButtonTimeQueue, "button time" );
+        consoleWatchQueue( xConsoleQueue, "console" );
+        #if OBJ_DETECT_MODE == 1
+            consoleWatchQueue( xObstacleDistanceQueue, "obstacle" );
+        #endif
+        consoleStart();
+        FreeRTOS_CLIRegisterCommand( &TXBENCH_COMMAND );
+        FreeRTOS_CLIRegisterCommand( &RATE_COMMAND );
+    #endif
+    
+    /* Periodic task timing, periods scaled by the rate policy during walks */
+    rateReset();
+    periodicInit( &pathTiming, "path", TASK_PATH_PERIOD_MS );
+    periodicInit( &directionTiming, "direction", TASK_DIRECTION_PERIOD_MS );
+    periodicInit( &soundTiming, "sound", TASK_SOUND_PERIOD_MS );
+    periodicInit( &motionTiming, "motion", TASK_MOTION_PERIOD_MS );
+    #if TRACE_MODE == 1
+        periodicInit( &traceTiming, "trace", TRACE_DRAIN_MS );
+    #endif
     
     /* Creating Tasks */
-    if ( xGPSSemaphore != NULL || xUARTMutex != NULL || xButtonTimeQueue != NULL || xBatteryLevelMutex != NULL )
+    if ( xGPSSemaphore != NULL || xButtonTimeQueue != NULL )
     {
-        BaseType_t err;
-        
-        err = xTaskCreate( vTaskGPS, "task gps", TASK_GPS_STK_SIZE, (void*) 0, TASK_GPS_PRIO, &vTaskGPSHandle );
-        if ( err != pdPASS ){
+        vTaskGPSHandle = xTaskCreateStatic( vTaskGPS, "task gps", TASK_GPS_STK_SIZE, (void*) 0, TASK_GPS_PRIO, vTaskGPSStack, &vTaskGPSTcb );
+        if ( vTaskGPSHandle == NULL ){
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "Failed to Create Task GPS\n" );
                 UART_PutString( tempStr );
@@ -308,8 +562,8 @@ int main( void )
             while(1){};
         }
       
-        err = xTaskCreate ( vTaskSpeech, "task speech", TASK_SPEECH_STK_SIZE, (void*) 0, TASK_SPEECH_PRIO, &vTaskSpeechHandle );
-        if ( err != pdPASS ){
+        vTaskSpeechHandle = xTaskCreateStatic( vTaskSpeech, "task speech", TASK_SPEECH_STK_SIZE, (void*) 0, TASK_SPEECH_PRIO, vTaskSpeechStack, &vTaskSpeechTcb );
+        if ( vTaskSpeechHandle == NULL ){
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "Failed to Create Task Speech\n" );
                 UART_PutString( tempStr );
@@ -317,8 +571,8 @@ int main( void )
             while(1){};
         }
 
-        err = xTaskCreate ( vTaskBatteryLevel, "task battery level", TASK_BATTERY_LEVEL_STK_SIZE, (void*) 0, TASK_BATTERY_LEVEL_PRIO, &vTaskBatteryLevelHandle );
-        if ( err != pdPASS ){
+        vTaskBatteryLevelHandle = xTaskCreateStatic( vTaskBatteryLevel, "task battery level", TASK_BATTERY_LEVEL_STK_SIZE, (void*) 0, TASK_BATTERY_LEVEL_PRIO, vTaskBatteryLevelStack, &vTaskBatteryLevelTcb );
+        if ( vTaskBatteryLevelHandle == NULL ){
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "Failed to Create Task Battery Level\n" );
                 UART_PutString( tempStr );
@@ -326,8 +580,8 @@ int main( void )
             while(1){};
         }
         
-        err = xTaskCreate ( vTaskButton, "task button ", TASK_BUTTON_STK_SIZE, (void*) 0, TASK_BUTTON_PRIO, &vTaskButtonHandle );
-        if ( err != pdPASS ){
+        vTaskButtonHandle = xTaskCreateStatic( vTaskButton, "task button ", TASK_BUTTON_STK_SIZE, (void*) 0, TASK_BUTTON_PRIO, vTaskButtonStack, &vTaskButtonTcb );
+        if ( vTaskButtonHandle == NULL ){
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "Failed to Create Task Button\n" );
                 UART_PutString( tempStr );
@@ -335,8 +589,45 @@ int main( void )
             while(1){};
         }
         
-        err = xTaskCreate ( vTaskLED, "task LED ", TASK_LED_STK_SIZE, (void*) 0, TASK_LED_PRIO, &vTaskLEDHandle );
-        if ( err != pdPASS ){
+        /* Navigation tasks live for the whole run and sleep until a walk starts */
+        vTaskPathHandle = xTaskCreateStatic( vTaskPath, "task path", TASK_PATH_STK_SIZE, (void*) 0, TASK_PATH_PRIO, vTaskPathStack, &vTaskPathTcb );
+        if ( vTaskPathHandle == NULL ){
+            #if DEBUG_PRINT_MODE == 1
+                sprintf( tempStr, "Failed to Create Task Path\n" );
+                UART_PutString( tempStr );
+            #endif
+            while(1){};
+        }
+        
+        vTaskMotionHandle = xTaskCreateStatic( vTaskMotion, "task motion", TASK_MOTION_STK_SIZE, (void*) 0, TASK_MOTION_PRIO, vTaskMotionStack, &vTaskMotionTcb );
+        if ( vTaskMotionHandle == NULL ){
+            #if DEBUG_PRINT_MODE == 1
+                sprintf( tempStr, "Failed to Create Task Motion\n" );
+                UART_PutString( tempStr );
+            #endif
+            while(1){};
+        }
+        
+        vTaskDirectionHandle = xTaskCreateStatic( vTaskDirection, "task direction", TASK_DIRECTION_STK_SIZE, (void*) 0, TASK_DIRECTION_PRIO, vTaskDirectionStack, &vTaskDirectionTcb );
+        if ( vTaskDirectionHandle == NULL ){
+            #if DEBUG_PRINT_MODE == 1
+                sprintf( tempStr, "Failed to Create Task Direction\n" );
+                UART_PutString( tempStr );
+            #endif
+            while(1){};
+        }
+        
+        vTaskSoundHandle = xTaskCreateStatic( vTaskSound, "task sound", TASK_SOUND_STK_SIZE, (void*) 0, TASK_SOUND_PRIO, vTaskSoundStack, &vTaskSoundTcb );
+        if ( vTaskSoundHandle == NULL ){
+            #if DEBUG_PRINT_MODE == 1
+                sprintf( tempStr, "Failed to Create Task Sound\n" );
+                UART_PutString( tempStr );
+            #endif
+            while(1){};
+        }
+        
+        vTaskLEDHandle = xTaskCreateStatic( vTaskLED, "task LED ", TASK_LED_STK_SIZE, (void*) 0, TASK_LED_PRIO, vTaskLEDStack, &vTaskLEDTcb );
+        if ( vTaskLEDHandle == NULL ){
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "Failed to Create Task LED\n" );
                 UART_PutString( tempStr );
@@ -345,16 +636,16 @@ int main( void )
         }
         
         #if OBJ_DETECT_MODE == 1
-            err = xTaskCreate(vTaskDistance, "task distance", TASK_DIS_STK_SIZE, (void*) 0, TASK_DIS_PRIO, &xTaskDistanceHandle);
-            if (err != pdPASS){
+            xTaskDistanceHandle = xTaskCreateStatic( vTaskDistance, "task distance", TASK_DIS_STK_SIZE, (void*) 0, TASK_DIS_PRIO, vTaskDistanceStack, &vTaskDistanceTcb );
+            if ( xTaskDistanceHandle == NULL ){
                 sprintf(tempStr, "Failed to Create Task Distance\n");
                 UART_WriteTxData(0x0d);
                 UART_PutString(tempStr);
                 while(1){};
             }
             
-            err = xTaskCreate(vTaskMotor, "task motor", TASK_MOTOR_STK_SIZE, (void*) 0, TASK_MOTOR_PRIO, &xTaskMotorHandle);
-            if (err != pdPASS){
+            xTaskMotorHandle = xTaskCreateStatic( vTaskMotor, "task motor", TASK_MOTOR_STK_SIZE, (void*) 0, TASK_MOTOR_PRIO, vTaskMotorStack, &vTaskMotorTcb );
+            if ( xTaskMotorHandle == NULL ){
                 sprintf(tempStr, "Failed to Create Task Motor\n");
                 UART_WriteTxData(0x0d);
                 UART_PutString(tempStr);
@@ -362,6 +653,37 @@ int main( void )
             }
         #endif
         
+        #if CONSOLE_MODE == 1
+            xTaskConsoleHandle = xTaskCreateStatic( vTaskConsole, "task console", TASK_CONSOLE_STK_SIZE, (void*) 0, TASK_CONSOLE_PRIO, vTaskConsoleStack, &vTaskConsoleTcb );
+            if ( xTaskConsoleHandle == NULL ){
+                #if DEBUG_PRINT_MODE == 1
+                    sprintf( tempStr, "Failed to Create Task Console\n" );
+                    UART_PutString( tempStr );
+                #endif
+                while(1){};
+            }
+        #endif
+        
+        #if TRACE_MODE == 1
+            xTaskTraceHandle = xTaskCreateStatic( vTaskTrace, "task trace", TASK_TRACE_STK_SIZE, (void*) 0, TASK_TRACE_PRIO, vTaskTraceStack, &vTaskTraceTcb );
+            if ( xTaskTraceHandle == NULL ){
+                #if DEBUG_PRINT_MODE == 1
+                    sprintf( tempStr, "Failed to Create Task Trace\n" );
+                    UART_PutString( tempStr );
+                #endif
+                while(1){};
+            }
+        #endif
+        
+        xTaskDebugTxHandle = xTaskCreateStatic( vTaskDebugTx, "task debug tx", TASK_DEBUG_TX_STK_SIZE, (void*) 0, TASK_DEBUG_TX_PRIO, vTaskDebugTxStack, &vTaskDebugTxTcb );
+        if ( xTaskDebugTxHandle == NULL ){
+            #if DEBUG_PRINT_MODE == 1
+                sprintf( tempStr, "Failed to Create Task Debug TX\n" );
+                UART_PutString( tempStr );
+            #endif
+            while(1){};
+        }
+        
         #if DEBUG_PRINT_MODE == 1
             sprintf( tempStr, "Main: Start\n\n" );
             UART_PutString( tempStr );
@@ -382,6 +704,92 @@ int main( void )
     for(;;);
 }
 
+/*******************************************************************************
+*                                PERIODIC TASKS
+*******************************************************************************/
+/* Microseconds from the run-time stats counter (see console.h) */
+#define PERIODIC_NOW()  ( portGET_RUN_TIME_COUNTER_VALUE() * (1000000UL / CONSOLE_RUNTIME_HZ) )
+
+/* Put the release grid at now, for the first job and after sleeping outside it */
+static void periodicRestart( periodicTask *task, TickType_t *wake )
+{
+    *wake = xTaskGetTickCount();
+    periodicBegin( task, PERIODIC_NOW() );
+}
+
+/* End this job and sleep until the next release, which does not drift with execution time */
+static void periodicWait( periodicTask *task, TickType_t *wake )
+{
+    periodicJobEnd( task, PERIODIC_NOW() );
+    vTaskDelayUntil( wake, pdMS_TO_TICKS( task->periodUs / 1000 ) );
+    periodicJobStart( task, PERIODIC_NOW() );
+}
+
+/* Put the rate plan in force for the compass and sonar, sound and GPS read theirs */
+static void rateApply( void )
+{
+    ratePlan plan;
+    
+    rateGetPlan( &plan );
+    periodicSetPeriod( &directionTiming, plan.periodMs[RATE_COMPASS] );
+    #if OBJ_DETECT_MODE == 1
+        distanceSetPace( plan.periodMs[RATE_SONAR] );
+    #endif
+    TRACE( TRACE_RATE_PLAN, plan.periodMs[RATE_COMPASS], plan.periodMs[RATE_SONAR],
+        plan.periodMs[RATE_SOUND], rateSavedUa( &plan ) );
+}
+
+/*******************************************************************************
+*                                 DEAD RECKONING
+*******************************************************************************/
+/* Degrees to mm east and north of the walk origin, flat earth is fine over a walk */
+static void positionToLocal( long double lat, long double lon, int32_t *east, int32_t *north )
+{
+    *east = (int32_t)( ( lon - originLon ) * METRES_PER_DEGREE * originCos * 1000 );
+    *north = (int32_t)( ( lat - originLat ) * METRES_PER_DEGREE * 1000 );
+}
+
+/* mm east and north of the walk origin to degrees */
+static void positionFromLocal( int32_t east, int32_t north, long double *lat, long double *lon )
+{
+    *lat = originLat + north / ( METRES_PER_DEGREE * 1000 );
+    *lon = originLon + east / ( METRES_PER_DEGREE * originCos * 1000 );
+}
+
+/*******************************************************************************
+*                                   NAVIGATION
+*******************************************************************************/
+/* Apply a session event, wake the navigation tasks when a walk starts */
+static navState navigationPost( navEvent event )
+{
+    navState from, to;
+    #if TRACE_MODE == 1
+        powerStats energy;
+    #endif
+    
+    to = navigationEvent( event, &from );
+    if ( to == NAV_NAVIGATING && from != NAV_NAVIGATING )
+    {
+        xTaskNotifyGive( vTaskPathHandle );
+        xTaskNotifyGive( vTaskMotionHandle );
+        xTaskNotifyGive( vTaskDirectionHandle );
+        xTaskNotifyGive( vTaskSoundHandle );
+    }
+    
+    /* Energy counters of the state left, so walk traces carry them */
+    #if TRACE_MODE == 1
+        if ( to != from )
+        {
+            powerGetStats( from, &energy );
+            TRACE( TRACE_ENERGY, from,
+                (uint32)( energy.time[POWER_ACTIVE] / ( CONSOLE_RUNTIME_HZ / 1000 ) ),
+                (uint32)( ( energy.time[POWER_WFI] + energy.time[POWER_TICKLESS] ) / ( CONSOLE_RUNTIME_HZ / 1000 ) ),
+                powerChargeUah( &energy ) );
+        }
+    #endif
+    return to;
+}
+
 /*******************************************************************************
 *                                   GPS TASK
 *******************************************************************************/
@@ -389,9 +797,20 @@ static void vTaskGPS ( void *pvParameter )
 {
     (void) pvParameter;
     const TickType_t xDelay40ms = pdMS_TO_TICKS(40UL);
-    char PT_term_buffer_GPS[120], GGA_buffer[66], ns, ew;
-    float latitude, longitude, gps_time;
+    char PT_term_buffer_GPS[120], GGA_buffer[83], ns, ew, status;
+    float latitude, longitude, gps_time, hdop = 0, speed, course;
     int n_char;
+    TickType_t lastFix = 0;
+    int32_t east, north;
+    uint32_t now, start;
+    uint8_t accepted;
+    deadReckonStats reckoning;
+    kalmanStats filter;
+    headingStats fusion;
+    
+    /* Enable the DWT cycle counter, the filter update takes microseconds */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
    
     while(1)
     {   
@@ -401,11 +820,7 @@ static void vTaskGPS ( void *pvParameter )
         while( n_char < 100 )
         {
             xSemaphoreTake( xGPSSemaphore, portMAX_DELAY );
-            xSemaphoreTake( xUARTMutex, portMAX_DELAY );
-            {
-                ch = UART_GetChar();
-            }
-            xSemaphoreGive( xUARTMutex );
+            ch = UART_GetChar();    // only this task reads RX, debug output has its own task
             if(ch == '\r') {
                 PT_term_buffer_GPS[n_char] = 0; // zero terminate the string
                 break;
@@ -417,10 +832,54 @@ static void vTaskGPS ( void *pvParameter )
             else  {PT_term_buffer_GPS[n_char++] = ch ;}
         } 
         
+        #if CONSOLE_MODE == 1
+            /* Console commands are framed as a sentence no GPS receiver sends */
+            if ( strncmp( PT_term_buffer_GPS, CONSOLE_SENTENCE, sizeof(CONSOLE_SENTENCE) - 1 ) == 0 )
+            {
+                char command[CONSOLE_LINE_LENGTH];
+                strncpy( command, PT_term_buffer_GPS + sizeof(CONSOLE_SENTENCE) - 1, CONSOLE_LINE_LENGTH - 1 );
+                command[CONSOLE_LINE_LENGTH - 1] = 0;
+                xQueueSend( xConsoleQueue, command, 0 );
+                continue;
+            }
+            
+            if ( PT_term_buffer_GPS[0] == '$' )
+            {
+                static TickType_t lastSentence = 0;
+                TickType_t received = xTaskGetTickCount();
+                
+                /* Receive statistics for txbench */
+                if ( gpsSentences > 0 && received - lastSentence > gpsLongestGap )
+                {
+                    gpsLongestGap = received - lastSentence;
+                }
+                lastSentence = received;
+                gpsSentences++;
+            }
+        #endif
+        
+        /* Noise and partial sentences are dropped */
+        if ( PT_term_buffer_GPS[0] != '$' )
+        {
+            continue;
+        }
+        
         if ( PT_term_buffer_GPS[4] == 'G' )
         { 
+            /* Rate policy: drop fixes until the next one the plan wants, half a
+               receiver fix interval early so a fix arriving a little early is
+               kept. RMC below is not throttled, heading fusion needs every course */
+            if ( navigationState() == NAV_NAVIGATING && xTaskGetTickCount() - lastFix <
+                 pdMS_TO_TICKS( ratePeriod( RATE_GPS ) - RATE_GPS_BASE_MS / 2 ) )
+            {
+                vTaskDelay(xDelay40ms);
+                continue;
+            }
+            
             // only extract GGA string
-            strncpy( GGA_buffer, PT_term_buffer_GPS, 66 );
+            lastFix = xTaskGetTickCount();
+            strncpy( GGA_buffer, PT_term_buffer_GPS, 82 );
+            GGA_buffer[82] = 0;
             
             char *p = strchr(GGA_buffer, ',');
             gps_time = atof(p+1); // if field is empty this encounters a comma and returns 0.0
@@ -436,57 +895,109 @@ static void vTaskGPS ( void *pvParameter )
 
             p = strchr(p+1, ',');
             ew = p[1] == ',' ? '?' : p[1];
+
+            /* Skip fix quality and satellites, HDOP sets the fix noise */
+            p = strchr(p+1, ',');
+            if ( p ) { p = strchr(p+1, ','); }
+            if ( p ) { p = strchr(p+1, ','); }
+            hdop = p ? atof(p+1) : 0;
+        }
+        else if ( PT_term_buffer_GPS[3] == 'R' && PT_term_buffer_GPS[4] == 'M' )
+        {
+            // RMC carries the course over ground for heading fusion
+            char *p = strchr(PT_term_buffer_GPS, ',');
+            int i;
+            if ( p ) { p = strchr(p+1, ','); }
+            status = p ? p[1] : 'V';
+            
+            /* Skip the position to speed (knots) and course (degrees) */
+            for ( i = 0; p && i < 5; i++ ) { p = strchr(p+1, ','); }
+            speed = p ? atof(p+1) : 0;
+            if ( p ) { p = strchr(p+1, ','); }
+            course = p ? atof(p+1) : 0;
+            
+            if ( status == 'A' && p && navigationState() == NAV_NAVIGATING )
+            {
+                xSemaphoreTake( xCoordinatesMutex, portMAX_DELAY );
+                {
+                    headingCourse( (int16_t)( course * 10 ), (uint32_t)( speed * KNOTS_TO_MMS ),
+                        xTaskGetTickCount() * portTICK_PERIOD_MS );
+                    headingGetStats( &fusion );
+                }
+                xSemaphoreGive( xCoordinatesMutex );
+                TRACE( TRACE_HEADING, (uint32)( speed * KNOTS_TO_MMS ), fusion.biasDdeg,
+                    fusion.fieldNt, fusion.referenceNt );
+            }
+            vTaskDelay(xDelay40ms);
+            continue;
+        }
+        else
+        {
+            vTaskDelay(xDelay40ms); // only GGA carries the position
+            continue;
         }
         
         xSemaphoreTake( xCoordinatesMutex, portMAX_DELAY );
         {
-            longitudeInDec = min2dec( longitude );
-            latitudeInDec = min2dec( latitude ) * -1;
+            if ( navigationState() != NAV_NAVIGATING )
+            {
+                longitudeInDec = min2dec( longitude );
+                latitudeInDec = min2dec( latitude ) * -1;
+            }
+            else if ( longitude != 0 || latitude != 0 )
+            {
+                /* During a walk the filtered fix resets dead reckoning; a
+                   rejected jump, or no fix, leaves it carrying on */
+                now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+                positionToLocal( min2dec( latitude ) * -1, min2dec( longitude ), &east, &north );
+                start = DWT->CYCCNT;
+                accepted = kalmanUpdate( east, north, (uint16_t)( hdop * 10 ), now );
+                kalmanUpdateTime( ( DWT->CYCCNT - start ) / CYCLES_PER_US );
+                if ( accepted )
+                {
+                    kalmanPredict( now, &east, &north );
+                    deadReckonFix( east, north, now );
+                    positionFromLocal( east, north, &latitudeInDec, &longitudeInDec );
+                    deadReckonGetStats( &reckoning );
+                    TRACE( TRACE_DEAD_RECKONING, reckoning.fixErrorMm, reckoning.stepsSinceFix,
+                        reckoning.stepMm, reckoning.kMm );
+                }
+                kalmanGetStats( &filter );
+                TRACE( TRACE_KALMAN, filter.innovationMm, filter.sigmaMm,
+                    (uint32)( hdop * 10 ), filter.updateUs );
+            }
         }
         xSemaphoreGive( xCoordinatesMutex );
 
-        #if DEBUG_PRINT_MODE == 1
-            sprintf(tempStr, "longitude: %Lf    latitude: %Lf\n", longitudeInDec, latitudeInDec);
-            UART_PutString( tempStr );
-        #endif
+        TRACE( TRACE_GPS_POSITION, traceCoordinate(min2dec( longitude )), traceCoordinate(min2dec( latitude ) * -1) );
         
-        if ( longitudeInDec == 0 && latitudeInDec == 0 )
+        if ( longitude == 0 && latitude == 0 )
         {
             xTaskNotify(vTaskSpeechHandle, (uint32_t)(1<<2)|(1<<0), (eNotifyAction)eSetValueWithOverwrite );
         }
         
-        if ( firstFix == 0 && longitudeInDec != 0 && latitudeInDec != 0 && path.checkpointDestSelected == pdTRUE )
+        if ( navigationState() == NAV_ACQUIRING && longitudeInDec != 0 && latitudeInDec != 0 )
         {
-            firstFix = 1; // run one time
-            soundState = pdTRUE; // navigation sound on
+            speechBlockedTicks = 0; // new walk
             
             /* Set Path Details */
             pathStart ( &path, latitudeInDec, longitudeInDec );
             
-            BaseType_t err = xTaskCreate( vTaskPath, "task path", TASK_PATH_STK_SIZE, (void*) 0, TASK_PATH_PRIO, &vTaskPathHandle );
-            if ( err != pdPASS ){
-                #if DEBUG_PRINT_MODE == 1
-                    sprintf( tempStr, "Failed to Create Task Path\n" );
-                    UART_PutString( tempStr );
-                #endif
-                while(1){};
-            }
-            err = xTaskCreate( vTaskDirection, "task direction", TASK_DIRECTION_STK_SIZE, (void*) 0, TASK_DIRECTION_PRIO, &vTaskDirectionHandle );
-            if ( err != pdPASS ){
-                #if DEBUG_PRINT_MODE == 1
-                    sprintf(tempStr, "Failed to Create Task Direction\n");
-                    UART_PutString( tempStr );
-                #endif
-                while(1){};
+            /* Dead reckon from this fix */
+            xSemaphoreTake( xCoordinatesMutex, portMAX_DELAY );
+            {
+                originLat = latitudeInDec;
+                originLon = longitudeInDec;
+                originCos = cos( originLat * M_PI / 180 );
+                now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+                kalmanReset();
+                kalmanUpdate( 0, 0, (uint16_t)( hdop * 10 ), now );
+                deadReckonRestart();
+                deadReckonFix( 0, 0, now );
             }
-            err = xTaskCreate( vTaskSound, "task sound", TASK_SOUND_STK_SIZE, (void*) 0, TASK_SOUND_PRIO, &vTaskSoundHandle );
-            if ( err != pdPASS ){
-                #if DEBUG_PRINT_MODE == 1
-                    sprintf(tempStr, "Failed to Create Task Sound\n");
-                    UART_PutString( tempStr );
-                #endif
-                while(1){};
-            }           
+            xSemaphoreGive( xCoordinatesMutex );
+            
+            navigationPost( NAV_FIX ); // start navigating
         }
         vTaskDelay(xDelay40ms);
     }
@@ -499,10 +1010,17 @@ static void vTaskPath( void *pvParameter )
 {
     (void) pvParameter;
     double diffDistance;
-    const TickType_t xDelay1000ms = pdMS_TO_TICKS(1000UL);
+    TickType_t wake;
 
     while (1)
     {
+        if ( navigationState() != NAV_NAVIGATING )
+        {
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY ); // sleep until the next walk
+            periodicRestart( &pathTiming, &wake );
+            continue;
+        }
+        
         if ( path.checkpointOperation == 0 )
         {
             nextCheckpoint = path.checkpointCurrent+1;
@@ -544,29 +1062,69 @@ static void vTaskPath( void *pvParameter )
             else { /* error in checkPointOperation value*/}
             if ( path.checkpointCurrent == path.checkpointDest ) //if atDestination is pdTRUE, this condition must be satisfied
             {
-                /* Vocalize arrived at destination */
-                xTaskNotify(vTaskSpeechHandle, (uint32_t)(1<<2)|(1<<1), (eNotifyAction)eSetValueWithOverwrite );
-
-                /* Restart Program */
+                /* End the walk, direction and sound tasks go back to sleep */
                 isr_button_ClearPending();
                 path.checkpointDestSelected = pdFALSE;      // no destination selected
                 path.atDestination = pdFALSE;               // not at destination - reset
-                firstFix = 0;                               // to create vTaskPathStart once again in vTaskGPS
-                soundState = pdFALSE;                       // sound navigation off
-                vTaskDelete(vTaskDirectionHandle);
-                vTaskDelete(vTaskSoundHandle);
-                vTaskDelete(NULL);                          // delete current task - and all others
+                navigationPost( NAV_ARRIVE );
                 OFF();                                      // OFF sound output
+                
+                /* Vocalize arrived at destination, the speech task then ends the session */
+                xTaskNotify(vTaskSpeechHandle, (uint32_t)(1<<2)|(1<<1), (eNotifyAction)eSetValueWithOverwrite );
+                continue;
             }
         }
-        #if DEBUG_PRINT_MODE == 1
-            sprintf( tempStr, "Current Checkpoint: H%d      Next Checkpoint:    H%d\n", 
-                checkpointName[path.checkpointCurrent], checkpointName[nextCheckpoint] );
-            UART_PutString( tempStr );
-            sprintf( tempStr, "Distance to next checkpoint: %.2f \n", diffDistance );
-            UART_PutString( tempStr);
-        #endif
-        vTaskDelay( xDelay1000ms );
+        TRACE( TRACE_PATH_CHECKPOINT, path.checkpointCurrent, nextCheckpoint );
+        TRACE( TRACE_PATH_DISTANCE, traceFloat(diffDistance) );
+        periodicWait( &pathTiming, &wake );
+    }
+}
+
+/*******************************************************************************
+*                                   MOTION TASK
+*******************************************************************************/
+static void vTaskMotion ( void *pvParameter )
+{
+    (void) pvParameter;
+    compassRaw accel;
+    uint32_t magnitude, now;
+    int32_t east, north;
+    deadReckonStats reckoning;
+    TickType_t wake;
+
+    while (1)
+    {
+        if ( navigationState() != NAV_NAVIGATING )
+        {
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY ); // sleep until the next walk
+            periodicRestart( &motionTiming, &wake );
+            continue;
+        }
+        
+        /* Accelerometer only, the direction task reads the heading */
+        xSemaphoreTake( xCompassMutex, portMAX_DELAY );
+        compassReadAccel(&accel);
+        xSemaphoreGive( xCompassMutex );
+        magnitude = (uint32_t)( sqrt( accel.a_x*accel.a_x + accel.a_y*accel.a_y
+            + accel.a_z*accel.a_z ) / ACCEL_COUNTS_PER_MG );
+        now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        
+        /* Step detection, then publish the dead reckoned position for path and
+           direction; while the pedometer has seen no step since the fix (a cane
+           or wheelchair, or the device off the body) the filter predicts it */
+        xSemaphoreTake( xCoordinatesMutex, portMAX_DELAY );
+        {
+            deadReckonSample( magnitude, now );
+            deadReckonGetStats( &reckoning );
+            if ( reckoning.stepsSinceFix == 0 ? kalmanPredict( now, &east, &north )
+                                              : deadReckonPosition( now, &east, &north ) )
+            {
+                positionFromLocal( east, north, &latitudeInDec, &longitudeInDec );
+            }
+        }
+        xSemaphoreGive( xCoordinatesMutex );
+        
+        periodicWait( &motionTiming, &wake );
     }
 }
 
@@ -577,16 +1135,19 @@ static void vTaskSpeech ( void *pvParameter )
 {
     (void) pvParameter;
     uint32_t speechNotificationValue;
+    TickType_t speechStart;
     while (1)
     {
         if ( xTaskNotifyWait((uint32_t)0, (uint32_t)0, &speechNotificationValue, portMAX_DELAY ) == pdTRUE )
         {
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "Notification received: %u", speechNotificationValue );
-                UART_PutString( tempStr );
+                debugPrint( tempStr );
             #endif
         }
 
+        speechStart = xTaskGetTickCount();
+        powerClaim( POWER_SPEECH );
         SPEECH(); // turn on speech (sound is offed automatically - turn on at end if needed)
                 
         //Prevent the RTOS kernel swapping out the task.
@@ -597,63 +1158,83 @@ static void vTaskSpeech ( void *pvParameter )
             case 1:
                 #if DEBUG_PRINT_MODE == 1
                     sprintf( tempStr, "     Campus centre\n" );
-                    UART_PutString( tempStr );
+                    debugPrint( tempStr );
                 #endif
                 sayCampusCentre();
                 break;
             case 2:
                 #if DEBUG_PRINT_MODE == 1
                     sprintf( tempStr, "     Campbell Hall\n" );
-                    UART_PutString( tempStr );
+                    debugPrint( tempStr );
                 #endif
                 sayCampbellHall();
                 break;
             case 3:
                 #if DEBUG_PRINT_MODE == 1
                     sprintf( tempStr, "     Hargrave Library\n" );
-                    UART_PutString( tempStr );
+                    debugPrint( tempStr );
                 #endif
                 sayHargraveLibrary();
                 break;
             case 4:
                 #if DEBUG_PRINT_MODE == 1
                     sprintf( tempStr, "     Battery Level: %d%%\n", batteryLevelValue );
-                    UART_PutString(tempStr);
+                    debugPrint(tempStr);
                 #endif
-                sayBatteryPercent(batteryLevelValue);
+                sayBatteryPercent(roundBatteryLevel(batteryLevelValue));
                 break;
             case 5:
                 #if DEBUG_PRINT_MODE == 1
                     sprintf( tempStr, "     No GPS Fix\n" );
-                    UART_PutString( tempStr );
+                    debugPrint( tempStr );
                 #endif
                 sayFix();
                 break;
             case 6:
                 #if DEBUG_PRINT_MODE == 1
                     sprintf( tempStr, "     Arrived at destination \n" );
-                    UART_PutString( tempStr );
+                    debugPrint( tempStr );
+                #endif
+                #if OBJ_DETECT_MODE == 1
+                    hapticPlay( HAPTIC_ALL_MOTORS, HAPTIC_DOUBLE_TAP, HAPTIC_PRIO_CUE, 255, 0 );
                 #endif
                 sayArrived();
             break;
             default:
                 #if DEBUG_PRINT_MODE == 1
                     sprintf( tempStr, "Error in notification value received \n" );
-                    UART_PutString( tempStr );
+                    debugPrint( tempStr );
                 #endif
                 break;
         }
         
-        if (soundState == pdTRUE) {SOUND();} // turn navigation sound back on if destination is selected and path task running
+        if ( navigationState() == NAV_NAVIGATING ) {SOUND();} // turn navigation sound back on while walking
         else {SPEECH();}
         
         // Restart the RTOS kernel.  We want to force a context switch, 
         //but there is no point if resuming the scheduler caused a context switch already.
+        powerRelease( POWER_SPEECH );
+        
         if( !xTaskResumeAll () )
         {
             taskYIELD ();
         }
+        speechBlockedTicks += xTaskGetTickCount() - speechStart;
         
+        /* First announcement after arrival ends the session (even if a newer
+           notification replaced the arrival one) */
+        navigationPost( NAV_ANNOUNCED );
+        
+        #if DEBUG_PRINT_MODE == 1
+            sprintf( tempStr, "Speech blocked this walk: %lu ms at %u%% rate\n",
+                (unsigned long)(speechBlockedTicks * portTICK_PERIOD_MS), getSpeechRate() );
+            debugPrint( tempStr );
+        #endif
+        
+        #if SYNTH_PROFILE_MODE == 1 && DEBUG_PRINT_MODE == 1
+            sprintf( tempStr, "Decoder throughput: %lu samples/s\n", (unsigned long)synth_samples_per_second() );
+            debugPrint( tempStr );
+        #endif
     }
 }
 
@@ -663,7 +1244,6 @@ static void vTaskSpeech ( void *pvParameter )
 static void vTaskDirection ( void *pvParameter )
 {
     (void) pvParameter;
-    char tempStr[100];
     compassRaw compass;
     float Xm_off, Ym_off, Zm_off, Xm_cal, Ym_cal, Zm_cal;
     const float alpha = 0.5;
@@ -671,12 +1251,30 @@ static void vTaskDirection ( void *pvParameter )
     float fYm = 0;
     float fZm = 0;
     double bearing, difference;
-    const TickType_t xDelay250ms = pdMS_TO_TICKS(250UL);
+    uint32_t magnitude, field;
+    int16_t heading;
+    TickType_t wake;
 
     while(1)
     {
+        if ( navigationState() != NAV_NAVIGATING )
+        {
+            rateStop( xTaskGetTickCount() * portTICK_PERIOD_MS );   // full rate between walks
+            rateApply();
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY ); // sleep until the next walk
+            xSemaphoreTake( xCoordinatesMutex, portMAX_DELAY );
+            headingRestart();   // new place, new field reference
+            xSemaphoreGive( xCoordinatesMutex );
+            rateStart( xTaskGetTickCount() * portTICK_PERIOD_MS );
+            rateApply();
+            periodicRestart( &directionTiming, &wake );
+            continue;
+        }
+        
         /* Compass Raw data readings */
+        xSemaphoreTake( xCompassMutex, portMAX_DELAY );
         compassRead(&compass);
+        xSemaphoreGive( xCompassMutex );
         
         /* Magnetometer calibration */
         Xm_off = compass.m_x*(100000.0/1100.0) + 3190.321761; //X-axis combined bias (Non calibrated data - bias)
@@ -696,11 +1294,31 @@ static void vTaskDirection ( void *pvParameter )
         bearing = atan2(fYm,fXm);
         if (bearing < 0) bearing += 2*M_PI;
         
-        #if DEBUG_PRINT_MODE == 1
-            sprintf(tempStr, "Bearings: %.2f", bearing*180/M_PI);
-            UART_PutString( tempStr );
+        /* Blend with the GPS course, the field magnitude flags disturbances */
+        field = (uint32_t)sqrt( fXm*fXm + fYm*fYm + fZm*fZm );
+        xSemaphoreTake( xCoordinatesMutex, portMAX_DELAY );
+        heading = headingCompass( (int16_t)( bearing*1800/M_PI ), field,
+            xTaskGetTickCount() * portTICK_PERIOD_MS );
+        xSemaphoreGive( xCoordinatesMutex );
+        bearing = heading*M_PI/1800;
+        
+        #if OBJ_DETECT_MODE == 1
+            /* Keep the obstacle map aligned as the user turns */
+            occupancySetHeading( (int16_t)(bearing*180/M_PI) );
         #endif
         
+        /* Steps go along the heading */
+        deadReckonHeading( (int16_t)(bearing*180/M_PI) );
+        
+        /* Scale the loop rates with motion and battery charge */
+        magnitude = (uint32_t)( sqrt( compass.a_x*compass.a_x + compass.a_y*compass.a_y
+            + compass.a_z*compass.a_z ) / ACCEL_COUNTS_PER_MG );
+        if ( rateUpdate( magnitude, (int16_t)(bearing*180/M_PI), (uint8_t)readBatteryLevel(),
+                         xTaskGetTickCount() * portTICK_PERIOD_MS ) )
+        {
+            rateApply();
+        }
+        
         xSemaphoreTake( xCoordinatesMutex, portMAX_DELAY );
         {
             /* Calculate angle between current and next checkpoint coordinates (degrees) */
@@ -708,10 +1326,7 @@ static void vTaskDirection ( void *pvParameter )
                 path.checkpointLat[nextCheckpoint], path.checkpointLon[nextCheckpoint]);
         }
         xSemaphoreGive( xCoordinatesMutex );
-        #if DEBUG_PRINT_MODE == 1
-            sprintf(tempStr, "      Difference: %.2f",difference );
-            UART_PutString( tempStr );
-         #endif
+        TRACE( TRACE_DIRECTION, traceFloat(bearing*180/M_PI), traceFloat(difference) );
         
         xSemaphoreTake( xDirectionMutex, portMAX_DELAY );
         {
@@ -721,8 +1336,7 @@ static void vTaskDirection ( void *pvParameter )
         }
         xSemaphoreGive( xDirectionMutex );
 
-        
-        vTaskDelay(xDelay250ms);
+        periodicWait( &directionTiming, &wake );
     }
 }
 
@@ -734,20 +1348,38 @@ static void vTaskSound ( void *pvParameter )
     (void) pvParameter;
     const int freqFront = 400;
     const int freqBack = 1000;
+    const int freqBlocked = 250;
     int freq = freqFront;
     float offsetAngle = 0;
     float ITDtime, phaseDelay;
     int phaseDelayCycles;
     int leftFast, rightFast;
     float IIDattenuation;
-    const TickType_t xDelay250ms = pdMS_TO_TICKS(250UL);
+    TickType_t wake;
+    BaseType_t soundClaimed = pdFALSE;
     
     sineWaveInitialize(400);
-
-    SOUND(); // sound always on as long as task path is running 
     
     while (1)
     {
+        if ( navigationState() != NAV_NAVIGATING )
+        {
+            if ( soundClaimed )
+            {
+                powerRelease( POWER_SOUND );            // walk over, sound blocks off
+                soundClaimed = pdFALSE;
+            }
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY ); // sleep until the next walk
+            if ( navigationState() == NAV_NAVIGATING )
+            {
+                powerClaim( POWER_SOUND );              // sound on for the whole walk
+                soundClaimed = pdTRUE;
+                SOUND();
+            }
+            periodicRestart( &soundTiming, &wake );
+            continue;
+        }
+        
         xSemaphoreTake( xDirectionMutex, portMAX_DELAY );
         {
             offsetAngle = direction;
@@ -757,10 +1389,7 @@ static void vTaskSound ( void *pvParameter )
         if (offsetAngle > M_PI) offsetAngle = offsetAngle - 2*M_PI; 
         if (offsetAngle < -M_PI) offsetAngle = offsetAngle + 2*M_PI;
         
-        #if DEBUG_PRINT_MODE == 1
-            sprintf(tempStr, "          offsetAngle: %.2f\n", offsetAngle*180/M_PI);    
-            UART_PutString(tempStr);
-        #endif
+        TRACE( TRACE_SOUND_OFFSET, traceFloat(offsetAngle*180/M_PI) );
         
         leftFast = offsetAngle < 0; //left is earlier then right
         rightFast = offsetAngle > 0; //right is earlier then left
@@ -769,6 +1398,16 @@ static void vTaskSound ( void *pvParameter )
         if (offsetAngle >= -M_PI/2 && offsetAngle <= M_PI/2 ) freq = freqFront;
         else freq = freqBack;
         
+        #if OBJ_DETECT_MODE == 1
+            // low tone when the obstacle map shows the way to the target blocked
+            if ( occupancyRange( (int16_t)(offsetAngle*180/M_PI) - SOUND_BLOCKED_ARC,
+                                 (int16_t)(offsetAngle*180/M_PI) + SOUND_BLOCKED_ARC,
+                                 xTaskGetTickCount() * portTICK_PERIOD_MS ) < SOUND_BLOCKED_CM )
+            {
+                freq = freqBlocked;
+            }
+        #endif
+        
         //calculate time delay
         ITDtime = 0.0002970892271*( offsetAngle + sin(offsetAngle));
         phaseDelay = 2 * M_PI * freq * ITDtime; // in radians
@@ -803,7 +1442,8 @@ static void vTaskSound ( void *pvParameter )
             // update frequency
             DDS24_1_SetFrequency((freq / 2.4965) * TABLE_LENGTH);   
         }
-        vTaskDelay(xDelay250ms);
+        periodicSetPeriod( &soundTiming, ratePeriod( RATE_SOUND ) );
+        periodicWait( &soundTiming, &wake );
     }
 }
 
@@ -817,20 +1457,19 @@ static void vTaskBatteryLevel ( void *pvParameter )
     
     while(1)
     {
-        if ( xTaskNotifyWait((uint32_t)0, (uint32_t)0, &batteryNotificationValue, portMAX_DELAY ) == pdTRUE )
+        /* Sample in the background, announce the cached level on request */
+        if ( xTaskNotifyWait((uint32_t)0, (uint32_t)0, &batteryNotificationValue, pdMS_TO_TICKS(BATTERY_SAMPLE_MS) ) == pdFALSE )
         {
-            #if DEBUG_PRINT_MODE == 1
-                sprintf( tempStr, "Battery Button Pressed" );
-                UART_PutString( tempStr );
-            #endif
+            batteryLevelSample();
+            continue;
         }
+        #if DEBUG_PRINT_MODE == 1
+            sprintf( tempStr, "Battery Button Pressed: %lu mV %d%%\n", (unsigned long)readBatteryVoltage(), readBatteryLevel() );
+            debugPrint( tempStr );
+        #endif
         if ( batteryNotificationValue == 1 )
         {
-            xSemaphoreTake( xBatteryLevelMutex, portMAX_DELAY );
-            {
-                batteryLevelValue = readBatteryLevel();
-            }
-            xSemaphoreGive( xBatteryLevelMutex );
+            batteryLevelValue = readBatteryLevel();
             xTaskNotify(vTaskSpeechHandle, (uint32_t)(1<<2), (eNotifyAction)eSetValueWithOverwrite );
         }
     }
@@ -851,9 +1490,9 @@ static void vTaskButton ( void *pvParameter )
         xStatus = xQueueReceive( xButtonTimeQueue, &buttonHoldTime, portMAX_DELAY );
         #if DEBUG_PRINT_MODE == 1
             sprintf(tempStr, "Hold time: %.2f\n", buttonHoldTime);
-            UART_PutString(tempStr);
+            debugPrint(tempStr);
         #endif
-        if ( path.checkpointDestSelected == pdFALSE && buttonHoldTime > 0 && buttonHoldTime <= 3 )
+        if ( buttonHoldTime > 0 && buttonHoldTime <= 3 && navigationPost( NAV_BROWSE ) == NAV_SELECTING )
         {
             buttonCount++;
             switch( buttonCount % 3 ) 
@@ -871,12 +1510,12 @@ static void vTaskButton ( void *pvParameter )
                 //error
                 #if DEBUG_PRINT_MODE == 1
                     sprintf(tempStr, "Error in button presses\n");
-                    UART_PutString(tempStr);
+                    debugPrint(tempStr);
                 #endif
                 break;
             }
         }
-        else if ( path.checkpointDestSelected == pdFALSE && buttonHoldTime > 3 && buttonHoldTime <= 6 )
+        else if ( navigationState() == NAV_SELECTING && buttonHoldTime > 3 && buttonHoldTime <= 6 )
         {
             switch( buttonCount % 3 ) 
             {
@@ -884,32 +1523,33 @@ static void vTaskButton ( void *pvParameter )
                 path.checkpointDestName = 'C';
                 #if DEBUG_PRINT_MODE == 1
                     sprintf(tempStr, "Campus Center Destination Selected\n");
-                    UART_PutString(tempStr);
+                    debugPrint(tempStr);
                 #endif
                 break;
                 case 1:
                 path.checkpointDestName = 'H';
                 #if DEBUG_PRINT_MODE == 1
                     sprintf(tempStr, "Campbell Hall Destination Selected\n");
-                    UART_PutString(tempStr);
+                    debugPrint(tempStr);
                 #endif
                 break;
                 case 2:
                 path.checkpointDestName = 'L';
                 #if DEBUG_PRINT_MODE == 1
                     sprintf(tempStr, "Hargrave Library Destination Selected\n");
-                    UART_PutString(tempStr);
+                    debugPrint(tempStr);
                 #endif
                 break;
                 default: 
                 //error
                 #if DEBUG_PRINT_MODE == 1
                     sprintf(tempStr, "Error in button hold (buttonCount = -1)\n");
-                    UART_PutString(tempStr);
+                    debugPrint(tempStr);
                 #endif
                 break;
             }
             path.checkpointDestSelected = pdTRUE;
+            navigationPost( NAV_SELECT ); // wait for a fix
         }
         else if ( buttonHoldTime > 6)
         {
@@ -930,11 +1570,7 @@ static void vTaskLED( void *pvParameter )
     int batteryLevel;
     while (1)
     {
-        xSemaphoreTake( xBatteryLevelMutex, portMAX_DELAY );
-        {
-            batteryLevel = readBatteryLevel();
-        }
-        xSemaphoreGive( xBatteryLevelMutex );
+        batteryLevel = readBatteryLevel();
         if (batteryLevel > 40)  xDelayIndicator = pdMS_TO_TICKS(10000UL);
         else xDelayIndicator = xDelay2500ms;
         Pin_LED_Write(1);
@@ -944,6 +1580,126 @@ static void vTaskLED( void *pvParameter )
     }
 }
 
+/*******************************************************************************
+*                                 CONSOLE TASK
+*******************************************************************************/
+#if CONSOLE_MODE == 1
+static void vTaskConsole( void *pvParameter )
+{
+    (void) pvParameter;
+    char command[CONSOLE_LINE_LENGTH];
+    
+    while (1)
+    {
+        /* Run commands at the lowest priority so profiling does not disturb the tasks it measures */
+        xQueueReceive( xConsoleQueue, command, portMAX_DELAY );
+        consoleProcessLine( command );
+    }
+}
+#endif
+
+/*******************************************************************************
+*                                  TRACE TASK
+*******************************************************************************/
+#if TRACE_MODE == 1
+static void vTaskTrace( void *pvParameter )
+{
+    (void) pvParameter;
+    TickType_t wake;
+    
+    periodicRestart( &traceTiming, &wake );
+    while (1)
+    {
+        /* Formatting is left to the host (tools/trace_decode.c) */
+        traceDrain();
+        periodicWait( &traceTiming, &wake );
+    }
+}
+#endif
+
+/*******************************************************************************
+*                                 DEBUG TX TASK
+*******************************************************************************/
+static void vTaskDebugTx( void *pvParameter )
+{
+    (void) pvParameter;
+    
+    /* Only task writing to the UART, sleeps while nothing is queued */
+    debugTxRun();
+}
+
+/*******************************************************************************
+*                              DEBUG TX BENCHMARK
+*******************************************************************************/
+#if CONSOLE_MODE == 1
+static BaseType_t txbenchCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+{
+    const TickType_t xDelayLine = pdMS_TO_TICKS(TXBENCH_LINE_MS);
+    debugTxStats before, after, now;
+    uint32_t sentences, lines = 0;
+    TickType_t start;
+    char line[64];
+    
+    (void) pcCommandString;
+    
+    debugTxGetStats( &before );
+    sentences = gpsSentences;
+    gpsLongestGap = 0;
+    
+    /* Queue far more than the UART can send while GPS keeps receiving */
+    start = xTaskGetTickCount();
+    while ( xTaskGetTickCount() - start < pdMS_TO_TICKS(TXBENCH_MS) )
+    {
+        snprintf( line, sizeof(line), "txbench %6lu ......................................\r\n", (unsigned long)lines++ );
+        debugPrint( line );
+        vTaskDelay( xDelayLine );
+    }
+    
+    debugTxGetStats( &after );
+    sentences = gpsSentences - sentences;
+    
+    /* Let the flood drain so the report is not dropped */
+    do
+    {
+        vTaskDelay( xDelayLine );
+        debugTxGetStats( &now );
+    } while ( now.queued - now.sent > DEBUG_TX_BUFFER / 2 );
+    
+    snprintf( pcWriteBuffer, xWriteBufferLen,
+        "TX queued %lu sent %lu dropped %lu peak %u B, GPS %lu sentences, longest gap %lu ms\r\n",
+        (unsigned long)(after.queued - before.queued), (unsigned long)(after.sent - before.sent),
+        (unsigned long)(after.dropped - before.dropped), (unsigned)after.highWater,
+        (unsigned long)sentences, (unsigned long)(gpsLongestGap * portTICK_PERIOD_MS) );
+    return pdFALSE;
+}
+
+/*******************************************************************************
+*                              SPEECH RATE
+*******************************************************************************/
+static BaseType_t rateCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+{
+    const char *pcParameter;
+    BaseType_t xParameterLength;
+    long rate;
+    
+    pcParameter = FreeRTOS_CLIGetParameter( pcCommandString, 1, &xParameterLength );
+    rate = strtol( pcParameter, NULL, 10 );
+    
+    if ( rate < SYNTH_RATE_MIN || rate > SYNTH_RATE_MAX )
+    {
+        snprintf( pcWriteBuffer, xWriteBufferLen, "Rate must be %u..%u%%, speech at %u%%\r\n",
+            SYNTH_RATE_MIN, SYNTH_RATE_MAX, getSpeechRate() );
+        return pdFALSE;
+    }
+    
+    /* Takes effect from the next utterance */
+    setSpeechRate( (uint8_t)rate );
+    snprintf( pcWriteBuffer, xWriteBufferLen, "Speech rate %u%%, speech blocked this walk %lu ms\r\n",
+        getSpeechRate(), (unsigned long)(speechBlockedTicks * portTICK_PERIOD_MS) );
+    return pdFALSE;
+}
+#endif
+
 /*******************************************************************************
 *                           DISTANCE AND MOTOR TASK
 *******************************************************************************/
@@ -951,27 +1707,26 @@ static void vTaskLED( void *pvParameter )
 void vTaskDistance(void *pvParameter)
 {
     (void) pvParameter;
+    ultrasonicSensor frame;
+    uint32_t frames = 0;
     
-    /* start components required for ultrasonic sensors. */
+    /* Wake on every completed ADC sequence, then start sampling. */
+    distanceNotifyOnSample( xTaskGetCurrentTaskHandle() );
     startUltrasonicSensors();
-    
-    const TickType_t xDelay1000ms = pdMS_TO_TICKS(1000UL);
 
     while(1)
     {
-        xSemaphoreTake( xObstacleDistanceMutex, portMAX_DELAY );
+        /* Block until the sequencer has new samples (every sonar schedule slot). */
+        ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        
+        /* Hand the newest filtered frame straight to the motor task. */
+        distanceReading( &frame );
+        xQueueOverwrite( xObstacleDistanceQueue, &frame );
+        
+        if ( ++frames % 10 == 0 )
         {
-            distanceReading( &ultrasonicReadings );
+            TRACE( TRACE_DISTANCE, frame.distance1, frame.distance2, frame.distance3 );
         }
-        xSemaphoreGive( xObstacleDistanceMutex );
-        
-        #if DEBUG_PRINT_MODE == 1
-            sprintf(tempStr, "Distance 1 : %lf cm         Distance 2 : %lf cm           Distance 3 : %lf cm\n",
-                ultrasonicReadings.distance1, ultrasonicReadings.distance2, ultrasonicReadings.distance3);
-            UART_PutString(tempStr);
-        #endif
-        /* Task should execute every 2000 milliseconds exactly. */
-        vTaskDelay( xDelay1000ms );
     }
 }
 
@@ -979,22 +1734,60 @@ void vTaskDistance(void *pvParameter)
 void vTaskMotor(void *pvParameter)
 {
     (void) pvParameter;
+    ultrasonicSensor frame;
+    obstacleTrack track;
+    TickType_t latency, latencyBin;
+    uint32_t frames = 0;
+    uint32_t timeMs;
+    uint8_t bin, sensor;
     
     /* start components required for motors. */
     startMotors();
-    
-    const TickType_t xDelay2093ms = pdMS_TO_TICKS(2093UL);
+    obstacleReset();
+    occupancyReset();
     
     while(1)
     {
-        xSemaphoreTake( xObstacleDistanceMutex, portMAX_DELAY );
+        /* Update the belt as soon as a new distance frame is available. */
+        xQueueReceive( xObstacleDistanceQueue, &frame, portMAX_DELAY );
+        
+        /* Fuse the frame into the heading fixed occupancy map. */
+        timeMs = frame.timestamp * portTICK_PERIOD_MS;
+        occupancyUpdate( 0, frame.distance1, timeMs );
+        occupancyUpdate( 1, frame.distance2, timeMs );
+        occupancyUpdate( 2, frame.distance3, timeMs );
+        
+        /* Track closing speed in each motor's arc, the belt follows urgency. */
+        for ( sensor = 0; sensor < OCC_CUE_ARCS; sensor++ )
         {
-            setMotors( (int)ultrasonicReadings.distance1, (int)ultrasonicReadings.distance2, (int)ultrasonicReadings.distance3);
+            obstacleUpdate( sensor, occupancyCueRange( sensor, timeMs ), timeMs );
         }
-        xSemaphoreGive( xObstacleDistanceMutex );
+        setMotors( obstacleUrgency(0), obstacleUrgency(1), obstacleUrgency(2) );
         
-        /* Task should execute every 2000 milliseconds exactly. */
-        vTaskDelay( xDelay2093ms );
+        /* Record sample to actuation latency */
+        latency = xTaskGetTickCount() - frame.timestamp;
+        latencyBin = latency / pdMS_TO_TICKS(LATENCY_BIN_MS);  // clamp before narrowing
+        if ( latencyBin >= LATENCY_BINS ) { latencyBin = LATENCY_BINS - 1; }
+        obstacleLatency[(uint8_t)latencyBin]++;
+        
+        if ( ++frames % LATENCY_PRINT_FRAMES == 0 )
+        {
+            for ( sensor = 0; sensor < OBSTACLE_SENSORS; sensor++ )
+            {
+                obstacleGet( sensor, &track );
+                TRACE( TRACE_OBSTACLE, sensor + 1, track.range, track.rate, track.ttc );
+            }
+            
+            #if DEBUG_PRINT_MODE == 1
+                debugPrint( "Obstacle latency (10 ms bins):" );
+                for ( bin = 0; bin < LATENCY_BINS; bin++ )
+                {
+                    sprintf( tempStr, " %lu", (unsigned long)obstacleLatency[bin] );
+                    debugPrint( tempStr );
+                }
+                debugPrint( "\n" );
+            #endif
+        }
     }
 }
 #endif
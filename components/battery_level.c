@@ -5,7 +5,8 @@
 * File:     battery_level.c
 * Version:  1.0.0
 *
-* Brief: Monitors the battery level.
+* Brief: Monitors the battery level: samples ADC_Battery in the background
+*        and keeps a cached fuel gauge level (fuel_gauge.h).
 *
 * Target device:
 *    CY8C5888LTI - LP097
@@ -26,79 +27,125 @@
 #include <stdio.h>
 #include <battery_level.h>
 #include <mode.h>
+#include "fuel_gauge.h"
+#include "power.h"
 
-/*******************************************************************************
-*   Private Function Declarations
-*******************************************************************************/
-static float readBatteryVoltage();
+#if OBJ_DETECT_MODE == 1
+    #include "haptic.h"
+#endif
 
 /*******************************************************************************
-*   Variable definitions
+*   Private Function Declarations
 *******************************************************************************/
-/* for debugging - uncomment when in need */
-static char temp[100];
+static uint32 readBatteryMillivolts();
+static uint32 batteryLoad();
 
 /*******************************************************************************
 * Function Name: batteryLevelMonitorStart
 ********************************************************************************
 * Summary:
-*  Start required components for battery level monitoring.
+*  Start required components for battery level monitoring and take the
+*  first sample, so the level is valid from boot.
 *******************************************************************************/
 void batteryLevelMonitorStart()
 {
     ADC_Battery_Start();
+    fuelGaugeReset();
+    batteryLevelSample();
 }
 
 /*******************************************************************************
-* Function Name: readBatteryVoltage
+* Function Name: batteryLevelSample
 ********************************************************************************
 * Summary:
-*   Reads battery voltage.
+*  Adds one averaged reading with the present load to the fuel gauge.
 *******************************************************************************/
-static float readBatteryVoltage()
+void batteryLevelSample()
 {
-    int16 adcResult = 0;
-    float volts = 0.00;
+    fuelGaugeUpdate( readBatteryMillivolts(), batteryLoad() );
+}
 
-    ADC_Battery_StartConvert();
+/*******************************************************************************
+* Function Name: readBatteryMillivolts
+********************************************************************************
+* Summary:
+*   Reads the battery voltage, the mean of BATTERY_OVERSAMPLE conversions.
+*******************************************************************************/
+static uint32 readBatteryMillivolts()
+{
+    int32 sum = 0;
+    uint8 i;
 
-    /* Wait for get ADC converted value */
-    if(ADC_Battery_IsEndConversion(ADC_Battery_WAIT_FOR_RESULT))
+    for ( i = 0; i < BATTERY_OVERSAMPLE; i++ )
     {
-        adcResult = ADC_Battery_GetResult16();
+        ADC_Battery_StartConvert();
+        ADC_Battery_IsEndConversion( ADC_Battery_WAIT_FOR_RESULT );
+        sum += ADC_Battery_GetResult16();
+    }
+
+    /* convert value to millivolts at the battery */
+    return (uint32)( ADC_Battery_CountsTo_Volts( (int16)( sum / BATTERY_OVERSAMPLE ) )
+        * 1000.0 / VOLTAGE_DIVIDER_RATIO );
+}
 
-        /* convert value to Volts */
-        volts = ADC_Battery_CountsTo_Volts(adcResult) / VOLTAGE_DIVIDER_RATIO;
+/*******************************************************************************
+* Function Name: batteryLoad
+********************************************************************************
+* Summary:
+*   Estimated battery current of the outputs running now (mA).
+*******************************************************************************/
+static uint32 batteryLoad()
+{
+    uint32 load = BATTERY_BASE_MA;
 
-        #if DEBUG_PRINT_MODE == 1
-            sprintf(temp, "Battery volts: %.2f\n", volts);
-            UART_PutString(temp);
-        #endif
+    if ( powerBlockOn( POWER_SOUND ) )
+    {
+        load += BATTERY_SOUND_MA;
     }
-    return volts;
+    if ( powerBlockOn( POWER_SPEECH ) )
+    {
+        load += BATTERY_SPEECH_MA;
+    }
+    #if OBJ_DETECT_MODE == 1
+        load += (uint32)hapticDrive() * BATTERY_MOTOR_MA / 100;
+    #endif
+    return load;
 }
 
 /*******************************************************************************
-* Function Name: batteryLevel
+* Function Name: readBatteryLevel
 ********************************************************************************
 * Summary
-*   Matched battery voltage to appropriate percentage level.
+*   Cached battery level from the fuel gauge, 0 - 100 %. Does not touch the
+*   ADC, so any task may call it at any time.
 *******************************************************************************/
 int readBatteryLevel()
 {
-    float volts = 0.0;
-    volts = readBatteryVoltage();
+    return fuelGaugeLevel();
+}
+
+/*******************************************************************************
+* Function Name: readBatteryVoltage
+********************************************************************************
+* Summary
+*   Cached filtered, load compensated battery voltage (mV).
+*******************************************************************************/
+uint32 readBatteryVoltage()
+{
+    return fuelGaugeMillivolts();
+}
 
-    if ( volts > 8.40 || volts <= 6.00 ) return 0; /* 0 indicates an error */
-    else if (volts < 8.40 && volts >= 8.16) return 90;
-    else if (volts < 8.16 && volts >= 7.92) return 80;
-    else if (volts < 7.92 && volts >= 7.68) return 70;
-    else if (volts < 7.68 && volts >= 7.44) return 60;
-    else if (volts < 7.44 && volts >= 7.20) return 50;
-    else if (volts < 7.20 && volts >= 6.96) return 50;
-    else if (volts < 6.96 && volts >= 6.72) return 40;
-    else if (volts < 6.72 && volts >= 6.48) return 30;
-    else if (volts < 6.48 && volts >= 6.24) return 20;
-    else return 10;
+/*******************************************************************************
+* Function Name: roundBatteryLevel
+********************************************************************************
+* Summary
+*   Rounds a level to the nearest ten the speech vocabulary has (10 - 90).
+*******************************************************************************/
+int roundBatteryLevel( int level )
+{
+    level = ( level + 5 ) / 10 * 10;
+    if ( level < 10 ) return 10;
+    if ( level > 90 ) return 90;
+    return level;
 }
 /* [] END OF FILE */
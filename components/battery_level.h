@@ -5,7 +5,8 @@
 * File:     battery_level.h
 * Version:  1.0.0
 *
-* Brief: Monitors the battery level.
+* Brief: Monitors the battery level: samples ADC_Battery in the background
+*        and keeps a cached fuel gauge level (fuel_gauge.h).
 *
 * Target device:
 *    CY8C5888LTI - LP097
@@ -18,6 +19,15 @@
 * Components:
 *    - ADC_SAR       [ADC_Battery]
 *    - cy_pins       [Battery_pin]
+*
+* Notes:
+*    vTaskBatteryLevel calls batteryLevelSample() every BATTERY_SAMPLE_MS.
+*    Each sample is BATTERY_OVERSAMPLE conversions, with the battery current
+*    estimated from the outputs on at the time: the audio blocks held by
+*    the power manager (power.h) and the vibration motors' drive. The
+*    BATTERY_*_MA currents are estimates, measure them on the board.
+*    readBatteryLevel() and readBatteryVoltage() return the cached result
+*    without a lock.
 *******************************************************************************/
 #ifndef BATTERY_LEVEL_H
 	#define BATTERY_LEVEL_H
@@ -32,6 +42,16 @@
 *******************************************************************************/
     #define VOLTAGE_DIVIDER_RATIO 0.5735
 
+    /* Conversions averaged per sample */
+    #define BATTERY_OVERSAMPLE    16
+
+    /* Estimated battery current (mA): board with GPS, compass and MCU,
+       sound amplifier and outputs, speech output, one motor at full duty */
+    #define BATTERY_BASE_MA       60
+    #define BATTERY_SOUND_MA      90
+    #define BATTERY_SPEECH_MA     60
+    #define BATTERY_MOTOR_MA      80
+
 /*******************************************************************************
 *   Function Declarations
 *******************************************************************************/
@@ -40,11 +60,26 @@
     // Return: none
     void batteryLevelMonitorStart();
 
-    // Brief: Converts battery voltage to a percentage level.
+    // Brief: Take one battery sample and update the fuel gauge.
     // Param: none.
-    // Return: battery percentage.
+    // Return: none
+    void batteryLevelSample();
+
+    // Brief: Cached battery level.
+    // Param: none.
+    // Return: battery percentage, 0 - 100.
     int readBatteryLevel();
 
+    // Brief: Cached filtered, load compensated battery voltage.
+    // Param: none.
+    // Return: millivolts.
+    uint32 readBatteryVoltage();
+
+    // Brief: Round a level for speech.
+    // Param: level Battery percentage.
+    // Return: nearest of 10, 20 .. 90.
+    int roundBatteryLevel( int level );
+
 #endif
 
 /* [] END OF FILE */
@@ -0,0 +1,519 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    console.c
+* Version: 1.0.0
+*
+* Brief: UART command console for profiling tasks, heap, queues and periodic
+*        task timing in the field, built on FreeRTOS+CLI.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*   UART
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <project.h>
+#include "stdio.h"
+#include "console.h"
+#include "debug_tx.h"
+#include "periodic.h"
+#include "power.h"
+#include "rate_policy.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "FreeRTOS_CLI.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* Run-time counts per RTOS tick */
+#define RUNTIME_PER_TICK    ( CONSOLE_RUNTIME_HZ / configTICK_RATE_HZ )
+
+/* SysTick counts per RTOS tick, the port's LOAD + 1 outside tickless idle */
+#define SYSTICK_PER_TICK    ( configCPU_CLOCK_HZ / configTICK_RATE_HZ )
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+/* A queue reported by the queues command */
+typedef struct consoleQueue{
+    QueueHandle_t handle;
+    const char   *name;
+} consoleQueue;
+
+/*******************************************************************************
+*   Variables
+*******************************************************************************/
+static consoleQueue watchedQueues[CONSOLE_MAX_QUEUES];
+static uint8 watchedQueueCount = 0;
+
+/* Task snapshot the tasks command prints one line at a time */
+static TaskStatus_t taskSnapshot[CONSOLE_MAX_TASKS];
+
+/* Last run-time counter value, keeps the counter monotonic */
+static uint32_t lastRunTime = 0;
+
+/* Output of one command call */
+static char outputBuffer[configCOMMAND_INT_MAX_OUTPUT_SIZE];
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+static BaseType_t tasksCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+static BaseType_t heapCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+static BaseType_t queuesCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+static BaseType_t timingCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+static BaseType_t energyCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+static BaseType_t ratesCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+
+/*******************************************************************************
+*   Command definitions
+*******************************************************************************/
+static const CLI_Command_Definition_t TASKS_COMMAND = {
+    "tasks",
+    "tasks: state, priority, CPU % and stack high-water mark (words) per task\r\n",
+    tasksCommand,
+    0
+};
+
+static const CLI_Command_Definition_t HEAP_COMMAND = {
+    "heap",
+    "heap: free heap now and minimum ever free (bytes)\r\n",
+    heapCommand,
+    0
+};
+
+static const CLI_Command_Definition_t QUEUES_COMMAND = {
+    "queues",
+    "queues: items waiting / length of each queue and semaphore\r\n",
+    queuesCommand,
+    0
+};
+
+static const CLI_Command_Definition_t TIMING_COMMAND = {
+    "timing",
+    "timing: jobs, deadline misses, release jitter and execution time histograms of periodic tasks\r\n",
+    timingCommand,
+    0
+};
+
+static const CLI_Command_Definition_t ENERGY_COMMAND = {
+    "energy",
+    "energy: estimated current and charge per navigation state and audio block, block wake latency\r\n",
+    energyCommand,
+    0
+};
+
+static const CLI_Command_Definition_t RATES_COMMAND = {
+    "rates",
+    "rates: motion, battery band, loop periods of the rate plan and estimated saving\r\n",
+    ratesCommand,
+    0
+};
+
+/*******************************************************************************
+* Function Name: consoleStart
+********************************************************************************
+* Summary:
+*   Register the console commands with FreeRTOS+CLI.
+*******************************************************************************/
+void consoleStart( void )
+{
+    FreeRTOS_CLIRegisterCommand( &TASKS_COMMAND );
+    FreeRTOS_CLIRegisterCommand( &HEAP_COMMAND );
+    FreeRTOS_CLIRegisterCommand( &QUEUES_COMMAND );
+    FreeRTOS_CLIRegisterCommand( &TIMING_COMMAND );
+    FreeRTOS_CLIRegisterCommand( &ENERGY_COMMAND );
+    FreeRTOS_CLIRegisterCommand( &RATES_COMMAND );
+}
+
+/*******************************************************************************
+* Function Name: consoleWatchQueue
+********************************************************************************
+* Summary:
+*   Add a queue, semaphore or mutex to the queues command and the queue
+*   registry (so debuggers show it by name too).
+*******************************************************************************/
+void consoleWatchQueue( QueueHandle_t queue, const char *name )
+{
+    if ( queue == NULL || watchedQueueCount >= CONSOLE_MAX_QUEUES )
+    {
+        return;
+    }
+    watchedQueues[watchedQueueCount].handle = queue;
+    watchedQueues[watchedQueueCount].name = name;
+    watchedQueueCount++;
+    vQueueAddToRegistry( queue, name );
+}
+
+/*******************************************************************************
+* Function Name: consoleProcessLine
+********************************************************************************
+* Summary:
+*   Run one command line. Commands with long output are called repeatedly,
+*   each call filling outputBuffer once, until they report they are done.
+*   Output goes out on the debug transmit path.
+*******************************************************************************/
+void consoleProcessLine( const char *line )
+{
+    BaseType_t more;
+
+    do
+    {
+        more = FreeRTOS_CLIProcessCommand( line, outputBuffer, sizeof(outputBuffer) );
+        
+        /* Wait for room rather than drop a line, the console runs at idle priority */
+        while ( !debugPrint( outputBuffer ) )
+        {
+            vTaskDelay( pdMS_TO_TICKS(10) );
+        }
+    } while ( more != pdFALSE );
+}
+
+/*******************************************************************************
+* Function Name: tasksCommand
+********************************************************************************
+* Summary:
+*   Prints one task per call. The first call takes a snapshot of every task
+*   so the lines printed belong to the same moment.
+*******************************************************************************/
+static BaseType_t tasksCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+{
+    static UBaseType_t taskCount = 0;
+    static UBaseType_t taskIndex = 0;
+    static uint32_t totalRunTime = 0;
+    static const char STATES[] = { 'X', 'R', 'B', 'S', 'D', '?' };
+    TaskStatus_t *task;
+    uint32_t percent;
+
+    (void) pcCommandString;
+
+    if ( taskIndex == 0 )
+    {
+        taskCount = uxTaskGetSystemState( taskSnapshot, CONSOLE_MAX_TASKS, &totalRunTime );
+        totalRunTime /= 100;
+        if ( totalRunTime == 0 )
+        {
+            totalRunTime = 1;
+        }
+        snprintf( pcWriteBuffer, xWriteBufferLen, "Task              State Prio   CPU%%  Stack\r\n" );
+        taskIndex = ( taskCount > 0 ) ? 1 : 0;
+        return ( taskCount > 0 ) ? pdTRUE : pdFALSE;
+    }
+
+    task = &taskSnapshot[taskIndex - 1];
+    percent = task->ulRunTimeCounter / totalRunTime;
+    snprintf( pcWriteBuffer, xWriteBufferLen, "%-16s  %c     %2u   %4lu%%  %5u\r\n",
+        task->pcTaskName, STATES[ (task->eCurrentState < 5) ? task->eCurrentState : 5 ],
+        (unsigned)task->uxCurrentPriority, (unsigned long)percent,
+        (unsigned)task->usStackHighWaterMark );
+
+    if ( taskIndex++ >= taskCount )
+    {
+        taskIndex = 0;
+        return pdFALSE;
+    }
+    return pdTRUE;
+}
+
+/*******************************************************************************
+* Function Name: heapCommand
+********************************************************************************
+* Summary:
+*   Prints heap free now and the lowest it has ever been.
+*******************************************************************************/
+static BaseType_t heapCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+{
+    (void) pcCommandString;
+
+    snprintf( pcWriteBuffer, xWriteBufferLen, "Heap free %u of %u bytes, minimum ever %u\r\n",
+        (unsigned)xPortGetFreeHeapSize(), (unsigned)configTOTAL_HEAP_SIZE,
+        (unsigned)xPortGetMinimumEverFreeHeapSize() );
+    return pdFALSE;
+}
+
+/*******************************************************************************
+* Function Name: queuesCommand
+********************************************************************************
+* Summary:
+*   Prints one watched queue per call.
+*******************************************************************************/
+static BaseType_t queuesCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+{
+    static uint8 queueIndex = 0;
+    UBaseType_t waiting, spaces;
+
+    (void) pcCommandString;
+
+    if ( watchedQueueCount == 0 )
+    {
+        snprintf( pcWriteBuffer, xWriteBufferLen, "No queues watched\r\n" );
+        return pdFALSE;
+    }
+
+    waiting = uxQueueMessagesWaiting( watchedQueues[queueIndex].handle );
+    spaces = uxQueueSpacesAvailable( watchedQueues[queueIndex].handle );
+    snprintf( pcWriteBuffer, xWriteBufferLen, "%-16s  %u / %u\r\n",
+        watchedQueues[queueIndex].name, (unsigned)waiting, (unsigned)(waiting + spaces) );
+
+    if ( ++queueIndex >= watchedQueueCount )
+    {
+        queueIndex = 0;
+        return pdFALSE;
+    }
+    return pdTRUE;
+}
+
+/*******************************************************************************
+* Function Name: timingCommand
+********************************************************************************
+* Summary:
+*   Prints the bin edges, then three lines per periodic task: totals, the
+*   jitter histogram and the execution time histogram.
+*******************************************************************************/
+static BaseType_t timingCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+{
+    static uint8 line = 0;
+    periodicTask *task;
+    const uint32_t *bins;
+    size_t used;
+    uint8 i;
+
+    (void) pcCommandString;
+
+    if ( periodicCount() == 0 )
+    {
+        snprintf( pcWriteBuffer, xWriteBufferLen, "No periodic tasks\r\n" );
+        return pdFALSE;
+    }
+
+    if ( line == 0 )
+    {
+        used = snprintf( pcWriteBuffer, xWriteBufferLen, "Bins (us): <%u", (unsigned)PERIODIC_BIN0_US );
+        for ( i = 1; i < PERIODIC_BINS - 1 && used < xWriteBufferLen; i++ )
+        {
+            used += snprintf( pcWriteBuffer + used, xWriteBufferLen - used, " <%lu",
+                (unsigned long)PERIODIC_BIN0_US << i );
+        }
+        if ( used < xWriteBufferLen )
+        {
+            snprintf( pcWriteBuffer + used, xWriteBufferLen - used, " more\r\n" );
+        }
+        line = 1;
+        return pdTRUE;
+    }
+
+    task = periodicGet( ( line - 1 ) / 3 );
+    switch ( ( line - 1 ) % 3 )
+    {
+        case 0:
+            snprintf( pcWriteBuffer, xWriteBufferLen,
+                "%-10s %4lu ms  jobs %lu  misses %lu  worst jitter %lu us  exec %lu us\r\n",
+                task->name, (unsigned long)(task->periodUs / 1000), (unsigned long)task->jobs,
+                (unsigned long)task->misses, (unsigned long)task->worstJitterUs,
+                (unsigned long)task->worstExecUs );
+            break;
+        default:
+            bins = ( ( line - 1 ) % 3 == 1 ) ? task->jitter : task->exec;
+            used = snprintf( pcWriteBuffer, xWriteBufferLen, "  %-7s", ( bins == task->jitter ) ? "jitter" : "exec" );
+            for ( i = 0; i < PERIODIC_BINS && used < xWriteBufferLen; i++ )
+            {
+                used += snprintf( pcWriteBuffer + used, xWriteBufferLen - used, " %lu", (unsigned long)bins[i] );
+            }
+            if ( used < xWriteBufferLen )
+            {
+                snprintf( pcWriteBuffer + used, xWriteBufferLen - used, "\r\n" );
+            }
+            break;
+    }
+
+    if ( ++line > periodicCount() * 3 )
+    {
+        line = 0;
+        return pdFALSE;
+    }
+    return pdTRUE;
+}
+
+/*******************************************************************************
+* Function Name: energyCommand
+********************************************************************************
+* Summary:
+*   Prints one line per navigation state: seconds in it, the share spent
+*   active, in WFI and tickless, estimated MCU current and charge. Then one
+*   line per audio block: share of time powered, estimated current and
+*   charge, power ups and the last and worst wake latency.
+*******************************************************************************/
+static BaseType_t energyCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+{
+    static const char *const NAMES[NAV_STATES] = {
+        "idle", "selecting", "acquiring", "navigating", "arrived"
+    };
+    static const char *const BLOCK_NAMES[POWER_BLOCKS] = { "sound", "speech" };
+    static const uint32 BLOCK_UA[POWER_BLOCKS] = { POWER_SOUND_UA, POWER_SPEECH_UA };
+    static uint8 line = 0;
+    powerStats stats;
+    powerBlockStats block;
+    uint64_t total;
+    uint8 mode;
+    uint32 share[POWER_MODES];
+
+    (void) pcCommandString;
+
+    if ( line < NAV_STATES )
+    {
+        powerGetStats( (navState)line, &stats );
+        total = stats.time[POWER_ACTIVE] + stats.time[POWER_WFI] + stats.time[POWER_TICKLESS];
+        for ( mode = 0; mode < POWER_MODES; mode++ )
+        {
+            share[mode] = ( total > 0 ) ? (uint32)( stats.time[mode] * 100 / total ) : 0;
+        }
+
+        snprintf( pcWriteBuffer, xWriteBufferLen,
+            "%-10s %6lu s  active %3lu%%  wfi %3lu%%  tickless %3lu%%  %5lu uA  %6lu uAh\r\n",
+            NAMES[line], (unsigned long)( total / CONSOLE_RUNTIME_HZ ),
+            (unsigned long)share[POWER_ACTIVE], (unsigned long)share[POWER_WFI],
+            (unsigned long)share[POWER_TICKLESS], (unsigned long)powerAverageUa( &stats ),
+            (unsigned long)powerChargeUah( &stats ) );
+    }
+    else
+    {
+        powerGetBlockStats( (powerBlock)( line - NAV_STATES ), &block );
+        total = ( block.totalTime > 0 ) ? block.totalTime : 1;
+
+        snprintf( pcWriteBuffer, xWriteBufferLen,
+            "%-10s on %3lu%%  %5lu uA  %6lu uAh  wakes %lu  wake %lu us, worst %lu us\r\n",
+            BLOCK_NAMES[line - NAV_STATES], (unsigned long)( block.onTime * 100 / total ),
+            (unsigned long)( block.onTime * BLOCK_UA[line - NAV_STATES] / total ),
+            (unsigned long)( block.onTime * BLOCK_UA[line - NAV_STATES] / ( (uint64_t)CONSOLE_RUNTIME_HZ * 3600 ) ),
+            (unsigned long)block.wakes, (unsigned long)block.lastWakeUs,
+            (unsigned long)block.worstWakeUs );
+    }
+
+    if ( ++line >= NAV_STATES + POWER_BLOCKS )
+    {
+        line = 0;
+        return pdFALSE;
+    }
+    return pdTRUE;
+}
+
+/*******************************************************************************
+* Function Name: ratesCommand
+********************************************************************************
+* Summary:
+*   Prints the motion and battery band, the period of each loop in the
+*   current plan and its estimated saving, then the time walking and
+*   stationary and the charge saved over all walks.
+*******************************************************************************/
+static BaseType_t ratesCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+{
+    static const char *const MOTIONS[RATE_MOTIONS] = { "stationary", "walking" };
+    static const char *const BANDS[RATE_BATTERY_BANDS] = { "ok", "low", "critical" };
+    static uint8 line = 0;
+    ratePlan plan;
+    rateStats stats;
+    uint32 total;
+
+    (void) pcCommandString;
+
+    if ( line == 0 )
+    {
+        snprintf( pcWriteBuffer, xWriteBufferLen, "motion %s  battery %s\r\n",
+            MOTIONS[rateMotionNow()], BANDS[rateBatteryNow()] );
+    }
+    else if ( line == 1 )
+    {
+        rateGetPlan( &plan );
+        snprintf( pcWriteBuffer, xWriteBufferLen,
+            "gps %lu ms  compass %lu ms  sonar %lu ms  sound %lu ms  saving %lu uA\r\n",
+            (unsigned long)plan.periodMs[RATE_GPS], (unsigned long)plan.periodMs[RATE_COMPASS],
+            (unsigned long)plan.periodMs[RATE_SONAR], (unsigned long)plan.periodMs[RATE_SOUND],
+            (unsigned long)rateSavedUa( &plan ) );
+    }
+    else
+    {
+        taskENTER_CRITICAL();
+        rateGetStats( &stats, xTaskGetTickCount() * portTICK_PERIOD_MS );
+        taskEXIT_CRITICAL();
+        total = stats.timeMs[RATE_STATIONARY] + stats.timeMs[RATE_WALKING];
+
+        snprintf( pcWriteBuffer, xWriteBufferLen,
+            "walking %lu s  stationary %lu s  changes %lu  saved %lu uAh, %lu uA mean\r\n",
+            (unsigned long)( stats.timeMs[RATE_WALKING] / 1000 ),
+            (unsigned long)( stats.timeMs[RATE_STATIONARY] / 1000 ),
+            (unsigned long)stats.changes,
+            (unsigned long)( stats.savedUaMs / 3600000UL ),
+            (unsigned long)( ( total > 0 ) ? stats.savedUaMs / total : 0 ) );
+    }
+
+    if ( ++line >= 3 )
+    {
+        line = 0;
+        return pdFALSE;
+    }
+    return pdTRUE;
+}
+
+/*******************************************************************************
+* Function Name: consoleRunTimeStart
+********************************************************************************
+* Summary:
+*   The run-time counter is derived from the RTOS tick count and the SysTick
+*   down counter, which the port starts with the scheduler, so there is no
+*   extra timer to start.
+*******************************************************************************/
+void consoleRunTimeStart( void )
+{
+    lastRunTime = 0;
+}
+
+/*******************************************************************************
+* Function Name: consoleRunTime
+********************************************************************************
+* Summary:
+*   Run-time counter: whole ticks plus the SysTick counts since the last
+*   counted tick. In tickless idle the port reloads SysTick with the part of
+*   the tick it started in plus whole ticks, and counts no ticks until it
+*   wakes, so interrupts that wake it see a long LOAD: the part of a tick
+*   the reload started with (LOAD modulo a tick) and the whole ticks both
+*   count. A tick that has expired but not been counted yet would read as a
+*   step back, so the value is held instead. Runs with
+*   interrupts masked so concurrent callers cannot interleave the update of
+*   lastRunTime.
+*******************************************************************************/
+uint32_t consoleRunTime( void )
+{
+    UBaseType_t savedInterruptStatus;
+    uint32_t load, elapsed, now;
+
+    /* Called from tasks and the context switch, lastRunTime is shared */
+    savedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        load = SysTick->LOAD;
+        elapsed = load - SysTick->VAL + ( SYSTICK_PER_TICK - 1 - load % SYSTICK_PER_TICK );
+
+        now = xTaskGetTickCountFromISR() * RUNTIME_PER_TICK + elapsed * RUNTIME_PER_TICK / SYSTICK_PER_TICK;
+        if ( (int32_t)( now - lastRunTime ) < 0 )
+        {
+            now = lastRunTime;
+        }
+        lastRunTime = now;
+    }
+    taskEXIT_CRITICAL_FROM_ISR( savedInterruptStatus );
+
+    return now;
+}
+
+/* [] END OF FILE */
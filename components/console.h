@@ -0,0 +1,104 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    console.h
+* Version: 1.0.0
+*
+* Brief: UART command console for profiling tasks, heap, queues and periodic
+*        task timing in the field, built on FreeRTOS+CLI.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*   UART
+*
+* Notes:
+*   Commands (type "help" for the list):
+*     tasks  - per task state, priority, CPU % since start and stack
+*              high-water mark (words never used, size stacks from this).
+*     heap   - heap free now and minimum ever free (heap_4).
+*     queues - items waiting / length of every watched queue and semaphore
+*              (a mutex shows 1 when free, 0 when held).
+*     timing - jobs, deadline misses, worst release jitter and execution
+*              time of each periodic task (periodic.h), then its jitter
+*              and execution time histograms.
+*     energy - per navigation state: time in it, share active, in WFI and
+*              tickless, estimated MCU current and charge; per audio block:
+*              share powered, estimated current and charge, power ups and
+*              wake latency (power.h).
+*     rates  - motion and battery band, loop periods of the current rate
+*              plan and its estimated saving, time walking and stationary
+*              and charge saved over all walks (rate_policy.h).
+*   main.c adds txbench (debug TX flood test) and rate <50..200> (speech
+*   playback rate in percent, with the time speech blocked this walk).
+*   CPU time is measured with the run-time counter (consoleRunTime(), wired
+*   to portGET_RUN_TIME_COUNTER_VALUE in FreeRTOSConfig.h), which counts
+*   CONSOLE_RUNTIME_HZ from the SysTick timer and wraps after about 11 hours.
+*
+*   The UART RX line is shared with the GPS, so a command is sent framed as
+*   the proprietary sentence CONSOLE_SENTENCE, e.g. "$PSMAP,tasks", which
+*   GPS receivers never send; vTaskGPS hands the command after the comma to
+*   consoleProcessLine() and drops any other line not starting with '$'
+*   (noise and partial sentences).
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <project.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+// Run-time counter rate (Hz), a multiple of configTICK_RATE_HZ.
+#define CONSOLE_RUNTIME_HZ      100000
+
+// Longest command line.
+#define CONSOLE_LINE_LENGTH     32
+
+// Start of a command line on the shared UART RX.
+#define CONSOLE_SENTENCE        "$PSMAP,"
+
+// Most queues and semaphores the queues command reports.
+#define CONSOLE_MAX_QUEUES      10
+
+// Most tasks the tasks command reports.
+#define CONSOLE_MAX_TASKS       16
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Register the console commands.
+// Param: none.
+// Return: none.
+void consoleStart( void );
+
+// Brief: Add a queue, semaphore or mutex to the queues command.
+// Param: queue Handle, name Name to report (kept, must be static).
+// Return: none.
+void consoleWatchQueue( QueueHandle_t queue, const char *name );
+
+// Brief: Run one command line and print its output on the UART.
+// Param: line Command line, without line ending.
+// Return: none.
+void consoleProcessLine( const char *line );
+
+// Brief: Start the run-time counter (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS).
+// Param: none.
+// Return: none.
+void consoleRunTimeStart( void );
+
+// Brief: Run-time counter value (portGET_RUN_TIME_COUNTER_VALUE).
+// Param: none.
+// Return: counts of 1 / CONSOLE_RUNTIME_HZ seconds since start.
+uint32_t consoleRunTime( void );
+
+/* [] END OF FILE */
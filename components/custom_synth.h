@@ -32,6 +32,10 @@
 * Notes:
 *   Optimized LPC codes stored in the ROM of Speech Synthesisers can be found here
 * https://github.com/going-digital/Talkie/tree/master/Talkie/examples
+*   The decoder interpolates between frames, so words can be encoded with a
+* longer frame period (python_wizard frame rate option) to save flash. All
+* words must use the same period, and LPC_FRAME_MS in lpc_decoder.h must be
+* set to match.
 *
 *******************************************************************************/
 #ifndef CUSTOM_SYNTH_H
@@ -41,11 +45,52 @@
 *   Included Headers
 *******************************************************************************/
 #include "project.h"
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+// Playback rate in percent used until setSpeechRate() is called.
+#define SPEECH_RATE_DEFAULT     100
+
+/*******************************************************************************
+*   Enumerations
+*******************************************************************************/
+// Utterance ids, in speech store index order (see speech_store.h).
+typedef enum speechId{
+    SPEECH_WELCOME = 0,
+    SPEECH_PAUSE,
+    SPEECH_HARGRAVE,
+    SPEECH_CAMPBELL,
+    SPEECH_CENTRE,
+    SPEECH_ARRIVED,
+    SPEECH_FIX,
+    SPEECH_TEN,
+    SPEECH_TWENTY,
+    SPEECH_THIRTY,
+    SPEECH_FOURTY,
+    SPEECH_FIFTY,
+    SPEECH_SIXTY,
+    SPEECH_SEVENTY,
+    SPEECH_EIGHTY,
+    SPEECH_NINETY,
+    SPEECH_PERCENT,
+    SPEECH_ID_COUNT
+} speechId;
     
 /*******************************************************************************
 *   Function Declarations
 *******************************************************************************/
 
+// Brief: Set the playback rate of all following utterances.
+// Param:  rate Playback rate in percent (100 = natural speed).
+// Return: none
+void setSpeechRate(uint8_t rate);
+
+// Brief: Get the playback rate of utterances.
+// Param:  none.
+// Return: uint8_t Playback rate in percent.
+uint8_t getSpeechRate(void);
+
 // Brief: Vocalize given number parameter.
 // Param:  number Number to vocalize.
 // Return: none 
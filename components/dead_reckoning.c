@@ -0,0 +1,532 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     dead_reckoning.c
+* Version:  1.0.0
+*
+* Brief: Pedestrian dead reckoning: a pedometer and step length estimator on
+*        the accelerometer, steps projected along the compass heading
+*        between GPS fixes.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Source:
+*    Step length from H. Weinberg, "Using the ADXL202 in Pedometer and
+*    Personal Navigation Applications", Analog Devices AN-602
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "dead_reckoning.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* sin of 0 .. 90 degrees, Q14 */
+static const uint16_t SIN_Q14[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
+
+/* mg to m/s^2 in Q16: 9.807 * 65536 / 1000 */
+#define MG_TO_MS2_Q16       643
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+/* Pedometer */
+static uint32_t g_gravity = 0;          // magnitude average, mg << DEAD_RECKON_GRAVITY_SHIFT
+static int32_t  g_smooth = 0;           // smoothed deviation from gravity (mg)
+static int32_t  g_peak = 0;             // highest smoothed deviation since the last step
+static int32_t  g_valley = 0;           // lowest smoothed deviation since the last step
+static uint8_t  gb_armed = 0;           // fell below gravity since the last step
+static uint32_t g_last_step = 0;        // time of the last step
+
+/* Position, mm from the origin, at the last step or fix */
+static int32_t  g_east = 0;
+static int32_t  g_north = 0;
+static uint8_t  gb_fixed = 0;           // a fix has arrived
+static uint32_t g_fix_time = 0;
+static int16_t  g_heading = 0;
+
+/* Calibration: anchor fix, and since it the step roots and their vector
+   sum, in fourth root units << 12 */
+static uint8_t  gb_anchored = 0;
+static int32_t  g_anchor_east = 0;
+static int32_t  g_anchor_north = 0;
+static uint32_t g_root_sum = 0;
+static int32_t  g_root_east = 0;
+static int32_t  g_root_north = 0;
+static uint32_t g_anchor_steps = 0;
+
+/* Counters, kMm is the step constant in use */
+static deadReckonStats g_stats = { 0, 0, 0, 0, DEAD_RECKON_STEP_K_MM, 0, 0, 0 };
+
+/*******************************************************************************
+*   Private Function Declarations
+*******************************************************************************/
+// Brief: sin of a heading.
+// Param: deg Degrees, any value.
+// Return: int32_t sin, Q14.
+static int32_t sinQ14(int32_t deg);
+
+// Brief: Integer square root.
+// Param: x Value.
+// Return: uint32_t floor(sqrt(x)).
+static uint32_t isqrt(uint64_t x);
+
+// Brief: Distance between two points.
+// Param: east_mm, north_mm Difference.
+// Return: uint32_t Distance (mm).
+static uint32_t distanceMm(int32_t east_mm, int32_t north_mm);
+
+// Brief: Calibrate K against a fix.
+// Param: east_mm, north_mm Fix.
+// Return: none
+static void calibrate(int32_t east_mm, int32_t north_mm);
+
+/*******************************************************************************
+* Function Name: deadReckonReset
+********************************************************************************
+* Summary:
+*    Back to the state at power up.
+*******************************************************************************/
+void deadReckonReset(void)
+{
+    deadReckonRestart();
+    g_stats.steps        = 0;
+    g_stats.kMm          = DEAD_RECKON_STEP_K_MM;
+    g_stats.calibrations = 0;
+    g_stats.worstFixErrorMm = 0;
+}
+
+/*******************************************************************************
+* Function Name: deadReckonRestart
+********************************************************************************
+* Summary:
+*    A new walk: no fix, no anchor, the pedometer waits for gravity again.
+*    K is the user's, so it is kept.
+*******************************************************************************/
+void deadReckonRestart(void)
+{
+    g_gravity   = 0;
+    g_smooth    = 0;
+    g_peak      = 0;
+    g_valley    = 0;
+    gb_armed    = 0;
+    g_east      = 0;
+    g_north     = 0;
+    gb_fixed    = 0;
+    gb_anchored = 0;
+
+    g_stats.stepsSinceFix = 0;
+    g_stats.stepMm        = 0;
+    g_stats.stepMs        = 0;
+    g_stats.fixErrorMm    = 0;
+}
+
+/*******************************************************************************
+* Function Name: deadReckonFix
+********************************************************************************
+* Summary:
+*    Records how far the position had drifted from the fix, calibrates K and
+*    moves the position to the fix. The prediction restarts from the fix.
+*******************************************************************************/
+void deadReckonFix(int32_t east_mm, int32_t north_mm, uint32_t now_ms)
+{
+    int32_t east;
+    int32_t north;
+
+    if (gb_fixed)
+    {
+        deadReckonPosition(now_ms, &east, &north);
+        g_stats.fixErrorMm = distanceMm(east - east_mm, north - north_mm);
+        if (g_stats.fixErrorMm > g_stats.worstFixErrorMm)
+        {
+            g_stats.worstFixErrorMm = g_stats.fixErrorMm;
+        }
+    }
+
+    calibrate(east_mm, north_mm);
+
+    g_east     = east_mm;
+    g_north    = north_mm;
+    g_fix_time = now_ms;
+    gb_fixed   = 1;
+    g_stats.stepsSinceFix = 0;
+}
+
+/*******************************************************************************
+* Function Name: deadReckonHeading
+********************************************************************************
+* Summary:
+*    Sets the heading, a single half word write.
+*******************************************************************************/
+void deadReckonHeading(int16_t heading_deg)
+{
+    g_heading = heading_deg;
+}
+
+/*******************************************************************************
+* Function Name: deadReckonSample
+********************************************************************************
+* Summary:
+*    Smooths the deviation from gravity (1/2 weight) and tracks its peak and
+*    valley. On a step the swing sets the step length, K * swing^(1/4) with
+*    the swing in m/s^2 (the fourth root as two square roots of Q16), and
+*    the position moves along the heading.
+*******************************************************************************/
+uint8_t deadReckonSample(uint32_t magnitude_mg, uint32_t now_ms)
+{
+    int32_t  gravity;
+    int32_t  swing;
+    uint32_t root;
+    uint32_t length;
+    int32_t  sine;
+    int32_t  cosine;
+
+    if (0 == g_gravity)
+    {
+        g_gravity = magnitude_mg << DEAD_RECKON_GRAVITY_SHIFT;
+    }
+    gravity = (int32_t)(g_gravity >> DEAD_RECKON_GRAVITY_SHIFT);
+    g_gravity += magnitude_mg - (uint32_t)gravity;
+
+    g_smooth += ((int32_t)magnitude_mg - gravity - g_smooth) / 2;
+    if (g_smooth > g_peak)
+    {
+        g_peak = g_smooth;
+    }
+    if (g_smooth < g_valley)
+    {
+        g_valley = g_smooth;
+    }
+
+    if (!gb_armed)
+    {
+        gb_armed = (g_smooth < 0);
+        return 0;
+    }
+    if (g_smooth < DEAD_RECKON_STEP_MG ||
+        (g_stats.steps > 0 && now_ms - g_last_step < DEAD_RECKON_STEP_MIN_MS))
+    {
+        return 0;
+    }
+
+    /* A step */
+    swing = g_peak - g_valley;
+    root = isqrt(isqrt((uint64_t)swing * MG_TO_MS2_Q16));     // Q4
+    length = g_stats.kMm * root / 16;
+    if (length < DEAD_RECKON_STEP_MIN_MM)   length = DEAD_RECKON_STEP_MIN_MM;
+    if (length > DEAD_RECKON_STEP_MAX_MM)   length = DEAD_RECKON_STEP_MAX_MM;
+
+    sine   = sinQ14(g_heading);
+    cosine = sinQ14(g_heading + 90);
+    g_east  += (int32_t)length * sine / 16384;
+    g_north += (int32_t)length * cosine / 16384;
+
+    g_root_sum   += root << 8;
+    g_root_east  += (int32_t)root * sine / 64;
+    g_root_north += (int32_t)root * cosine / 64;
+    g_anchor_steps++;
+
+    g_stats.stepMs = (g_stats.steps > 0 && now_ms - g_last_step <= DEAD_RECKON_STEP_MAX_MS)
+                   ? now_ms - g_last_step : 0;
+    g_stats.stepMm = length;
+    g_stats.steps++;
+    g_stats.stepsSinceFix++;
+
+    g_last_step = now_ms;
+    gb_armed = 0;
+    g_peak   = g_smooth;
+    g_valley = g_smooth;
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: deadReckonPosition
+********************************************************************************
+* Summary:
+*    Position at the last step or fix, plus the part of a step walked since
+*    at the last step's pace, at most one step. Nothing is added before the
+*    pace is known or once the user has stopped.
+*******************************************************************************/
+uint8_t deadReckonPosition(uint32_t now_ms, int32_t *p_east_mm, int32_t *p_north_mm)
+{
+    uint32_t since = (now_ms - g_last_step < now_ms - g_fix_time) ? g_last_step : g_fix_time;
+    uint32_t elapsed = now_ms - since;
+    int32_t  ahead = 0;
+
+    if (g_stats.stepMs > 0 && now_ms - g_last_step <= DEAD_RECKON_STEP_MAX_MS)
+    {
+        ahead = (int32_t)((elapsed < g_stats.stepMs) ? g_stats.stepMm * elapsed / g_stats.stepMs
+                                                     : g_stats.stepMm);
+    }
+
+    *p_east_mm  = g_east  + ahead * sinQ14(g_heading) / 16384;
+    *p_north_mm = g_north + ahead * sinQ14(g_heading + 90) / 16384;
+    return gb_fixed;
+}
+
+/*******************************************************************************
+* Function Name: deadReckonGetStats
+********************************************************************************
+* Summary:
+*    Copies the counters.
+*******************************************************************************/
+void deadReckonGetStats(deadReckonStats *p_stats)
+{
+    *p_stats = g_stats;
+}
+
+/*******************************************************************************
+* Function Name: calibrate
+********************************************************************************
+* Summary:
+*    Once the fix is DEAD_RECKON_CALIBRATE_MM from the anchor: if the step
+*    vectors since add up to at least 90 % of their lengths (a straight
+*    walk, where the GPS distance is the distance walked), K measured is
+*    GPS distance / sum of step roots, and K moves a quarter of the way to
+*    it. The fix becomes the anchor either way. A walk that never gets far
+*    enough from the anchor (in circles) re-anchors after DEAD_RECKON_
+*    CALIBRATE_STEPS steps.
+*******************************************************************************/
+static void calibrate(int32_t east_mm, int32_t north_mm)
+{
+    uint32_t gps;
+    uint32_t vector;
+    uint32_t measured;
+
+    if (gb_anchored)
+    {
+        gps = distanceMm(east_mm - g_anchor_east, north_mm - g_anchor_north);
+        if (gps < DEAD_RECKON_CALIBRATE_MM && g_anchor_steps < DEAD_RECKON_CALIBRATE_STEPS)
+        {
+            return;
+        }
+
+        vector = distanceMm(g_root_east, g_root_north);
+        if (gps >= DEAD_RECKON_CALIBRATE_MM && vector > 0 &&
+            (uint64_t)vector * 10 >= (uint64_t)g_root_sum * 9)
+        {
+            measured = (uint32_t)((uint64_t)gps * 4096 / vector);
+            if (measured * 100 >= g_stats.kMm * (100 - DEAD_RECKON_CALIBRATE_PCT) &&
+                measured * 100 <= g_stats.kMm * (100 + DEAD_RECKON_CALIBRATE_PCT))
+            {
+                g_stats.kMm = (uint32_t)((int32_t)g_stats.kMm
+                            + ((int32_t)measured - (int32_t)g_stats.kMm) / 4);
+                g_stats.calibrations++;
+            }
+        }
+    }
+
+    gb_anchored    = 1;
+    g_anchor_east  = east_mm;
+    g_anchor_north = north_mm;
+    g_root_sum     = 0;
+    g_root_east    = 0;
+    g_root_north   = 0;
+    g_anchor_steps = 0;
+}
+
+/*******************************************************************************
+* Function Name: sinQ14
+********************************************************************************
+* Summary:
+*    Folds the angle into 0 .. 90 degrees of the table.
+*******************************************************************************/
+static int32_t sinQ14(int32_t deg)
+{
+    deg %= 360;
+    if (deg < 0)
+    {
+        deg += 360;
+    }
+
+    if (deg <= 90)   return SIN_Q14[deg];
+    if (deg <= 180)  return SIN_Q14[180 - deg];
+    if (deg <= 270)  return -(int32_t)SIN_Q14[deg - 180];
+    return -(int32_t)SIN_Q14[360 - deg];
+}
+
+/*******************************************************************************
+* Function Name: isqrt
+********************************************************************************
+* Summary:
+*    Bit by bit square root.
+*******************************************************************************/
+static uint32_t isqrt(uint64_t x)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > x)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (x >= root + bit)
+        {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+/*******************************************************************************
+* Function Name: distanceMm
+********************************************************************************
+* Summary:
+*    Length of a vector.
+*******************************************************************************/
+static uint32_t distanceMm(int32_t east_mm, int32_t north_mm)
+{
+    return isqrt((uint64_t)((int64_t)east_mm * east_mm) + (uint64_t)((int64_t)north_mm * north_mm));
+}
+
+#if DEAD_RECKON_HOST == 1
+/*******************************************************************************
+* Function Name: deadReckonSimulate
+********************************************************************************
+* Summary:
+*    The user walks a 35 m square, 50 s per side then a 10 s stop to turn.
+*    Strides last 480 .. 560 ms and are 600 .. 800 mm long; each adds a
+*    triangle wave to 1 g whose swing is the Weinberg swing of its length
+*    with K = 420 mm, plus +-40 mg of noise. Heading has +-5 degrees of
+*    noise, GPS fixes +-3 m per axis. Noise is from a linear congruential
+*    generator. The error is the distance between the true position and the
+*    dead reckoned one, or the last fix, every 50 ms sample.
+*******************************************************************************/
+void deadReckonSimulate(uint32_t duration_ms, uint32_t fix_ms,
+    deadReckonSimResult *p_result)
+{
+    const uint32_t side_ms = 60000u;
+    const uint32_t walk_ms = 50000u;
+    const uint32_t true_k  = 420u;
+    uint32_t seed = 1;
+    uint32_t now;
+    uint32_t stride_start = 0;
+    uint32_t stride_ms = 500;
+    uint32_t stride_mm = 700;
+    uint32_t swing = 0;
+    uint32_t step;
+    int32_t  heading = 0;
+    int32_t  true_east = 0;
+    int32_t  true_north = 0;
+    int32_t  fix_east = 0;
+    int32_t  fix_north = 0;
+    int32_t  east;
+    int32_t  north;
+    int32_t  wave;
+    uint32_t last_fix = 0;
+    uint32_t last_now = 0;
+    uint32_t error;
+    uint64_t error_sum = 0;
+    uint64_t hold_sum = 0;
+    uint32_t samples = 0;
+    uint8_t  walking;
+    deadReckonStats stats;
+
+    p_result->strides          = 0;
+    p_result->worstErrorMm     = 0;
+    p_result->holdWorstErrorMm = 0;
+
+    deadReckonReset();
+    deadReckonFix(0, 0, 0);
+
+    for (now = 0; now < duration_ms; now += 50u)
+    {
+        walking = (now % side_ms) < walk_ms;
+        heading = (int32_t)(now / side_ms) * 90;
+
+        /* True motion since the last sample */
+        wave = 0;
+        if (walking)
+        {
+            while (now - stride_start >= stride_ms)
+            {
+                stride_start += stride_ms;
+                seed = seed * 1103515245u + 12345u;
+                stride_ms = 480u + (seed >> 16) % 81u;
+                seed = seed * 1103515245u + 12345u;
+                stride_mm = 600u + (seed >> 16) % 201u;
+                p_result->strides++;
+            }
+            /* Swing (mg) whose fourth root gives this stride with true_k */
+            swing = (uint32_t)((uint64_t)stride_mm * stride_mm * stride_mm * stride_mm * 65536u
+                  / ((uint64_t)true_k * true_k * true_k * true_k) / MG_TO_MS2_Q16);
+            step = (now - stride_start) * 1000u / stride_ms;
+            wave = (step < 500u) ? (int32_t)(swing * step / 500u) - (int32_t)swing / 2
+                                 : (int32_t)swing / 2 - (int32_t)(swing * (step - 500u) / 500u);
+
+            true_east  += (int32_t)(stride_mm * (now - last_now) / stride_ms) * sinQ14(heading) / 16384;
+            true_north += (int32_t)(stride_mm * (now - last_now) / stride_ms) * sinQ14(heading + 90) / 16384;
+        }
+        else
+        {
+            stride_start = now;
+        }
+        last_now = now;
+
+        seed = seed * 1103515245u + 12345u;
+        deadReckonHeading((int16_t)(heading + (int32_t)((seed >> 16) % 11u) - 5));
+        seed = seed * 1103515245u + 12345u;
+        deadReckonSample((uint32_t)(1000 + wave + (int32_t)((seed >> 16) % 81u) - 40), now);
+
+        if (now - last_fix >= fix_ms)
+        {
+            seed = seed * 1103515245u + 12345u;
+            fix_east = true_east + (int32_t)((seed >> 16) % 6001u) - 3000;
+            seed = seed * 1103515245u + 12345u;
+            fix_north = true_north + (int32_t)((seed >> 16) % 6001u) - 3000;
+            deadReckonFix(fix_east, fix_north, now);
+            last_fix = now;
+        }
+
+        deadReckonPosition(now, &east, &north);
+        error = distanceMm(east - true_east, north - true_north);
+        error_sum += error;
+        if (error > p_result->worstErrorMm)
+        {
+            p_result->worstErrorMm = error;
+        }
+        error = distanceMm(fix_east - true_east, fix_north - true_north);
+        hold_sum += error;
+        if (error > p_result->holdWorstErrorMm)
+        {
+            p_result->holdWorstErrorMm = error;
+        }
+        samples++;
+    }
+
+    deadReckonGetStats(&stats);
+    p_result->steps           = stats.steps;
+    p_result->kMm             = stats.kMm;
+    p_result->meanErrorMm     = samples ? (uint32_t)(error_sum / samples) : 0;
+    p_result->holdMeanErrorMm = samples ? (uint32_t)(hold_sum / samples) : 0;
+}
+#endif
+
+/* [] END OF FILE */
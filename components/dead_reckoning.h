@@ -0,0 +1,165 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     dead_reckoning.h
+* Version:  1.0.0
+*
+* Brief: Pedestrian dead reckoning: a pedometer and step length estimator on
+*        the accelerometer, steps projected along the compass heading
+*        between GPS fixes.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    Positions are east and north of a local origin in mm (the caller picks
+*    the origin, e.g. the first fix of a walk, and converts to degrees).
+*
+*    Steps: the acceleration magnitude less a slow average of it (gravity)
+*    is smoothed; a step is the smoothed signal rising through
+*    DEAD_RECKON_STEP_MG, at least DEAD_RECKON_STEP_MIN_MS after the last
+*    step, and it re-arms once the signal falls below gravity. Sample at 20
+*    Hz or more, a step lasts about 500 ms.
+*
+*    Step length follows Weinberg: K * (peak - valley)^(1/4), the swing in
+*    m/s^2 of the step, with K starting at DEAD_RECKON_STEP_K_MM. Each step
+*    moves the position its length along the heading set last.
+*
+*    Between steps the position is predicted forward along the heading at
+*    the pace of the last step, up to one step length, so readers see it
+*    move smoothly at the sample rate. With no step for DEAD_RECKON_STEP_
+*    MAX_MS the user has stopped and the prediction is dropped.
+*
+*    Each GPS fix resets the position to the fix; the distance between the
+*    two (the drift since the last fix) is kept. K is calibrated from the
+*    fixes: once the fix is DEAD_RECKON_CALIBRATE_MM from an anchor fix and
+*    the steps since were close to a straight line, the step sum is compared
+*    with the GPS distance and K moves a quarter of the way towards the
+*    ratio, if it is within DEAD_RECKON_CALIBRATE_PCT.
+*
+*    Only depends on <stdint.h>. Build with DEAD_RECKON_HOST = 1 to add a
+*    simulated walk with noisy GPS fixes on the host.
+*
+*******************************************************************************/
+#ifndef DEAD_RECKONING_H
+	#define DEAD_RECKONING_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+    #ifndef DEAD_RECKON_HOST
+        #define DEAD_RECKON_HOST 0
+    #endif
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* Smoothed rise above gravity that is a step (mg) */
+    #define DEAD_RECKON_STEP_MG         120
+
+    /* Shortest step, and longest before the user has stopped (ms) */
+    #define DEAD_RECKON_STEP_MIN_MS     250
+    #define DEAD_RECKON_STEP_MAX_MS     1500
+
+    /* Gravity average weight 1 / 2^shift per sample */
+    #define DEAD_RECKON_GRAVITY_SHIFT   5
+
+    /* Weinberg step constant to start from, and step length limits (mm) */
+    #define DEAD_RECKON_STEP_K_MM       450
+    #define DEAD_RECKON_STEP_MIN_MM     250
+    #define DEAD_RECKON_STEP_MAX_MM     1200
+
+    /* Calibration: GPS distance needed, most steps it may take, largest
+       correction accepted (%) */
+    #define DEAD_RECKON_CALIBRATE_MM    20000
+    #define DEAD_RECKON_CALIBRATE_STEPS 100
+    #define DEAD_RECKON_CALIBRATE_PCT   30
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+    // Dead reckoning counters.
+    typedef struct deadReckonStats{
+        uint32_t steps;                 // steps since reset
+        uint32_t stepsSinceFix;         // steps since the last fix
+        uint32_t stepMm;                // length of the last step
+        uint32_t stepMs;                // period of the last step, 0 = first
+        uint32_t kMm;                   // step constant now
+        uint32_t calibrations;          // times K was calibrated
+        uint32_t fixErrorMm;            // position to fix distance, last fix
+        uint32_t worstFixErrorMm;       // position to fix distance, worst
+    } deadReckonStats;
+
+    #if DEAD_RECKON_HOST == 1
+        // Result of a simulated walk.
+        typedef struct deadReckonSimResult{
+            uint32_t strides;           // true steps taken
+            uint32_t steps;             // steps detected
+            uint32_t meanErrorMm;       // position error, dead reckoning
+            uint32_t worstErrorMm;
+            uint32_t holdMeanErrorMm;   // position error, last fix held
+            uint32_t holdWorstErrorMm;
+            uint32_t kMm;               // step constant at the end
+        } deadReckonSimResult;
+    #endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    // Brief: Forget the position, pedometer, calibration and counters; K
+    //        goes back to DEAD_RECKON_STEP_K_MM.
+    // Param: none.
+    // Return: none
+    void deadReckonReset(void);
+
+    // Brief: Forget the position and pedometer for a new walk, keep K.
+    // Param: none.
+    // Return: none
+    void deadReckonRestart(void);
+
+    // Brief: A GPS fix, the position jumps to it.
+    // Param: east_mm, north_mm Fix, now_ms Time.
+    // Return: none
+    void deadReckonFix(int32_t east_mm, int32_t north_mm, uint32_t now_ms);
+
+    // Brief: Heading the next steps go along.
+    // Param: heading_deg Compass heading, clockwise from north.
+    // Return: none
+    void deadReckonHeading(int16_t heading_deg);
+
+    // Brief: Add an accelerometer sample.
+    // Param: magnitude_mg Acceleration magnitude, now_ms Time.
+    // Return: uint8_t 1 if it completed a step.
+    uint8_t deadReckonSample(uint32_t magnitude_mg, uint32_t now_ms);
+
+    // Brief: Position now, predicted from the last step.
+    // Param: now_ms Time, p_east_mm, p_north_mm Filled with the position.
+    // Return: uint8_t 1 once there has been a fix.
+    uint8_t deadReckonPosition(uint32_t now_ms, int32_t *p_east_mm, int32_t *p_north_mm);
+
+    // Brief: Copy the counters.
+    // Param: p_stats Filled with the counters.
+    // Return: none
+    void deadReckonGetStats(deadReckonStats *p_stats);
+
+    #if DEAD_RECKON_HOST == 1
+        // Brief: Walk a square with stops, sampling at 20 Hz, with stride,
+        //        accelerometer, heading and GPS noise.
+        // Param: duration_ms Simulated time, fix_ms Time between GPS fixes,
+        //        p_result Statistics of the run.
+        // Return: none
+        void deadReckonSimulate(uint32_t duration_ms, uint32_t fix_ms,
+            deadReckonSimResult *p_result);
+    #endif
+
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,258 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    debug_tx.c
+* Version: 1.0.0
+*
+* Brief: Asynchronous debug transmit path. Tasks queue debug text and trace
+*        frames without waiting; one transmitter task owns the UART TX.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*   UART
+*   DMA_DebugTx, isr_DebugTx (only with DEBUG_TX_DMA = 1)
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <project.h>
+#include "string.h"
+#include "debug_tx.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+#define DEBUG_TX_MASK   (DEBUG_TX_BUFFER - 1)
+
+/*******************************************************************************
+*   Variables
+*******************************************************************************/
+/* Bytes waiting, written at head by any task, sent from tail */
+static uint8 ring[DEBUG_TX_BUFFER];
+static uint32 head = 0;
+static uint32 tail = 0;
+
+/* Counters, updated inside the critical sections */
+static debugTxStats stats;
+
+/* Transmitter task, woken when bytes are queued */
+static TaskHandle_t txTask = NULL;
+
+#if DEBUG_TX_DMA == 1
+    /* DMA channel and transfer descriptor moving chunks to the TX FIFO */
+    static uint8 txChan;
+    static uint8 txTd;
+
+    /* Given by the DMA done interrupt */
+    static SemaphoreHandle_t txDone;
+    static StaticSemaphore_t txDoneBuffer;
+#endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Send one contiguous chunk of the ring, returns when it is sent.
+static void sendChunk( const uint8 *data, uint16 length );
+
+#if DEBUG_TX_DMA == 1
+    CY_ISR_PROTO( ISR_DebugTxDone );
+#endif
+
+/*******************************************************************************
+* Function Name: debugTxStart
+********************************************************************************
+* Summary:
+*   Set up the transmit path. The UART must be started.
+*******************************************************************************/
+void debugTxStart( void )
+{
+    head = 0;
+    tail = 0;
+    memset( &stats, 0, sizeof(stats) );
+
+    #if DEBUG_TX_DMA == 1
+        txDone = xSemaphoreCreateBinaryStatic( &txDoneBuffer );
+
+        /* One byte per FIFO not full request, SRAM to the UART TX data register */
+        txChan = DMA_DebugTx_DmaInitialize( 1, 1, HI16((uint32)ring), HI16(CYDEV_PERIPH_BASE) );
+        txTd = CyDmaTdAllocate();
+
+        isr_DebugTx_ClearPending();
+        isr_DebugTx_StartEx( ISR_DebugTxDone );
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: debugWrite
+********************************************************************************
+* Summary:
+*   Copy a message into the ring in one critical section, or drop all of it,
+*   then wake the transmitter. Never waits for the UART.
+*******************************************************************************/
+uint8 debugWrite( const void *data, uint16 length )
+{
+    const uint8 *bytes = (const uint8 *)data;
+    uint32 start, first, waiting;
+    uint8 queued = 0;
+
+    taskENTER_CRITICAL();
+    {
+        waiting = head - tail;
+        if ( waiting + length <= DEBUG_TX_BUFFER )
+        {
+            /* Copy in up to two parts around the end of the ring */
+            start = head & DEBUG_TX_MASK;
+            first = DEBUG_TX_BUFFER - start;
+            if ( first > length ) { first = length; }
+            memcpy( &ring[start], bytes, first );
+            memcpy( &ring[0], bytes + first, length - first );
+
+            head += length;
+            waiting += length;
+            stats.queued += length;
+            if ( waiting > stats.highWater ) { stats.highWater = (uint16)waiting; }
+            queued = 1;
+        }
+        else
+        {
+            stats.dropped += length;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if ( queued && txTask != NULL )
+    {
+        xTaskNotifyGive( txTask );
+    }
+    return queued;
+}
+
+/*******************************************************************************
+* Function Name: debugPrint
+********************************************************************************
+* Summary:
+*   Queue a string for transmission without waiting.
+*******************************************************************************/
+uint8 debugPrint( const char *text )
+{
+    return debugWrite( text, (uint16)strlen( text ) );
+}
+
+/*******************************************************************************
+* Function Name: debugTxRun
+********************************************************************************
+* Summary:
+*   Transmitter task body. Sends the ring in chunks straight from the ring
+*   memory; writers cannot overwrite a chunk until tail moves past it.
+*******************************************************************************/
+void debugTxRun( void )
+{
+    uint32 start, length;
+
+    txTask = xTaskGetCurrentTaskHandle();
+
+    while (1)
+    {
+        taskENTER_CRITICAL();
+        {
+            start = tail & DEBUG_TX_MASK;
+            length = head - tail;
+        }
+        taskEXIT_CRITICAL();
+
+        if ( length == 0 )
+        {
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            continue;
+        }
+
+        if ( length > DEBUG_TX_BUFFER - start ) { length = DEBUG_TX_BUFFER - start; }
+        if ( length > DEBUG_TX_CHUNK ) { length = DEBUG_TX_CHUNK; }
+
+        sendChunk( &ring[start], (uint16)length );
+
+        taskENTER_CRITICAL();
+        {
+            tail += length;
+            stats.sent += length;
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+
+/*******************************************************************************
+* Function Name: sendChunk
+********************************************************************************
+* Summary:
+*   DMA: one transfer descriptor per chunk, sleep until the done interrupt.
+*   CPU: fill the TX FIFO while it has room, sleep a tick when it is full
+*   (the FIFO drains 4 bytes in about 4 ms at 9600 baud).
+*******************************************************************************/
+static void sendChunk( const uint8 *data, uint16 length )
+{
+    #if DEBUG_TX_DMA == 1
+        CyDmaTdSetConfiguration( txTd, length, CY_DMA_DISABLE_TD, TD_INC_SRC_ADR | DMA_DebugTx__TD_TERMOUT_EN );
+        CyDmaTdSetAddress( txTd, LO16((uint32)data), LO16((uint32)UART_TXDATA_PTR) );
+        CyDmaChSetInitialTd( txChan, txTd );
+        CyDmaChEnable( txChan, 1 );
+
+        xSemaphoreTake( txDone, portMAX_DELAY );
+    #else
+        while ( length > 0 )
+        {
+            if ( UART_ReadTxStatus() & UART_TX_STS_FIFO_NOT_FULL )
+            {
+                UART_WriteTxData( *data++ );
+                length--;
+            }
+            else
+            {
+                vTaskDelay( 1 );
+            }
+        }
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: debugTxGetStats
+********************************************************************************
+* Summary:
+*   Read the transmit path counters.
+*******************************************************************************/
+void debugTxGetStats( debugTxStats *copy )
+{
+    taskENTER_CRITICAL();
+    {
+        *copy = stats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#if DEBUG_TX_DMA == 1
+/*******************************************************************************
+* Function Name: ISR_DebugTxDone
+********************************************************************************
+* Summary:
+*   DMA_DebugTx finished a chunk, wake the transmitter.
+*******************************************************************************/
+CY_ISR( ISR_DebugTxDone )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xSemaphoreGiveFromISR( txDone, &xHigherPriorityTaskWoken );
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+#endif
+
+/* [] END OF FILE */
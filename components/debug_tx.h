@@ -0,0 +1,100 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    debug_tx.h
+* Version: 1.0.0
+*
+* Brief: Asynchronous debug transmit path. Tasks queue debug text and trace
+*        frames without waiting; one transmitter task owns the UART TX.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*   UART
+*   DMA_DebugTx, isr_DebugTx (only with DEBUG_TX_DMA = 1)
+*
+* Notes:
+*   debugWrite() copies into a DEBUG_TX_BUFFER byte ring inside a short
+*   critical section and returns; if the whole message does not fit it is
+*   dropped and counted, so writers never block and frames are never cut.
+*   debugTxRun() is the body of the transmitter task: it sends the ring in
+*   contiguous chunks.
+*
+*   With DEBUG_TX_DMA = 0 chunks are fed into the UART TX FIFO while it has
+*   room, sleeping a tick when it is full. With DEBUG_TX_DMA = 1 each chunk is
+*   moved by DMA and the task sleeps until the DMA done interrupt. That needs
+*   in TopDesign: a DMA component DMA_DebugTx with its drq from the UART TX
+*   FIFO not full status (tx_interrupt, "FIFO not full" only) and its nrq to
+*   an isr component isr_DebugTx.
+*
+*   GPS receive no longer shares anything with debug output: only the
+*   transmitter task touches UART TX once the scheduler runs. Before that,
+*   print with UART_PutString(): the critical section in debugWrite() would
+*   leave interrupts masked until the scheduler starts.
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <project.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+// Move chunks with DMA_DebugTx (see Notes), 0 = CPU feeds the TX FIFO.
+#ifndef DEBUG_TX_DMA
+    #define DEBUG_TX_DMA        0
+#endif
+
+// Bytes queued for transmission, power of 2.
+#define DEBUG_TX_BUFFER         1024
+
+// Largest chunk moved at once (one DMA transfer).
+#define DEBUG_TX_CHUNK          64
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+// Transmit path counters.
+typedef struct debugTxStats{
+    uint32 queued;      // bytes accepted
+    uint32 dropped;     // bytes dropped because the buffer was full
+    uint32 sent;        // bytes handed to the UART
+    uint16 highWater;   // most bytes ever waiting
+} debugTxStats;
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Set up the transmit path, call before the scheduler starts.
+// Param: none.
+// Return: none.
+void debugTxStart( void );
+
+// Brief: Queue bytes for transmission without waiting.
+// Param: data Bytes, length Number of bytes.
+// Return: 1 if queued, 0 if dropped.
+uint8 debugWrite( const void *data, uint16 length );
+
+// Brief: Queue a string for transmission without waiting.
+// Param: text Zero terminated string.
+// Return: 1 if queued, 0 if dropped.
+uint8 debugPrint( const char *text );
+
+// Brief: Transmitter task body, never returns.
+// Param: none.
+// Return: none.
+void debugTxRun( void );
+
+// Brief: Read the transmit path counters.
+// Param: stats Filled with the counters.
+// Return: none.
+void debugTxGetStats( debugTxStats *stats );
+
+/* [] END OF FILE */
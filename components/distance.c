@@ -5,8 +5,8 @@
 * File:    distance.c
 * Version: 1.0.0
 *
-* Brief: for PSoC devices that interfaces HRLV-MaxSonar-EZ0. Takes readings of two
-*        takes two sensor readings in an output command loop.
+* Brief: for PSoC devices that interfaces HRLV-MaxSonar-EZ0. Samples three
+*        sensors continuously into per-sensor ring buffers.
 *
 * Target device:
 *    CY8C5888LTI - LP097
@@ -17,9 +17,8 @@
 *    - Compiler: GCC 5.4
 *
 * Components:
-*   ADC_SAR_1
-*   ADC_SAR_2
-*   UART_1
+*   ADC_SAR_Seq_1
+*   Ultrasonic_Rx
 *
 * Source:
 *    Reading from analog pins is taken from this guide
@@ -38,67 +37,332 @@
 /* Sensor Resolution = Vcc / 1024, where Vcc is 4.99 here. */
 #define MAXBOTIX_RESOLUTION 4.87305e-3
 
+/* cm per volt of sensor output */
+#define MAXBOTIX_CM_PER_VOLT ((MAXBOTIX_V_RANGE / MAXBOTIX_RESOLUTION) * 0.1)
+
+/* Fraction bits of the smoothed counts */
+#define DISTANCE_EMA_FRACTION   4
+
+/* Counts used to work out the counts to cm scale */
+#define DISTANCE_SCALE_COUNTS   1024
+
 /*******************************************************************************
-* Function Name: distanceReading
+*   Variable definitions
+*******************************************************************************/
+/* Per-sensor sample ring buffers, written by the end of sequence callback */
+static volatile distanceSample ringBuffer[DISTANCE_SENSORS][DISTANCE_RING_SIZE];
+
+/* Samples stored per sensor, the newest sample is at (count - 1) */
+static volatile uint32 sampleCount[DISTANCE_SENSORS];
+
+/* Number of completed sequences */
+static volatile uint32 sequenceCount = 0;
+
+/* Boolean flag whether the sample scheduler is running */
+static volatile uint8 sampling = 0;
+
+/* Trigger pins left high by the last slot */
+static volatile uint8 triggerMask = 0;
+
+/* Sensors read by the running ADC sequence, and when each was triggered */
+static volatile uint8 readMask = 0;
+static volatile uint32 readTriggerTime[DISTANCE_SENSORS];
+
+/* Tick of the newest sample of any sensor */
+static volatile uint32 newestSampleTime = 0;
+
+/* Median filtered, exponentially smoothed counts per sensor (Q4) */
+static volatile int32 smoothedCounts[DISTANCE_SENSORS];
+
+/* cm per count in Q16, worked out once at start */
+static uint32 countsToCm = 0;
+
+/* Task notified when new samples arrive */
+static TaskHandle_t sampleTask = NULL;
+
+/*******************************************************************************
+*   Private Function Declarations
+*******************************************************************************/
+// Brief: Update the median / exponential filter of one sensor.
+// Param: sensor Sensor number.
+// Return: none.
+static void filterSensor( uint8 sensor );
+
+/*******************************************************************************
+* Function Name: startUltrasonicSensors
 ********************************************************************************
 * Summary:
-*   Reads analog volage from Ultrasonic Sensors and uses a VDAC to get distance.
-*   Reads three sensors in an output comman loops
+*   Starts the ADC sequencer and the continuous sample scheduler.
 *******************************************************************************/
 void startUltrasonicSensors( void )
 {
+    uint8 sensor;
+    
     ADC_SAR_Seq_1_Start();
+    
+    /* Only float conversion: the ADC's counts to volts gain, done once */
+    countsToCm = (uint32)( ADC_SAR_Seq_1_CountsTo_Volts( DISTANCE_SCALE_COUNTS )
+        * MAXBOTIX_CM_PER_VOLT * 65536.0 / DISTANCE_SCALE_COUNTS );
+    
+    for ( sensor = 0; sensor < DISTANCE_SENSORS; sensor++ )
+    {
+        sampleCount[sensor] = 0;
+    }
+    sequenceCount = 0;
+    
+    sonarScheduleStart( DISTANCE_SCHEDULE );
+    sampling = 1;
 }
 
 /*******************************************************************************
-* Function Name: distanceReading
+* Function Name: distanceTickHook
 ********************************************************************************
 * Summary:
-*   Reads analog volage from Ultrasonic Sensors and uses a VDAC to get distance
-*   in cm.
-*   Reads three sensors in an output comman loops
+*   Called from the RTOS tick interrupt. On every slot of the sonar schedule
+*   it starts one ADC sequence for the sensors whose range cycle is over and
+*   raises the Ultrasonic_Rx pins of the sensors in the slot, then drops them
+*   on the next tick (the sensors need RX high for at least 20 us). Runs while
+*   the scheduler is suspended for speech, so sampling never pauses.
 *******************************************************************************/
-void distanceReading(ultrasonicSensor *readings)
+void distanceTickHook( void )
 {
-    /* Initialize variables */
-    int16 adc_result1 = 0;
-    int16 adc_result2 = 0;
-    int16 adc_result3 = 0;
+    uint32 now;
+    uint8 trigger, read, sensor;
     
-    float volt_reading1 = 0;
-    float volt_reading2 = 0;
-    float volt_reading3 = 0;
+    if ( !sampling )
+    {
+        return;
+    }
     
-    /* Start conversion */
-    ADC_SAR_Seq_1_StartConvert();
+    if ( triggerMask )
+    {
+        Ultrasonic_Rx_Write(0);
+        triggerMask = 0;
+    }
     
-    /* Send range signal */
-    Ultrasonic_Rx_Write(1);
-    CyDelayUs(20);
-    Ultrasonic_Rx_Write(0);
+    /* Trigger times of the readings about to be taken, before any retrigger */
+    now = xTaskGetTickCountFromISR() * portTICK_PERIOD_MS;
+    for ( sensor = 0; sensor < DISTANCE_SENSORS; sensor++ )
+    {
+        readTriggerTime[sensor] = sonarTriggerTime(sensor);
+    }
     
-    /* Sensor 1 */
-    /* If ADC has finished converting, get the result */
-    adc_result1 = ADC_SAR_Seq_1_GetResult16(0);
+    trigger = sonarScheduleTick( now, &read );
     
-    /* Convert the raw ADC reading to volts */
-    volt_reading1 = ADC_SAR_Seq_1_CountsTo_Volts(adc_result1);
+    if ( read )
+    {
+        /* Results arrive in ADC_SAR_Seq_1_ISR_InterruptCallback */
+        readMask = read;
+        ADC_SAR_Seq_1_StartConvert();
+    }
+    
+    if ( trigger )
+    {
+        /* Send range signal, one RX pin per sensor */
+        Ultrasonic_Rx_Write( trigger );
+        triggerMask = trigger;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ADC_SAR_Seq_1_ISR_InterruptCallback
+********************************************************************************
+* Summary:
+*   End of sequence callback. The sequencer DMA has moved all channels into
+*   its result buffer; copies the sensors due to be read into the ring
+*   buffers with their trigger and read times, updates their filters and
+*   wakes the registered task.
+*******************************************************************************/
+void ADC_SAR_Seq_1_ISR_InterruptCallback( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32 timestamp = xTaskGetTickCountFromISR();
+    uint8 read = readMask;
+    uint8 sensor, slot;
+    
+    for ( sensor = 0; sensor < DISTANCE_SENSORS; sensor++ )
+    {
+        if ( read & (1u << sensor) )
+        {
+            slot = sampleCount[sensor] & (DISTANCE_RING_SIZE - 1);
+            ringBuffer[sensor][slot].counts = ADC_SAR_Seq_1_GetResult16(sensor);
+            ringBuffer[sensor][slot].triggered = readTriggerTime[sensor];
+            ringBuffer[sensor][slot].timestamp = timestamp;
+            sampleCount[sensor]++;
+            
+            filterSensor( sensor );
+        }
+    }
+    
+    readMask = 0;
+    newestSampleTime = timestamp;
+    sequenceCount++;
+    
+    if ( sampleTask != NULL )
+    {
+        vTaskNotifyGiveFromISR( sampleTask, &xHigherPriorityTaskWoken );
+        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+    }
+}
+
+/*******************************************************************************
+* Function Name: filterSensor
+********************************************************************************
+* Summary:
+*   Takes the median of the newest DISTANCE_MEDIAN_SIZE samples, which drops
+*   a single spurious echo, and smooths it with an exponential moving average
+*   of weight 1 / 2^DISTANCE_EMA_SHIFT. Integer only, called from the end of
+*   sequence interrupt.
+*******************************************************************************/
+static void filterSensor( uint8 sensor )
+{
+    int16 window[DISTANCE_MEDIAN_SIZE];
+    int16 value;
+    int32 median;
+    uint32 newest = sampleCount[sensor];
+    uint8 count, i, j;
+    
+    count = (newest < DISTANCE_MEDIAN_SIZE) ? (uint8)newest : DISTANCE_MEDIAN_SIZE;
+    
+    /* Insertion sort of the newest samples */
+    for ( i = 0; i < count; i++ )
+    {
+        value = ringBuffer[sensor][(newest - 1 - i) & (DISTANCE_RING_SIZE - 1)].counts;
+        for ( j = i; j > 0 && window[j - 1] > value; j-- )
+        {
+            window[j] = window[j - 1];
+        }
+        window[j] = value;
+    }
+    median = (int32)window[count / 2] << DISTANCE_EMA_FRACTION;
+    
+    if ( newest == 1 )
+    {
+        smoothedCounts[sensor] = median;
+    }
+    else
+    {
+        smoothedCounts[sensor] += (median - smoothedCounts[sensor]) >> DISTANCE_EMA_SHIFT;
+    }
+}
+
+/*******************************************************************************
+* Function Name: distanceNotifyOnSample
+********************************************************************************
+* Summary:
+*   Registers the task woken by every completed ADC sequence.
+*******************************************************************************/
+void distanceNotifyOnSample( TaskHandle_t task )
+{
+    sampleTask = task;
+}
+
+/*******************************************************************************
+* Function Name: distanceHistory
+********************************************************************************
+* Summary:
+*   Copies up to count of the newest samples of a sensor, newest first.
+*******************************************************************************/
+uint8 distanceHistory( uint8 sensor, distanceSample *samples, uint8 count )
+{
+    uint32 newest;
+    uint8 i;
+    
+    if ( sensor >= DISTANCE_SENSORS ) { return 0; }
+    if ( count > DISTANCE_RING_SIZE ) { count = DISTANCE_RING_SIZE; }
+    
+    /* Keep the callback from overwriting samples while they are copied */
+    uint8 interruptState = CyEnterCriticalSection();
+    
+    newest = sampleCount[sensor];
+    if ( count > newest ) { count = (uint8)newest; }
+    
+    for ( i = 0; i < count; i++ )
+    {
+        samples[i] = ringBuffer[sensor][(newest - 1 - i) & (DISTANCE_RING_SIZE - 1)];
+    }
+    
+    CyExitCriticalSection( interruptState );
+    
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: distanceSampleCount
+********************************************************************************
+* Summary:
+*   Returns the number of ADC sequences completed since start.
+*******************************************************************************/
+uint32 distanceSampleCount( void )
+{
+    return sequenceCount;
+}
+
+/*******************************************************************************
+* Function Name: distanceSetPace
+********************************************************************************
+* Summary:
+*   Stretches the sonar schedule's slots. Written from a task while the tick
+*   hook reads it, a single word so no lock is needed.
+*******************************************************************************/
+void distanceSetPace( uint32 slotMs )
+{
+    sonarSchedulePace( slotMs );
+}
+
+/*******************************************************************************
+* Function Name: distanceIdleTicks
+********************************************************************************
+* Summary:
+*   Returns how many ticks the tick hook can be skipped for: none while a
+*   trigger pin has to drop on the next tick, up to the next sonar slot
+*   otherwise, so the tick only has to run on slots, however the schedule is
+*   paced. The tick that ends a tickless sleep runs the hook.
+*******************************************************************************/
+TickType_t distanceIdleTicks( void )
+{
+    if ( !sampling )
+    {
+        return portMAX_DELAY;
+    }
+    if ( triggerMask )
+    {
+        return 0;
+    }
+
+    return sonarMsToNextSlot( xTaskGetTickCount() * portTICK_PERIOD_MS ) / portTICK_PERIOD_MS;
+}
+
+/*******************************************************************************
+* Function Name: distanceReading
+********************************************************************************
+* Summary:
+*   Converts each sensor's filtered counts to distance in cm with the
+*   precomputed scale. Does not start a conversion, so it is cheap to call and
+*   never returns a partial result. Distances read 0 until the first sample
+*   has arrived.
+*******************************************************************************/
+void distanceReading(ultrasonicSensor *readings)
+{
+    int16 distances[DISTANCE_SENSORS];
+    int32 counts;
+    uint8 sensor;
     
-    /* Convert voltage to distance */
-    readings->distance1 = volt_reading1 * (MAXBOTIX_V_RANGE / MAXBOTIX_RESOLUTION) * 0.1;
+    uint8 interruptState = CyEnterCriticalSection();
     
-    /* Sensor 2 */
-    adc_result2 =  ADC_SAR_Seq_1_GetResult16(1);
-    volt_reading2 =  ADC_SAR_Seq_1_CountsTo_Volts(adc_result2);
-    readings->distance2 = volt_reading2 * (MAXBOTIX_V_RANGE / MAXBOTIX_RESOLUTION) * 0.1;
+    for ( sensor = 0; sensor < DISTANCE_SENSORS; sensor++ )
+    {
+        counts = smoothedCounts[sensor];
+        if ( counts < 0 ) { counts = 0; }
+        distances[sensor] = (int16)( ((uint32)counts * countsToCm) >> (16 + DISTANCE_EMA_FRACTION) );
+    }
+    readings->timestamp = newestSampleTime;
     
-    /* Sensor 3 */
-    adc_result3 =  ADC_SAR_Seq_1_GetResult16(2);
-    volt_reading3 =  ADC_SAR_Seq_1_CountsTo_Volts(adc_result3);
-    readings->distance3 = volt_reading3 * (MAXBOTIX_V_RANGE / MAXBOTIX_RESOLUTION) * 0.1;
+    CyExitCriticalSection( interruptState );
     
-    /* End conversion */
-    ADC_SAR_Seq_1_StopConvert();
+    readings->distance1 = distances[0];
+    readings->distance2 = distances[1];
+    readings->distance3 = distances[2];
 }
 
 /* [] END OF FILE */
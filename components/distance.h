@@ -5,8 +5,8 @@
 * File: distance.h
 * version: 1.0.0
 *
-* Brief: for PSoC devices that interfaces HRLV-MaxSonar-EZ0. Takes readings of two
-*        takes two sensor readings in an output command loop.
+* Brief: for PSoC devices that interfaces HRLV-MaxSonar-EZ0. Samples three
+*        sensors continuously into per-sensor ring buffers.
 *
 * Target device:
 *    CY8C5888LTI - LP097
@@ -17,32 +17,113 @@
 *    - Compiler: GCC 5.4
 *
 * Components:
-*   ADC_SAR_1
-*   ADC_SAR_2
-*   UART_1
+*   ADC_SAR_Seq_1
+*   Ultrasonic_Rx
+*
+* Notes:
+*   Sensors are sampled continuously: distanceTickHook() runs the sonar
+*   schedule (sonar_schedule.h) from the RTOS tick, triggering sensors in
+*   slots and starting an ADC sequence for the sensors whose range cycle is
+*   over. The sequencer DMAs all three channels into its result buffer, and
+*   the end of sequence callback copies the due sensors into per-sensor ring
+*   buffers with trigger and read timestamps. Each sensor is then median filtered and exponentially
+*   smoothed in integer ADC counts. Readers never start conversions. The task registered with
+*   distanceNotifyOnSample() is notified after every sequence.
 *
 * Source:
 *     Reading from analog pins is taken from this guide
 *    https://www.esipfed.org/student-fellow-blog/diy-sensing-anatomy-of-an-analog-sensor
 *
 *******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sonar_schedule.h"
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+// Number of sensors in the ultrasonic array (ADC_SAR_Seq_1 channels 0..2).
+#define DISTANCE_SENSORS            SONAR_SENSORS
+
+// Sensor trigger pattern. SONAR_CHAIN and SONAR_INTERLEAVED need Ultrasonic_Rx
+// widened to one pin per sensor RX (bit n = sensor n); with a single RX line
+// shared by all sensors only SONAR_TOGETHER fires every sensor.
+#define DISTANCE_SCHEDULE           SONAR_TOGETHER
+
+// Samples kept per sensor, power of 2.
+#define DISTANCE_RING_SIZE          8
+
+// Newest samples a sensor's median is taken over, odd, at most DISTANCE_RING_SIZE.
+#define DISTANCE_MEDIAN_SIZE        3
+
+// Exponential smoothing weight of a new median is 1 / 2^DISTANCE_EMA_SHIFT.
+#define DISTANCE_EMA_SHIFT          1
+
+/*******************************************************************************
 *   Structures
 *******************************************************************************/
 // Ultrasonic Array with 3 sensors, hence 3 readings.
 typedef struct ultrasonicSensor{
-    double distance1;
-    double distance2;
-    double distance3;
+    int16  distance1;   // cm
+    int16  distance2;   // cm
+    int16  distance3;   // cm
+    uint32 timestamp;   // RTOS tick of the newest sample
 } ultrasonicSensor;
 
+// One timestamped ADC sample of a sensor.
+typedef struct distanceSample{
+    int16  counts;
+    uint32 triggered;   // RTOS tick the sensor was triggered
+    uint32 timestamp;   // RTOS tick the sample was read
+} distanceSample;
+
 /*******************************************************************************
 *   Function Declarations
 *******************************************************************************/
 // Breif: Start Peripherals for Ultrasonic sensors.
 void startUltrasonicSensors( void );
 
-// Brief: Takes Distance Readings from two HRLV-MaxSonar-EZ0 sensors
-// Return: distance readings
+// Brief: Filtered distance readings. Does not start a conversion.
+// Param: readings Filled with distances in cm and the newest sample tick.
+// Return: none.
 void distanceReading( ultrasonicSensor *readings);
 
+// Brief: Copy the newest samples of one sensor, newest first.
+// Param: sensor Sensor number (0..DISTANCE_SENSORS-1), samples Destination,
+//        count Number of samples wanted (at most DISTANCE_RING_SIZE).
+// Return: number of samples copied (fewer until the ring has filled).
+uint8 distanceHistory( uint8 sensor, distanceSample *samples, uint8 count );
+
+// Brief: Notify a task (xTaskNotifyGive) each time new samples arrive.
+// Param: task Task to notify, NULL to stop notifying.
+// Return: none.
+void distanceNotifyOnSample( TaskHandle_t task );
+
+// Brief: Number of ADC sequences completed since startUltrasonicSensors().
+// Param: none.
+// Return: sequence count.
+uint32 distanceSampleCount( void );
+
+// Brief: Slow sampling down to save power, or back to the full rate.
+// Param: slotMs Time between sonar slots, 0 for the fastest the schedule allows.
+// Return: none.
+void distanceSetPace( uint32 slotMs );
+
+// Brief: Ticks distanceTickHook() can go without running.
+// Param: none.
+// Return: 0 if it is needed on the next tick, portMAX_DELAY when not sampling.
+TickType_t distanceIdleTicks( void );
+
+// Brief: Sample scheduler, call once per RTOS tick (vApplicationTickHook).
+// Param: none.
+// Return: none.
+void distanceTickHook( void );
+
+// Brief: ADC_SAR_Seq_1 end of sequence callback (see cyapicallbacks.h).
+// Param: none.
+// Return: none.
+void ADC_SAR_Seq_1_ISR_InterruptCallback( void );
+
 /* [] END OF FILE */
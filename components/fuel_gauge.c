@@ -0,0 +1,217 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     fuel_gauge.c
+* Version:  1.0.0
+*
+* Brief: Battery fuel gauge: load compensated, filtered pack voltage mapped
+*        to charge through a discharge curve.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "fuel_gauge.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* Open circuit pack voltage (mV) at 0, 5, .. 100 % */
+static const uint16_t DISCHARGE_CURVE[FUEL_GAUGE_POINTS] = {
+    6000, 6900, 7360, 7400, 7460, 7500, 7540, 7580, 7600, 7640,
+    7680, 7700, 7740, 7820, 7900, 7960, 8040, 8160, 8220, 8300,
+    8400
+};
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+/* Filtered open circuit voltage, mV << FUEL_GAUGE_FILTER_SHIFT, 0 = empty */
+static uint32_t g_filtered = 0;
+
+/* Last results, one word each so readers need no lock */
+static volatile uint32_t g_millivolts = 0;
+static volatile uint32_t g_level = 0;
+
+/*******************************************************************************
+* Function Name: fuelGaugeReset
+********************************************************************************
+* Summary:
+*    Forgets the filter state.
+*******************************************************************************/
+void fuelGaugeReset(void)
+{
+    g_filtered   = 0;
+    g_millivolts = 0;
+    g_level      = 0;
+}
+
+/*******************************************************************************
+* Function Name: fuelGaugeUpdate
+********************************************************************************
+* Summary:
+*    Compensates the sample for the load, averages it in (the first sample
+*    sets the average) and caches the voltage and level. The level only
+*    moves once it is FUEL_GAUGE_HYSTERESIS_PCT away, so noise on the flat
+*    part of the curve does not make it flicker.
+*******************************************************************************/
+uint32_t fuelGaugeUpdate(uint32_t measured_mv, uint32_t load_ma)
+{
+    uint32_t ocv = measured_mv + load_ma * FUEL_GAUGE_RESISTANCE_MOHM / 1000u;
+    uint32_t level;
+
+    if (0 == g_filtered)
+    {
+        g_filtered = ocv << FUEL_GAUGE_FILTER_SHIFT;
+    }
+    else
+    {
+        g_filtered += ocv - (g_filtered >> FUEL_GAUGE_FILTER_SHIFT);
+    }
+
+    ocv = g_filtered >> FUEL_GAUGE_FILTER_SHIFT;
+    level = fuelGaugePercent(ocv);
+    if (0 == g_millivolts || level >= g_level + FUEL_GAUGE_HYSTERESIS_PCT ||
+        level + FUEL_GAUGE_HYSTERESIS_PCT <= g_level)
+    {
+        g_level = level;
+    }
+    g_millivolts = ocv;
+    return ocv;
+}
+
+/*******************************************************************************
+* Function Name: fuelGaugePercent
+********************************************************************************
+* Summary:
+*    Finds the curve segment holding the voltage and interpolates, rounding
+*    to the nearest percent. Clamps to 0 % and 100 % outside the curve.
+*******************************************************************************/
+uint8_t fuelGaugePercent(uint32_t ocv_mv)
+{
+    uint32_t low;
+    uint32_t high;
+    uint8_t  i;
+
+    if (ocv_mv <= DISCHARGE_CURVE[0])
+    {
+        return 0;
+    }
+    if (ocv_mv >= DISCHARGE_CURVE[FUEL_GAUGE_POINTS - 1])
+    {
+        return 100;
+    }
+
+    for (i = 1; ocv_mv >= DISCHARGE_CURVE[i]; i++)
+    {
+    }
+    low  = DISCHARGE_CURVE[i - 1];
+    high = DISCHARGE_CURVE[i];
+
+    return (uint8_t)((i - 1) * FUEL_GAUGE_STEP_PCT
+        + ((ocv_mv - low) * FUEL_GAUGE_STEP_PCT * 2 + (high - low)) / ((high - low) * 2));
+}
+
+/*******************************************************************************
+* Function Name: fuelGaugeMillivolts
+********************************************************************************
+* Summary:
+*    Cached filtered voltage.
+*******************************************************************************/
+uint32_t fuelGaugeMillivolts(void)
+{
+    return g_millivolts;
+}
+
+/*******************************************************************************
+* Function Name: fuelGaugeLevel
+********************************************************************************
+* Summary:
+*    Cached level.
+*******************************************************************************/
+uint8_t fuelGaugeLevel(void)
+{
+    return (uint8_t)g_level;
+}
+
+#if FUEL_HOST == 1
+/*******************************************************************************
+* Function Name: fuelGaugeSimulate
+********************************************************************************
+* Summary:
+*    The true level falls linearly from 100 % to 0 %; the pack shows the
+*    curve voltage of that level less the load drop, plus +-40 mV of noise
+*    from a linear congruential generator. The load is 20 mA idle and
+*    220 mA while outputs are on, switching every 7 samples. The true
+*    voltage is interpolated from the curve at 0.01 % resolution.
+*******************************************************************************/
+void fuelGaugeSimulate(uint32_t samples, uint8_t compensate, fuelSimResult *p_result)
+{
+    uint32_t seed = 1;
+    uint32_t sample;
+    uint32_t truth;         // true level, % * 100
+    uint32_t segment;
+    uint32_t ocv;
+    uint32_t load;
+    uint32_t measured;
+    uint32_t level;
+    uint32_t error;
+    uint32_t previous = 100;
+    uint32_t errorSum = 0;
+    int32_t  noise;
+
+    p_result->samples    = samples;
+    p_result->worstError = 0;
+    p_result->rises      = 0;
+
+    fuelGaugeReset();
+
+    for (sample = 0; sample < samples; sample++)
+    {
+        truth = 10000u - (uint32_t)((uint64_t)sample * 10000u / (samples - 1));
+
+        segment = truth / (FUEL_GAUGE_STEP_PCT * 100);
+        if (segment >= FUEL_GAUGE_POINTS - 1)
+        {
+            ocv = DISCHARGE_CURVE[FUEL_GAUGE_POINTS - 1];
+        }
+        else
+        {
+            ocv = DISCHARGE_CURVE[segment] + (DISCHARGE_CURVE[segment + 1] - DISCHARGE_CURVE[segment])
+                * (truth - segment * FUEL_GAUGE_STEP_PCT * 100) / (FUEL_GAUGE_STEP_PCT * 100);
+        }
+
+        load = ((sample / 7) & 1) ? 220u : 20u;
+        seed = seed * 1103515245u + 12345u;
+        noise = (int32_t)((seed >> 16) % 81u) - 40;
+        measured = (uint32_t)((int32_t)(ocv - load * FUEL_GAUGE_RESISTANCE_MOHM / 1000u) + noise);
+
+        fuelGaugeUpdate(measured, compensate ? load : 0);
+        level = fuelGaugeLevel();
+
+        error = (level * 100 > truth) ? level * 100 - truth : truth - level * 100;
+        errorSum += error;
+        if (error / 100 > p_result->worstError)
+        {
+            p_result->worstError = error / 100;
+        }
+        if (level > previous)
+        {
+            p_result->rises++;
+        }
+        previous = level;
+    }
+
+    p_result->meanErrorX100 = samples ? errorSum / samples : 0;
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     fuel_gauge.h
+* Version:  1.0.0
+*
+* Brief: Battery fuel gauge: load compensated, filtered pack voltage mapped
+*        to charge through a discharge curve.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    Each sample is a pack voltage measured under a known load. The voltage
+*    the pack would show unloaded is measured + load * FUEL_GAUGE_RESISTANCE
+*    _MOHM (cells, protection board and wiring). That passes an exponential
+*    average with weight 1 / 2^FUEL_GAUGE_FILTER_SHIFT, and the result is
+*    looked up in the discharge curve, FUEL_GAUGE_POINTS open circuit
+*    voltages FUEL_GAUGE_STEP_PCT apart, interpolated linearly to 1 %.
+*    The reported level follows with FUEL_GAUGE_HYSTERESIS_PCT hysteresis.
+*
+*    The curve is a 2S Li-ion pack, 6.00 V empty to 8.40 V full, from the
+*    typical cell curve (flat plateau around 3.8 V per cell, steep below
+*    3.7 V). Recalibrate it from a logged discharge of the actual pack at
+*    a light load.
+*
+*    The last voltage and level are cached in single words, so any task or
+*    interrupt reads them without a lock.
+*
+*    Only depends on <stdint.h>. Build with FUEL_HOST = 1 to add a
+*    simulated discharge with load steps and ADC noise on the host.
+*
+*******************************************************************************/
+#ifndef FUEL_GAUGE_H
+	#define FUEL_GAUGE_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+    #ifndef FUEL_HOST
+        #define FUEL_HOST 0
+    #endif
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* Discharge curve points, 0 % to 100 % */
+    #define FUEL_GAUGE_POINTS           21
+
+    /* Charge between curve points (%) */
+    #define FUEL_GAUGE_STEP_PCT         5
+
+    /* Exponential average weight 1 / 2^shift per sample */
+    #define FUEL_GAUGE_FILTER_SHIFT     3
+
+    /* Pack series resistance for load compensation (milliohm) */
+    #define FUEL_GAUGE_RESISTANCE_MOHM  150
+
+    /* Change needed before the reported level moves (%) */
+    #define FUEL_GAUGE_HYSTERESIS_PCT   2
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+    #if FUEL_HOST == 1
+        // Result of a simulated discharge.
+        typedef struct fuelSimResult{
+            uint32_t samples;
+            uint32_t worstError;        // worst |gauge - true| level (%)
+            uint32_t meanErrorX100;     // mean |gauge - true| level (% * 100)
+            uint32_t rises;             // samples where the level went up
+        } fuelSimResult;
+    #endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    // Brief: Forget the filter state, the next sample starts it.
+    // Param: none.
+    // Return: none
+    void fuelGaugeReset(void);
+
+    // Brief: Add a sample.
+    // Param: measured_mv Pack voltage, load_ma Load current while measured.
+    // Return: uint32_t Filtered open circuit voltage (mV).
+    uint32_t fuelGaugeUpdate(uint32_t measured_mv, uint32_t load_ma);
+
+    // Brief: Charge level of an open circuit voltage.
+    // Param: ocv_mv Pack voltage.
+    // Return: uint8_t Level 0 .. 100 (%).
+    uint8_t fuelGaugePercent(uint32_t ocv_mv);
+
+    // Brief: Filtered open circuit voltage of the last sample.
+    // Param: none.
+    // Return: uint32_t Voltage (mV), 0 before the first sample.
+    uint32_t fuelGaugeMillivolts(void);
+
+    // Brief: Charge level of the last sample.
+    // Param: none.
+    // Return: uint8_t Level 0 .. 100 (%).
+    uint8_t fuelGaugeLevel(void);
+
+    #if FUEL_HOST == 1
+        // Brief: Discharge a simulated pack from full to empty while the load
+        //        steps between idle and outputs on, with ADC noise.
+        // Param: samples Samples over the discharge, compensate 0 = pass a
+        //        0 mA load to the gauge, p_result Statistics of the run.
+        // Return: none
+        void fuelGaugeSimulate(uint32_t samples, uint8_t compensate, fuelSimResult *p_result);
+    #endif
+
+#endif
+
+/* [] END OF FILE */
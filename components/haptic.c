@@ -0,0 +1,312 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    haptic.c
+* Version: 1.0.0
+*
+* Brief: Haptic pattern engine. Plays duty cycle envelopes from flash into
+*        the motor PWM compare registers.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*   PWM_1
+*   PWM_2
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <project.h>
+#include "haptic.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* PWM_1 / PWM_2 period in TopDesign */
+#define PWM_PERIOD      150
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+/* Duty cycle envelope in flash */
+typedef struct hapticEnvelope{
+    const uint8 *duty;      // duty per step, 0..255
+    uint8 length;           // number of steps
+    uint8 stepMs;           // time per step
+} hapticEnvelope;
+
+/* One priority layer of a motor */
+typedef struct hapticLayer{
+    uint8 active;
+    uint8 loop;
+    uint8 pattern;
+    uint8 intensity;
+    uint8 position;         // current step
+    uint8 msLeft;           // time left in the current step
+} hapticLayer;
+
+/*******************************************************************************
+*   Envelope tables
+*******************************************************************************/
+static const uint8 DUTY_CONSTANT[]   = { 255 };
+static const uint8 DUTY_PULSE[]      = { 255, 0 };
+static const uint8 DUTY_RAMP_UP[]    = {   0,  13,  27,  40,  54,  67,  81,  94, 107, 121,
+                                         134, 148, 161, 174, 188, 201, 215, 228, 242, 255 };
+static const uint8 DUTY_RAMP_DOWN[]  = { 255, 242, 228, 215, 201, 188, 174, 161, 148, 134,
+                                         121, 107,  94,  81,  67,  54,  40,  27,  13,   0 };
+static const uint8 DUTY_DOUBLE_TAP[] = { 255, 255, 255, 0, 0, 0, 255, 255, 255, 0 };
+
+/* Indexed by hapticPattern */
+static const hapticEnvelope ENVELOPES[HAPTIC_PATTERN_COUNT] = {
+    { DUTY_CONSTANT,   sizeof(DUTY_CONSTANT),   20  },
+    { DUTY_PULSE,      sizeof(DUTY_PULSE),      200 },
+    { DUTY_PULSE,      sizeof(DUTY_PULSE),      80  },
+    { DUTY_RAMP_UP,    sizeof(DUTY_RAMP_UP),    20  },
+    { DUTY_RAMP_DOWN,  sizeof(DUTY_RAMP_DOWN),  20  },
+    { DUTY_DOUBLE_TAP, sizeof(DUTY_DOUBLE_TAP), 20  },
+};
+
+/*******************************************************************************
+*   Variables
+*******************************************************************************/
+static hapticLayer layers[HAPTIC_MOTORS][HAPTIC_PRIORITIES];
+
+/* Compare value last written to each motor */
+static uint8 motorCompare[HAPTIC_MOTORS];
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Write a compare value to one motor's PWM.
+// Param: motor Motor number, compare Compare value (0..PWM_PERIOD).
+// Return: none.
+static void writeMotor( uint8 motor, uint8 compare );
+
+/*******************************************************************************
+* Function Name: hapticStart
+********************************************************************************
+* Summary:
+*   Clear every layer and turn the motors off. PWM_1 and PWM_2 must be
+*   started.
+*******************************************************************************/
+void hapticStart( void )
+{
+    uint8 motor, priority;
+
+    taskENTER_CRITICAL();
+    for ( motor = 0; motor < HAPTIC_MOTORS; motor++ )
+    {
+        for ( priority = 0; priority < HAPTIC_PRIORITIES; priority++ )
+        {
+            layers[motor][priority].active = 0;
+        }
+        writeMotor( motor, 0 );
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: hapticPlay
+********************************************************************************
+* Summary:
+*   Start a pattern on a layer of each selected motor.
+*******************************************************************************/
+void hapticPlay( uint8 motors, hapticPattern pattern, hapticPriority priority,
+                 uint8 intensity, uint8 loop )
+{
+    hapticLayer *layer;
+    uint8 motor;
+
+    if ( pattern >= HAPTIC_PATTERN_COUNT || priority >= HAPTIC_PRIORITIES )
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    for ( motor = 0; motor < HAPTIC_MOTORS; motor++ )
+    {
+        if ( !( motors & (1u << motor) ) )
+        {
+            continue;
+        }
+
+        layer = &layers[motor][priority];
+        layer->intensity = intensity;
+
+        if ( !layer->active || !layer->loop || !loop || layer->pattern != pattern )
+        {
+            layer->pattern = pattern;
+            layer->loop = loop;
+            layer->position = 0;
+            layer->msLeft = ENVELOPES[pattern].stepMs;
+            layer->active = 1;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: hapticStop
+********************************************************************************
+* Summary:
+*   Stop a layer of each selected motor.
+*******************************************************************************/
+void hapticStop( uint8 motors, hapticPriority priority )
+{
+    uint8 motor;
+
+    if ( priority >= HAPTIC_PRIORITIES )
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    for ( motor = 0; motor < HAPTIC_MOTORS; motor++ )
+    {
+        if ( motors & (1u << motor) )
+        {
+            layers[motor][priority].active = 0;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: hapticBusy
+********************************************************************************
+* Summary:
+*   Returns 1 while a layer plays or a motor is still driven, until then
+*   hapticTickHook() is needed every tick.
+*******************************************************************************/
+uint8 hapticBusy( void )
+{
+    uint8 motor, priority;
+
+    for ( motor = 0; motor < HAPTIC_MOTORS; motor++ )
+    {
+        if ( motorCompare[motor] != 0 )
+        {
+            return 1;
+        }
+        for ( priority = 0; priority < HAPTIC_PRIORITIES; priority++ )
+        {
+            if ( layers[motor][priority].active )
+            {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: hapticDrive
+********************************************************************************
+* Summary:
+*   Sum of the motor duty cycles now, in percent of one motor at full duty.
+*******************************************************************************/
+uint16 hapticDrive( void )
+{
+    uint16 drive = 0;
+    uint8 motor;
+
+    for ( motor = 0; motor < HAPTIC_MOTORS; motor++ )
+    {
+        drive += (uint16)motorCompare[motor] * 100 / PWM_PERIOD;
+    }
+    return drive;
+}
+
+/*******************************************************************************
+* Function Name: hapticTickHook
+********************************************************************************
+* Summary:
+*   Called from the RTOS tick interrupt. Steps every active layer and drives
+*   each motor from its highest priority active layer. Compare registers are
+*   only written when the value changes.
+*******************************************************************************/
+void hapticTickHook( void )
+{
+    const hapticEnvelope *envelope;
+    hapticLayer *layer;
+    hapticLayer *top;
+    uint8 motor, priority;
+    uint8 compare;
+
+    for ( motor = 0; motor < HAPTIC_MOTORS; motor++ )
+    {
+        top = NULL;
+
+        for ( priority = 0; priority < HAPTIC_PRIORITIES; priority++ )
+        {
+            layer = &layers[motor][priority];
+            if ( !layer->active )
+            {
+                continue;
+            }
+
+            envelope = &ENVELOPES[layer->pattern];
+            if ( --layer->msLeft == 0 )
+            {
+                layer->msLeft = envelope->stepMs;
+                if ( ++layer->position >= envelope->length )
+                {
+                    layer->position = 0;
+                    layer->active = layer->loop;
+                }
+            }
+
+            if ( layer->active )
+            {
+                top = layer;
+            }
+        }
+
+        compare = 0;
+        if ( top != NULL )
+        {
+            envelope = &ENVELOPES[top->pattern];
+            compare = (uint8)( (uint32)envelope->duty[top->position] * top->intensity
+                * PWM_PERIOD / (255 * 255) );
+        }
+
+        if ( compare != motorCompare[motor] )
+        {
+            writeMotor( motor, compare );
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: writeMotor
+********************************************************************************
+* Summary:
+*   Write a compare value to one motor's PWM.
+*******************************************************************************/
+static void writeMotor( uint8 motor, uint8 compare )
+{
+    switch ( motor )
+    {
+        case 0:
+            PWM_1_WriteCompare1( compare );
+            break;
+        case 1:
+            PWM_1_WriteCompare2( compare );
+            break;
+        default:
+            PWM_2_WriteCompare( compare );
+            break;
+    }
+    motorCompare[motor] = compare;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,104 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    haptic.h
+* Version: 1.0.0
+*
+* Brief: Haptic pattern engine. Plays duty cycle envelopes from flash into
+*        the motor PWM compare registers.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*   PWM_1
+*   PWM_2
+*
+* Notes:
+*   hapticTickHook() runs from the RTOS tick (1 ms) and steps every playing
+*   envelope, so callers only select patterns. Each motor has one layer per
+*   priority; all layers keep time, and the highest priority layer playing
+*   drives the motor. When it finishes or is stopped the layer below shows
+*   through in phase, e.g. a navigation double tap over obstacle pulses.
+*   Envelope values are duty 0..255, scaled by the layer's intensity.
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <project.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+// Number of belt motors (PWM_1 compare 1, PWM_1 compare 2, PWM_2).
+#define HAPTIC_MOTORS       3
+
+// Mask selecting every motor.
+#define HAPTIC_ALL_MOTORS   ((1u << HAPTIC_MOTORS) - 1)
+
+/*******************************************************************************
+*   Enumerations
+*******************************************************************************/
+// Built in envelopes.
+typedef enum hapticPattern{
+    HAPTIC_CONSTANT = 0,    // steady full duty
+    HAPTIC_PULSE_SLOW,      // 200 ms on, 200 ms off
+    HAPTIC_PULSE_FAST,      // 80 ms on, 80 ms off
+    HAPTIC_RAMP_UP,         // 0 to full over 400 ms
+    HAPTIC_RAMP_DOWN,       // full to 0 over 400 ms
+    HAPTIC_DOUBLE_TAP,      // two 60 ms taps
+    HAPTIC_PATTERN_COUNT
+} hapticPattern;
+
+// Layers, a higher priority overrides a lower one on the same motor.
+typedef enum hapticPriority{
+    HAPTIC_PRIO_OBSTACLE = 0,   // obstacle urgency
+    HAPTIC_PRIO_CUE,            // navigation cues
+    HAPTIC_PRIO_ALERT,          // system alerts
+    HAPTIC_PRIORITIES
+} hapticPriority;
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Clear every layer and turn the motors off.
+// Param: none.
+// Return: none.
+void hapticStart( void );
+
+// Brief: Play a pattern on a motor layer, replacing what the layer played.
+//        Replaying the pattern already looping on a layer only changes the
+//        intensity, so it can be called on every sample without restarting.
+// Param: motors Mask of motors (bit n = motor n), pattern Envelope,
+//        priority Layer, intensity Scale 0..255, loop Repeat until stopped.
+// Return: none.
+void hapticPlay( uint8 motors, hapticPattern pattern, hapticPriority priority,
+                 uint8 intensity, uint8 loop );
+
+// Brief: Stop a motor layer.
+// Param: motors Mask of motors, priority Layer.
+// Return: none.
+void hapticStop( uint8 motors, hapticPriority priority );
+
+// Brief: Whether a pattern plays or a motor is on (needs hapticTickHook()).
+// Param: none.
+// Return: 1 while busy.
+uint8 hapticBusy( void );
+
+// Brief: Total motor drive now, for load estimates.
+// Param: none.
+// Return: sum of duty cycles (0 .. 100 * HAPTIC_MOTORS %).
+uint16 hapticDrive( void );
+
+// Brief: Envelope player, call once per RTOS tick (vApplicationTickHook).
+// Param: none.
+// Return: none.
+void hapticTickHook( void );
+
+/* [] END OF FILE */
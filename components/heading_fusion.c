@@ -0,0 +1,419 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     heading_fusion.c
+* Version:  1.0.0
+*
+* Brief: Heading fusion: compass heading blended with GPS course over ground
+*        while walking, the compass down-weighted in magnetic disturbances.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "heading_fusion.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* Longest time between compass samples counted (ms) */
+#define COMPASS_GAP_MS      2000
+
+/* Fused heading resolution, 1/16 ddeg */
+#define FUSED_SCALE         16
+#define FUSED_TURN          ( 3600 * FUSED_SCALE )
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+static uint8_t  gb_started = 0;         // a compass sample or course has arrived
+static int32_t  g_fused = 0;            // fused heading, ddeg * FUSED_SCALE
+static int32_t  g_bias = 0;             // compass bias, ddeg * FUSED_SCALE
+static int32_t  g_compass = 0;          // last compass heading
+static uint32_t g_compass_time = 0;
+static int32_t  g_reference = 0;        // field magnitude expected (nT), 0 = none yet
+static uint32_t g_clear_since = 0;      // last time the field was out of range
+
+/* Last course used, and the fused heading right after it */
+static uint8_t  gb_coursed = 0;
+static uint32_t g_course_time = 0;
+static int32_t  g_course_fused = 0;
+
+static headingStats g_stats = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+/*******************************************************************************
+*   Private Function Declarations
+*******************************************************************************/
+// Brief: Difference of two headings.
+// Param: ddeg Difference, any value.
+// Return: int32_t Difference, -1800 .. 1799.
+static int32_t wrapDifference(int32_t ddeg);
+
+// Brief: Heading in range.
+// Param: ddeg Heading, any value.
+// Return: int32_t Heading, 0 .. 3599.
+static int32_t wrapHeading(int32_t ddeg);
+
+// Brief: Move the fused heading towards a heading.
+// Param: ddeg Heading, num, den Fraction of the way.
+// Return: none
+static void pull(int32_t ddeg, uint32_t num, uint32_t den);
+
+/*******************************************************************************
+* Function Name: headingReset
+********************************************************************************
+* Summary:
+*    Back to the state at power up.
+*******************************************************************************/
+void headingReset(void)
+{
+    headingRestart();
+    g_bias = 0;
+    g_stats.biasDdeg     = 0;
+    g_stats.courses      = 0;
+    g_stats.calibrations = 0;
+    g_stats.disturbances = 0;
+    g_stats.disturbedMs  = 0;
+}
+
+/*******************************************************************************
+* Function Name: headingRestart
+********************************************************************************
+* Summary:
+*    A new walk, maybe somewhere else: the heading and the field reference
+*    start again from the first sample. The bias is the user's and the
+*    declination's, so it is kept.
+*******************************************************************************/
+void headingRestart(void)
+{
+    gb_started  = 0;
+    gb_coursed  = 0;
+    g_reference = 0;
+    g_stats.disturbed = 0;
+}
+
+/*******************************************************************************
+* Function Name: headingCompass
+********************************************************************************
+* Summary:
+*    Checks the field magnitude against the reference and updates the
+*    disturbance, then pulls the fused heading towards compass plus bias by
+*    dt / (tau + dt), the first order filter step for the time since the
+*    last sample.
+*******************************************************************************/
+int16_t headingCompass(int16_t heading_ddeg, uint32_t field_nt, uint32_t now_ms)
+{
+    uint32_t dt = now_ms - g_compass_time;
+    uint32_t deviation;
+    uint32_t tau;
+
+    if (!gb_started || dt > COMPASS_GAP_MS)
+    {
+        dt = gb_started ? COMPASS_GAP_MS : 0;
+    }
+    g_compass      = heading_ddeg;
+    g_compass_time = now_ms;
+
+    /* Disturbance */
+    if (0 == g_reference)
+    {
+        g_reference = (int32_t)field_nt;
+    }
+    deviation = (field_nt > (uint32_t)g_reference) ? field_nt - (uint32_t)g_reference
+                                                  : (uint32_t)g_reference - field_nt;
+    if ((uint64_t)deviation * 100u > (uint64_t)g_reference * HEADING_FIELD_PCT)
+    {
+        if (!g_stats.disturbed)
+        {
+            g_stats.disturbances++;
+        }
+        g_stats.disturbed = 1;
+        g_clear_since = now_ms;
+    }
+    else if (g_stats.disturbed && now_ms - g_clear_since >= HEADING_SETTLE_MS)
+    {
+        g_stats.disturbed = 0;
+    }
+
+    if (g_stats.disturbed)
+    {
+        g_reference += ((int32_t)field_nt - g_reference) / 1024;
+        g_stats.disturbedMs += dt;
+        tau = HEADING_DISTURBED_TAU_MS;
+    }
+    else
+    {
+        g_reference += ((int32_t)field_nt - g_reference) / 64;
+        tau = HEADING_COMPASS_TAU_MS;
+    }
+    g_stats.fieldNt     = field_nt;
+    g_stats.referenceNt = (uint32_t)g_reference;
+
+    /* Heading */
+    if (!gb_started)
+    {
+        g_fused = wrapHeading(heading_ddeg + g_stats.biasDdeg) * FUSED_SCALE;
+        gb_started = 1;
+    }
+    else
+    {
+        pull(heading_ddeg + g_stats.biasDdeg, dt, tau + dt);
+    }
+    return headingNow();
+}
+
+/*******************************************************************************
+* Function Name: headingCourse
+********************************************************************************
+* Summary:
+*    Ignores courses too slow to mean anything. A straight walk since the
+*    last course in a clean field, with a recent compass sample, calibrates
+*    the bias; then the fused heading moves towards the course.
+*******************************************************************************/
+uint8_t headingCourse(int16_t course_ddeg, uint32_t speed_mms, uint32_t now_ms)
+{
+    if (speed_mms < HEADING_COURSE_MMS)
+    {
+        return 0;
+    }
+
+    if (!gb_started)
+    {
+        g_fused = wrapHeading(course_ddeg) * FUSED_SCALE;
+        gb_started = 1;
+    }
+    else
+    {
+        if (!g_stats.disturbed && gb_coursed &&
+            now_ms - g_course_time <= HEADING_COURSE_GAP_MS &&
+            now_ms - g_compass_time <= HEADING_COURSE_GAP_MS)
+        {
+            int32_t turn = wrapDifference((g_fused - g_course_fused) / FUSED_SCALE);
+            if (turn <= HEADING_STRAIGHT_DDEG && turn >= -HEADING_STRAIGHT_DDEG)
+            {
+                g_bias += wrapDifference(course_ddeg - g_compass - g_stats.biasDdeg) * FUSED_SCALE / 32;
+                g_bias  = wrapDifference(g_bias / FUSED_SCALE) * FUSED_SCALE + g_bias % FUSED_SCALE;
+                g_stats.biasDdeg = g_bias / FUSED_SCALE;
+                g_stats.calibrations++;
+            }
+        }
+        pull(course_ddeg, 1, g_stats.disturbed ? 2 : 4);
+    }
+
+    gb_coursed     = 1;
+    g_course_time  = now_ms;
+    g_course_fused = g_fused;
+    g_stats.courses++;
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: headingNow
+********************************************************************************
+* Summary:
+*    Fused heading, rounded.
+*******************************************************************************/
+int16_t headingNow(void)
+{
+    return (int16_t)wrapHeading((g_fused + FUSED_SCALE / 2) / FUSED_SCALE);
+}
+
+/*******************************************************************************
+* Function Name: headingGetStats
+********************************************************************************
+* Summary:
+*    Copies the counters.
+*******************************************************************************/
+void headingGetStats(headingStats *p_stats)
+{
+    *p_stats = g_stats;
+}
+
+/*******************************************************************************
+* Function Name: wrapDifference
+********************************************************************************
+* Summary:
+*    Folds into half a turn either way.
+*******************************************************************************/
+static int32_t wrapDifference(int32_t ddeg)
+{
+    ddeg %= 3600;
+    if (ddeg >= 1800)   ddeg -= 3600;
+    if (ddeg < -1800)   ddeg += 3600;
+    return ddeg;
+}
+
+/*******************************************************************************
+* Function Name: wrapHeading
+********************************************************************************
+* Summary:
+*    Folds into one turn.
+*******************************************************************************/
+static int32_t wrapHeading(int32_t ddeg)
+{
+    ddeg %= 3600;
+    if (ddeg < 0)
+    {
+        ddeg += 3600;
+    }
+    return ddeg;
+}
+
+/*******************************************************************************
+* Function Name: pull
+********************************************************************************
+* Summary:
+*    Moves num / den of the shorter way round, at the fused resolution.
+*******************************************************************************/
+static void pull(int32_t ddeg, uint32_t num, uint32_t den)
+{
+    int32_t difference = (wrapHeading(ddeg) * FUSED_SCALE - g_fused) % FUSED_TURN;
+
+    if (difference >= FUSED_TURN / 2)   difference -= FUSED_TURN;
+    if (difference < -FUSED_TURN / 2)   difference += FUSED_TURN;
+
+    g_fused += (int32_t)((int64_t)difference * num / den);
+    if (g_fused < 0)             g_fused += FUSED_TURN;
+    if (g_fused >= FUSED_TURN)   g_fused -= FUSED_TURN;
+}
+
+#if HEADING_HOST == 1
+/*******************************************************************************
+* Function Name: headingSimulate
+********************************************************************************
+* Summary:
+*    The user walks a square at 1.3 m/s, 40 s per side, turning over 2 s at
+*    the corners and stopping 10 s at every second one. The compass reads
+*    the true heading less 11.5 degrees (declination) with +-3 degrees of
+*    noise. Every 30 s the user passes a 6 s disturbance that bends the
+*    compass by up to 20 .. 60 degrees, either way, and moves the 55000 nT
+*    field by half as many percent as degrees. Courses arrive every second
+*    with +-5 degrees of noise; standing they are 0.1 m/s in any direction.
+*    A swing is the error growing past 30 degrees, a cue pointing the user
+*    noticeably wrong. The compass alone is the heading used before fusion.
+*******************************************************************************/
+void headingSimulate(uint32_t duration_ms, headingSimResult *p_result)
+{
+    const uint32_t side_ms = 42000u;
+    const uint32_t walk_ms = 40000u;
+    uint32_t seed = 3;
+    uint32_t now;
+    uint32_t phase;
+    uint32_t corner;
+    int32_t  truth;
+    int32_t  bend;
+    int32_t  amplitude = 0;
+    int32_t  compass;
+    int32_t  error;
+    uint32_t field;
+    uint8_t  walking;
+    uint8_t  zone;
+    uint8_t  compass_out = 0;
+    uint8_t  fused_out = 0;
+    uint64_t compass_sum = 0;
+    uint64_t fused_sum = 0;
+    uint32_t samples = 0;
+    uint32_t zone_samples = 0;
+    uint32_t zone_flagged = 0;
+    uint32_t clean_flagged = 0;
+    headingStats stats;
+
+    p_result->compassSwings = 0;
+    p_result->fusedSwings   = 0;
+
+    headingReset();
+
+    for (now = 0; now < duration_ms; now += 250u)
+    {
+        /* Truth: sides, 2 s turns, a stop at every second corner */
+        corner  = now / side_ms;
+        phase   = now % side_ms;
+        walking = (phase < walk_ms) && !((corner % 2u) && phase < 10000u);
+        truth   = (int32_t)(corner * 900u);
+        if (phase >= walk_ms)
+        {
+            truth += (int32_t)((phase - walk_ms) * 900u / (side_ms - walk_ms));
+        }
+        truth = wrapHeading(truth);
+
+        /* Disturbance: a triangle 6 s wide every 30 s */
+        phase = now % 30000u;
+        zone  = (phase >= 10000u && phase < 16000u);
+        if (phase == 10000u)
+        {
+            seed = seed * 1103515245u + 12345u;
+            amplitude = 200 + (int32_t)((seed >> 16) % 401u);
+            if ((seed >> 27) & 1u)
+            {
+                amplitude = -amplitude;
+            }
+        }
+        bend = zone ? amplitude * (int32_t)(3000u - ((phase > 13000u) ? phase - 13000u : 13000u - phase)) / 3000
+                    : 0;
+        field = (uint32_t)(55000 + 55000 * (bend < 0 ? -bend : bend) / 2000);
+
+        seed = seed * 1103515245u + 12345u;
+        compass = wrapHeading(truth - 115 + bend + (int32_t)((seed >> 16) % 61u) - 30);
+        headingCompass((int16_t)compass, field, now);
+
+        if (0 == now % 1000u)
+        {
+            seed = seed * 1103515245u + 12345u;
+            if (walking)
+            {
+                headingCourse((int16_t)wrapHeading(truth + (int32_t)((seed >> 16) % 101u) - 50), 1300u, now);
+            }
+            else
+            {
+                headingCourse((int16_t)((seed >> 16) % 3600u), 100u, now);
+            }
+        }
+
+        /* Errors after the first minute, once the bias is learned */
+        if (now < 60000u)
+        {
+            continue;
+        }
+        error = wrapDifference(compass - truth);
+        error = error < 0 ? -error : error;
+        compass_sum += (uint32_t)error;
+        if (error > 300 && !compass_out)    p_result->compassSwings++;
+        compass_out = (error > 300);
+
+        error = wrapDifference(headingNow() - truth);
+        error = error < 0 ? -error : error;
+        fused_sum += (uint32_t)error;
+        if (error > 300 && !fused_out)      p_result->fusedSwings++;
+        fused_out = (error > 300);
+
+        headingGetStats(&stats);
+        if ((bend < 0 ? -bend : bend) * 100 / 2000 > HEADING_FIELD_PCT)
+        {
+            zone_samples++;
+            zone_flagged += stats.disturbed;
+        }
+        else if (!zone)
+        {
+            clean_flagged += stats.disturbed;
+        }
+        samples++;
+    }
+
+    headingGetStats(&stats);
+    p_result->compassErrorDdeg = samples ? (uint32_t)(compass_sum / samples) : 0;
+    p_result->fusedErrorDdeg   = samples ? (uint32_t)(fused_sum / samples) : 0;
+    p_result->detectedPct      = zone_samples ? zone_flagged * 100u / zone_samples : 0;
+    p_result->falsePct         = samples ? clean_flagged * 100u / samples : 0;
+    p_result->biasDdeg         = stats.biasDdeg;
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,151 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     heading_fusion.h
+* Version:  1.0.0
+*
+* Brief: Heading fusion: compass heading blended with GPS course over ground
+*        while walking, the compass down-weighted in magnetic disturbances.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    Headings are tenths of a degree clockwise from north, 0 .. 3599.
+*
+*    Compass: each sample, plus the learned bias, pulls the fused heading
+*    with time constant HEADING_COMPASS_TAU_MS, or HEADING_DISTURBED_TAU_MS
+*    in a disturbance, so turns are followed at once in a clean field and
+*    a bent field only drifts the heading slowly.
+*
+*    Disturbance: the magnetic field magnitude is compared with a reference,
+*    the slow average of it (starting from the first sample of the walk).
+*    Off by more than HEADING_FIELD_PCT is a disturbance (steel, cars,
+*    buildings), which lasts until the magnitude has been back in range for
+*    HEADING_SETTLE_MS. The reference follows the field 1/64 a sample, or
+*    1/1024 while disturbed so a walk started next to steel still recovers.
+*
+*    Course: an RMC course at HEADING_COURSE_MMS or faster pulls the fused
+*    heading 1/4 of the way (1/2 in a disturbance). On a straight walk in
+*    a clean field it also moves the compass bias 1/32 of the way towards
+*    course less compass, which learns the magnetic declination and how
+*    the device is worn. Slower courses are noise and are ignored.
+*
+*    Only depends on <stdint.h>. Build with HEADING_HOST = 1 to add a
+*    simulated walk through disturbances on the host.
+*
+*******************************************************************************/
+#ifndef HEADING_FUSION_H
+	#define HEADING_FUSION_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+    #ifndef HEADING_HOST
+        #define HEADING_HOST 0
+    #endif
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* Compass time constant, clean field and disturbed (ms) */
+    #define HEADING_COMPASS_TAU_MS      250
+    #define HEADING_DISTURBED_TAU_MS    8000
+
+    /* Field magnitude change that is a disturbance (%), and time back in
+       range before the compass is trusted again (ms) */
+    #define HEADING_FIELD_PCT           12
+    #define HEADING_SETTLE_MS           2000
+
+    /* Slowest course used (mm/s), a slow walk is about 800 */
+    #define HEADING_COURSE_MMS          600
+
+    /* Largest heading change between courses that is a straight walk */
+    #define HEADING_STRAIGHT_DDEG       150
+
+    /* Longest gap between courses that are compared (ms) */
+    #define HEADING_COURSE_GAP_MS       3000
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+    // Fusion counters.
+    typedef struct headingStats{
+        int32_t  biasDdeg;              // compass bias learned
+        uint32_t fieldNt;               // field magnitude, last sample
+        uint32_t referenceNt;           // field magnitude expected
+        uint32_t courses;               // courses used
+        uint32_t calibrations;          // courses that moved the bias
+        uint32_t disturbances;          // disturbances seen
+        uint32_t disturbedMs;           // time disturbed
+        uint8_t  disturbed;             // disturbed now
+    } headingStats;
+
+    #if HEADING_HOST == 1
+        // Result of a simulated walk.
+        typedef struct headingSimResult{
+            uint32_t compassErrorDdeg;  // mean error, compass alone
+            uint32_t fusedErrorDdeg;    // mean error, fused
+            uint32_t compassSwings;     // false heading jumps, compass alone
+            uint32_t fusedSwings;       // false heading jumps, fused
+            uint32_t detectedPct;       // disturbed time flagged (%)
+            uint32_t falsePct;          // clean time flagged (%)
+            int32_t  biasDdeg;          // bias learned at the end
+        } headingSimResult;
+    #endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    // Brief: Forget the heading, bias and field reference.
+    // Param: none.
+    // Return: none
+    void headingReset(void);
+
+    // Brief: Forget the heading and field reference for a new walk, keep
+    //        the bias.
+    // Param: none.
+    // Return: none
+    void headingRestart(void);
+
+    // Brief: Add a compass sample.
+    // Param: heading_ddeg Compass heading, field_nt Field magnitude,
+    //        now_ms Time.
+    // Return: int16_t Fused heading.
+    int16_t headingCompass(int16_t heading_ddeg, uint32_t field_nt, uint32_t now_ms);
+
+    // Brief: Add a GPS course over ground.
+    // Param: course_ddeg Course, speed_mms Speed over ground, now_ms Time.
+    // Return: uint8_t 1 if used.
+    uint8_t headingCourse(int16_t course_ddeg, uint32_t speed_mms, uint32_t now_ms);
+
+    // Brief: Fused heading.
+    // Param: none.
+    // Return: int16_t Heading.
+    int16_t headingNow(void);
+
+    // Brief: Copy the counters.
+    // Param: p_stats Filled with the counters.
+    // Return: none
+    void headingGetStats(headingStats *p_stats);
+
+    #if HEADING_HOST == 1
+        // Brief: Walk a square with stops past disturbances that bend the
+        //        compass and change the field, compass at 4 Hz, courses at
+        //        1 Hz.
+        // Param: duration_ms Simulated time, p_result Statistics of the run.
+        // Return: none
+        void headingSimulate(uint32_t duration_ms, headingSimResult *p_result);
+    #endif
+
+#endif
+
+/* [] END OF FILE */
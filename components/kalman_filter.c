@@ -0,0 +1,508 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     kalman_filter.c
+* Version:  1.0.0
+*
+* Brief: Constant velocity Kalman filter smoothing GPS fixes: position and
+*        velocity east and north, fix noise from HDOP, prediction to any
+*        time.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Source:
+*    Process noise from Y. Bar-Shalom, X. R. Li, T. Kirubarajan, "Estimation
+*    with Applications to Tracking and Navigation", section 6.2.2
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "kalman_filter.h"
+
+#if KALMAN_HOST == 1
+    #include <time.h>
+#endif
+
+/*******************************************************************************
+*   Type definitions
+*******************************************************************************/
+/* One axis: position (m), velocity (m/s) and their covariance */
+typedef struct kalmanAxis{
+    float pos;
+    float vel;
+    float pp;                           // position variance
+    float pv;                           // position velocity covariance
+    float vv;                           // velocity variance
+} kalmanAxis;
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+static kalmanAxis g_east;
+static kalmanAxis g_north;
+static uint8_t  gb_started = 0;         // a fix has started the filter
+static uint32_t g_time = 0;             // time of the state
+static uint8_t  g_rejects = 0;          // rejects in a row
+
+static kalmanStats g_stats = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+/*******************************************************************************
+*   Private Function Declarations
+*******************************************************************************/
+// Brief: Start an axis at a fix.
+// Param: p_axis Axis, pos Fix (m), var Fix variance.
+// Return: none
+static void axisStart(kalmanAxis *p_axis, float pos, float var);
+
+// Brief: Move an axis forward in time.
+// Param: p_axis Axis, dt Time (s).
+// Return: none
+static void axisPredict(kalmanAxis *p_axis, float dt);
+
+// Brief: Correct an axis with a fix.
+// Param: p_axis Axis, innovation Fix less position (m), var Fix variance.
+// Return: none
+static void axisCorrect(kalmanAxis *p_axis, float innovation, float var);
+
+// Brief: Square root, rounded to mm.
+// Param: square Value (m^2).
+// Return: uint32_t Root (mm).
+static uint32_t rootMm(float square);
+
+// Brief: Length of a vector, rounded to mm.
+// Param: east_m, north_m Vector (m).
+// Return: uint32_t Length (mm).
+static uint32_t lengthMm(float east_m, float north_m);
+
+/*******************************************************************************
+* Function Name: kalmanReset
+********************************************************************************
+* Summary:
+*    Forgets the state and the counters.
+*******************************************************************************/
+void kalmanReset(void)
+{
+    gb_started = 0;
+    g_rejects  = 0;
+    g_stats.fixes         = 0;
+    g_stats.rejects       = 0;
+    g_stats.restarts      = 0;
+    g_stats.innovationMm  = 0;
+    g_stats.sigmaMm       = 0;
+    g_stats.speedMms      = 0;
+    g_stats.worstUpdateUs = 0;
+}
+
+/*******************************************************************************
+* Function Name: kalmanUpdate
+********************************************************************************
+* Summary:
+*    Predicts the state to the fix time, then gates the innovation against
+*    its covariance, S = P + R on each axis. A fix inside the gate corrects
+*    both axes; one outside only leaves the prediction, until KALMAN_MAX_
+*    REJECTS in a row start the filter over at the fix.
+*******************************************************************************/
+uint8_t kalmanUpdate(int32_t east_mm, int32_t north_mm, uint16_t hdop_x10, uint32_t now_ms)
+{
+    float east = (float)east_mm / 1000.0f;
+    float north = (float)north_mm / 1000.0f;
+    float sigma;
+    float var;
+    float d_east;
+    float d_north;
+    float gate;
+
+    if (0 == hdop_x10)
+    {
+        hdop_x10 = KALMAN_HDOP_DEFAULT;
+    }
+    sigma = (float)hdop_x10 * (KALMAN_UERE_M / 10.0f);
+    var = sigma * sigma;
+    g_stats.fixes++;
+
+    if (!gb_started || g_rejects >= KALMAN_MAX_REJECTS)
+    {
+        if (gb_started)
+        {
+            g_stats.restarts++;
+        }
+        axisStart(&g_east, east, var);
+        axisStart(&g_north, north, var);
+        gb_started = 1;
+        g_rejects  = 0;
+        g_time     = now_ms;
+        g_stats.innovationMm = 0;
+        g_stats.sigmaMm  = (uint32_t)(sigma * 1000.0f);
+        g_stats.speedMms = 0;
+        return 1;
+    }
+
+    axisPredict(&g_east, (float)(now_ms - g_time) / 1000.0f);
+    axisPredict(&g_north, (float)(now_ms - g_time) / 1000.0f);
+    g_time = now_ms;
+
+    d_east  = east - g_east.pos;
+    d_north = north - g_north.pos;
+    g_stats.innovationMm = lengthMm(d_east, d_north);
+
+    gate = d_east * d_east / (g_east.pp + var) + d_north * d_north / (g_north.pp + var);
+    if (gate > KALMAN_GATE)
+    {
+        g_rejects++;
+        g_stats.rejects++;
+        return 0;
+    }
+
+    axisCorrect(&g_east, d_east, var);
+    axisCorrect(&g_north, d_north, var);
+    g_rejects = 0;
+    g_stats.sigmaMm  = rootMm(g_east.pp + g_north.pp);
+    g_stats.speedMms = lengthMm(g_east.vel, g_north.vel);
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: kalmanPredict
+********************************************************************************
+* Summary:
+*    Position at the state time plus velocity times the time since. The
+*    state is not changed, so any task may ask for any time.
+*******************************************************************************/
+uint8_t kalmanPredict(uint32_t now_ms, int32_t *p_east_mm, int32_t *p_north_mm)
+{
+    float dt = (float)(int32_t)(now_ms - g_time) / 1000.0f;
+
+    if (!gb_started)
+    {
+        *p_east_mm  = 0;
+        *p_north_mm = 0;
+        return 0;
+    }
+
+    *p_east_mm  = (int32_t)((g_east.pos + g_east.vel * dt) * 1000.0f);
+    *p_north_mm = (int32_t)((g_north.pos + g_north.vel * dt) * 1000.0f);
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: kalmanUpdateTime
+********************************************************************************
+* Summary:
+*    Keeps the last and worst update time.
+*******************************************************************************/
+void kalmanUpdateTime(uint32_t us)
+{
+    g_stats.updateUs = us;
+    if (us > g_stats.worstUpdateUs)
+    {
+        g_stats.worstUpdateUs = us;
+    }
+}
+
+/*******************************************************************************
+* Function Name: kalmanGetStats
+********************************************************************************
+* Summary:
+*    Copies the counters.
+*******************************************************************************/
+void kalmanGetStats(kalmanStats *p_stats)
+{
+    *p_stats = g_stats;
+}
+
+/*******************************************************************************
+* Function Name: axisStart
+********************************************************************************
+* Summary:
+*    Position at the fix, standing still, velocity unknown to KALMAN_SPEED_
+*    SIGMA.
+*******************************************************************************/
+static void axisStart(kalmanAxis *p_axis, float pos, float var)
+{
+    p_axis->pos = pos;
+    p_axis->vel = 0.0f;
+    p_axis->pp  = var;
+    p_axis->pv  = 0.0f;
+    p_axis->vv  = KALMAN_SPEED_SIGMA * KALMAN_SPEED_SIGMA;
+}
+
+/*******************************************************************************
+* Function Name: axisPredict
+********************************************************************************
+* Summary:
+*    x = F x, P = F P F' + Q with F = [1 dt; 0 1] and, for white noise
+*    acceleration of density q, Q = q [dt^3/3 dt^2/2; dt^2/2 dt].
+*******************************************************************************/
+static void axisPredict(kalmanAxis *p_axis, float dt)
+{
+    float q = KALMAN_ACCEL_NOISE * dt;
+
+    p_axis->pos += p_axis->vel * dt;
+    p_axis->pp  += dt * (2.0f * p_axis->pv + dt * p_axis->vv) + q * dt * dt / 3.0f;
+    p_axis->pv  += dt * p_axis->vv + q * dt / 2.0f;
+    p_axis->vv  += q;
+}
+
+/*******************************************************************************
+* Function Name: axisCorrect
+********************************************************************************
+* Summary:
+*    Gain K = P H' / S with H = [1 0] and S = pp + R, then x += K y and
+*    P = (I - K H) P.
+*******************************************************************************/
+static void axisCorrect(kalmanAxis *p_axis, float innovation, float var)
+{
+    float s = p_axis->pp + var;
+    float k_pos = p_axis->pp / s;
+    float k_vel = p_axis->pv / s;
+
+    p_axis->pos += k_pos * innovation;
+    p_axis->vel += k_vel * innovation;
+    p_axis->vv  -= k_vel * p_axis->pv;
+    p_axis->pv  -= k_pos * p_axis->pv;
+    p_axis->pp  -= k_pos * p_axis->pp;
+}
+
+/*******************************************************************************
+* Function Name: rootMm
+********************************************************************************
+* Summary:
+*    Bit by bit square root of the value in mm^2.
+*******************************************************************************/
+static uint32_t rootMm(float square)
+{
+    uint64_t x;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    if (square <= 0.0f)
+    {
+        return 0;
+    }
+    x = (uint64_t)(square * 1000000.0f);
+
+    while (bit > x)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (x >= root + bit)
+        {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+/*******************************************************************************
+* Function Name: lengthMm
+********************************************************************************
+* Summary:
+*    Root of the sum of squares.
+*******************************************************************************/
+static uint32_t lengthMm(float east_m, float north_m)
+{
+    return rootMm(east_m * east_m + north_m * north_m);
+}
+
+#if KALMAN_HOST == 1
+/*******************************************************************************
+*   Replay definitions
+*******************************************************************************/
+#define REPLAY_FIXES    3600
+
+typedef struct replayFix{
+    uint32_t timeMs;
+    int32_t  eastMm;
+    int32_t  northMm;
+    uint16_t hdopX10;
+    int32_t  trueEastMm;
+    int32_t  trueNorthMm;
+    uint8_t  standing;
+} replayFix;
+
+static replayFix g_replay[REPLAY_FIXES];
+
+/*******************************************************************************
+* Function Name: replayNoise
+********************************************************************************
+* Summary:
+*    Near gaussian noise of a given sigma, the sum of four uniforms from a
+*    linear congruential generator.
+*******************************************************************************/
+static int32_t replayNoise(uint32_t *p_seed, uint32_t sigma_mm)
+{
+    int32_t sum = 0;
+    uint8_t i;
+
+    for (i = 0; i < 4; i++)
+    {
+        *p_seed = *p_seed * 1103515245u + 12345u;
+        sum += (int32_t)((*p_seed >> 16) % 2001u) - 1000;
+    }
+    /* Each uniform has sigma 1000 / sqrt(3), four add to 1155 */
+    return (int32_t)((int64_t)sum * sigma_mm / 1155);
+}
+
+/*******************************************************************************
+* Function Name: kalmanReplay
+********************************************************************************
+* Summary:
+*    Records the walk of deadReckonSimulate(): a 35 m square at 1.4 m/s with
+*    a 10 s stop at each corner. HDOP swings between 0.8 and 3.0 over 100 s.
+*    Each fix is the truth plus a slow bias (a random walk held within 2 m,
+*    which no filter can see) and white noise of HDOP * 1.5 m per axis; 1 %
+*    of fixes jump 25 m (multipath).
+*
+*    The replay is run once for the errors, measured at the fix times, then
+*    repeats times timed with clock() for the update cost, and as many
+*    predictions at a time between fixes for the prediction cost.
+*******************************************************************************/
+void kalmanReplay(uint32_t fixes, uint32_t fix_ms, uint32_t repeats,
+    kalmanReplayResult *p_result)
+{
+    const uint32_t side_ms = 35000u;
+    const uint32_t walk_ms = 25000u;
+    uint32_t seed = 7;
+    uint32_t i;
+    uint32_t r;
+    uint32_t now;
+    uint32_t phase;
+    int32_t  bias_east = 0;
+    int32_t  bias_north = 0;
+    int32_t  east;
+    int32_t  north;
+    int32_t  last_east = 0;
+    int32_t  last_north = 0;
+    int32_t  last_raw_east = 0;
+    int32_t  last_raw_north = 0;
+    int32_t  along;
+    uint32_t standing = 0;
+    uint64_t raw_sum = 0;
+    uint64_t filtered_sum = 0;
+    uint64_t raw_jump = 0;
+    uint64_t filtered_jump = 0;
+    volatile int32_t sink = 0;
+    clock_t  start;
+    kalmanStats stats;
+
+    if (fixes > REPLAY_FIXES)
+    {
+        fixes = REPLAY_FIXES;
+    }
+
+    /* Record */
+    for (i = 0; i < fixes; i++)
+    {
+        now   = i * fix_ms;
+        phase = now % side_ms;
+        along = (int32_t)(((phase < walk_ms) ? phase : walk_ms) * 1400u / 1000u);
+        switch ((now / side_ms) % 4u)
+        {
+            case 0:  east = along;           north = 0;               break;
+            case 1:  east = 35000;           north = along;           break;
+            case 2:  east = 35000 - along;   north = 35000;           break;
+            default: east = 0;               north = 35000 - along;   break;
+        }
+
+        phase = now % 100000u;
+        g_replay[i].hdopX10 = (uint16_t)(8u + ((phase < 50000u) ? phase : 100000u - phase) * 22u / 50000u);
+
+        bias_east  += replayNoise(&seed, 100);
+        bias_north += replayNoise(&seed, 100);
+        if (bias_east > 2000 || bias_east < -2000)      bias_east /= 2;
+        if (bias_north > 2000 || bias_north < -2000)    bias_north /= 2;
+
+        g_replay[i].timeMs      = now;
+        g_replay[i].trueEastMm  = east;
+        g_replay[i].trueNorthMm = north;
+        g_replay[i].standing    = ((now % side_ms) >= walk_ms);
+        g_replay[i].eastMm  = east + bias_east + replayNoise(&seed, g_replay[i].hdopX10 * 150u);
+        g_replay[i].northMm = north + bias_north + replayNoise(&seed, g_replay[i].hdopX10 * 150u);
+
+        seed = seed * 1103515245u + 12345u;
+        if ((seed >> 16) % 100u == 0)
+        {
+            g_replay[i].eastMm += 25000;
+        }
+    }
+
+    /* Errors */
+    kalmanReset();
+    for (i = 0; i < fixes; i++)
+    {
+        kalmanUpdate(g_replay[i].eastMm, g_replay[i].northMm, g_replay[i].hdopX10, g_replay[i].timeMs);
+        kalmanPredict(g_replay[i].timeMs, &east, &north);
+
+        raw_sum      += lengthMm((float)(g_replay[i].eastMm - g_replay[i].trueEastMm) / 1000.0f,
+                                 (float)(g_replay[i].northMm - g_replay[i].trueNorthMm) / 1000.0f);
+        filtered_sum += lengthMm((float)(east - g_replay[i].trueEastMm) / 1000.0f,
+                                 (float)(north - g_replay[i].trueNorthMm) / 1000.0f);
+
+        if (i > 0 && g_replay[i].standing && g_replay[i - 1].standing)
+        {
+            raw_jump      += lengthMm((float)(g_replay[i].eastMm - last_raw_east) / 1000.0f,
+                                      (float)(g_replay[i].northMm - last_raw_north) / 1000.0f);
+            filtered_jump += lengthMm((float)(east - last_east) / 1000.0f,
+                                      (float)(north - last_north) / 1000.0f);
+            standing++;
+        }
+        last_east      = east;
+        last_north     = north;
+        last_raw_east  = g_replay[i].eastMm;
+        last_raw_north = g_replay[i].northMm;
+    }
+
+    kalmanGetStats(&stats);
+    p_result->fixes           = fixes;
+    p_result->rejects         = stats.rejects;
+    p_result->rawErrorMm      = fixes ? (uint32_t)(raw_sum / fixes) : 0;
+    p_result->filteredErrorMm = fixes ? (uint32_t)(filtered_sum / fixes) : 0;
+    p_result->rawJumpMm       = standing ? (uint32_t)(raw_jump / standing) : 0;
+    p_result->filteredJumpMm  = standing ? (uint32_t)(filtered_jump / standing) : 0;
+
+    /* Update cost */
+    start = clock();
+    for (r = 0; r < repeats; r++)
+    {
+        kalmanReset();
+        for (i = 0; i < fixes; i++)
+        {
+            sink += kalmanUpdate(g_replay[i].eastMm, g_replay[i].northMm,
+                                 g_replay[i].hdopX10, g_replay[i].timeMs);
+        }
+    }
+    p_result->nsPerUpdate = (repeats > 0 && fixes > 0) ? (uint32_t)((double)(clock() - start) * 1e9
+                          / CLOCKS_PER_SEC / ((double)repeats * fixes)) : 0;
+
+    /* Prediction cost, half way to the next fix */
+    start = clock();
+    for (r = 0; r < repeats; r++)
+    {
+        for (i = 0; i < fixes; i++)
+        {
+            kalmanPredict(g_replay[i].timeMs + fix_ms / 2u, &east, &north);
+            sink += east;
+        }
+    }
+    p_result->nsPerPredict = (repeats > 0 && fixes > 0) ? (uint32_t)((double)(clock() - start) * 1e9
+                           / CLOCKS_PER_SEC / ((double)repeats * fixes)) : 0;
+    (void)sink;
+}
+#endif
+
+/* [] END OF FILE */
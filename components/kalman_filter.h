@@ -0,0 +1,146 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     kalman_filter.h
+* Version:  1.0.0
+*
+* Brief: Constant velocity Kalman filter smoothing GPS fixes: position and
+*        velocity east and north, fix noise from HDOP, prediction to any
+*        time.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    State: east, north (m) and their velocities (m/s), in the same local
+*    frame as dead_reckoning.h; positions in and out are mm. The velocity
+*    changes by white noise acceleration of spectral density
+*    KALMAN_ACCEL_NOISE. A fix measures position with standard deviation
+*    HDOP * KALMAN_UERE_M per axis.
+*
+*    With that model and a fix noise equal on both axes, east and north
+*    never correlate, so the 4 state filter runs as two 2 state filters
+*    with a 3 value covariance each: a few dozen float operations a fix.
+*
+*    A fix whose innovation is beyond KALMAN_GATE (chi square, 2 degrees of
+*    freedom, of the innovation against its covariance) is rejected as a
+*    jump. After KALMAN_MAX_REJECTS rejects in a row the filter starts over
+*    from the next fix, so it cannot lock out a real move.
+*
+*    Float on the Cortex-M3 is software emulated; the time of each update
+*    is kept in the counters by the caller. Only depends on <stdint.h>.
+*    Build with KALMAN_HOST = 1 to add a replay benchmark on the host.
+*
+*******************************************************************************/
+#ifndef KALMAN_FILTER_H
+	#define KALMAN_FILTER_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+    #ifndef KALMAN_HOST
+        #define KALMAN_HOST 0
+    #endif
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* User equivalent range error, fix sigma at HDOP 1 (m) */
+    #define KALMAN_UERE_M           3.0f
+
+    /* HDOP used when a fix has none (x10) */
+    #define KALMAN_HDOP_DEFAULT     50
+
+    /* White noise acceleration spectral density (m^2/s^3), a walking pace
+       changing by about 1 m/s over a few seconds */
+    #define KALMAN_ACCEL_NOISE      0.3f
+
+    /* Velocity sigma of the first fix (m/s) */
+    #define KALMAN_SPEED_SIGMA      1.5f
+
+    /* Innovation gate, chi square 2 dof (13.8 = 99.9 %) */
+    #define KALMAN_GATE             13.8f
+
+    /* Rejects in a row before starting over */
+    #define KALMAN_MAX_REJECTS      3
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+    // Filter counters.
+    typedef struct kalmanStats{
+        uint32_t fixes;                 // fixes given
+        uint32_t rejects;               // fixes rejected by the gate
+        uint32_t restarts;              // starts over after rejects in a row
+        uint32_t innovationMm;          // last fix to prediction distance
+        uint32_t sigmaMm;               // position sigma after the last fix
+        uint32_t speedMms;              // speed after the last fix (mm/s)
+        uint32_t updateUs;              // last update time, set by the caller
+        uint32_t worstUpdateUs;
+    } kalmanStats;
+
+    #if KALMAN_HOST == 1
+        // Result of a replay.
+        typedef struct kalmanReplayResult{
+            uint32_t fixes;
+            uint32_t rejects;
+            uint32_t rawErrorMm;        // mean fix to truth distance
+            uint32_t filteredErrorMm;   // mean filtered to truth distance
+            uint32_t rawJumpMm;         // mean fix to fix jump while standing
+            uint32_t filteredJumpMm;    // mean filtered jump while standing
+            uint32_t nsPerUpdate;       // host time per update
+            uint32_t nsPerPredict;      // host time per prediction
+        } kalmanReplayResult;
+    #endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    // Brief: Forget the state, the next fix starts the filter.
+    // Param: none.
+    // Return: none
+    void kalmanReset(void);
+
+    // Brief: Add a fix.
+    // Param: east_mm, north_mm Fix, hdop_x10 HDOP * 10 (0 = unknown),
+    //        now_ms Time of the fix.
+    // Return: uint8_t 1 if used, 0 if rejected by the gate.
+    uint8_t kalmanUpdate(int32_t east_mm, int32_t north_mm, uint16_t hdop_x10, uint32_t now_ms);
+
+    // Brief: Position at a time, from the last fix and velocity.
+    // Param: now_ms Time, p_east_mm, p_north_mm Filled with the position.
+    // Return: uint8_t 1 once there has been a fix.
+    uint8_t kalmanPredict(uint32_t now_ms, int32_t *p_east_mm, int32_t *p_north_mm);
+
+    // Brief: Record how long the last update took (measured by the caller).
+    // Param: us Time.
+    // Return: none
+    void kalmanUpdateTime(uint32_t us);
+
+    // Brief: Copy the counters.
+    // Param: p_stats Filled with the counters.
+    // Return: none
+    void kalmanGetStats(kalmanStats *p_stats);
+
+    #if KALMAN_HOST == 1
+        // Brief: Record a walk with stops and noisy fixes (varying HDOP,
+        //        some multipath jumps), then replay it through the filter,
+        //        timing the updates and predictions.
+        // Param: fixes Fixes to record (at most 3600), fix_ms Time between
+        //        fixes, repeats Replays timed, p_result Statistics.
+        // Return: none
+        void kalmanReplay(uint32_t fixes, uint32_t fix_ms, uint32_t repeats,
+            kalmanReplayResult *p_result);
+    #endif
+
+#endif
+
+/* [] END OF FILE */
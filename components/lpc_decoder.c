@@ -0,0 +1,907 @@
+/*******************************************************************************
+* Written by Jaroslav Groman, for PSoC Analog Coprocessor
+* https://www.hackster.io/jardag/touch-controlled-talking-clock-for-psoc-analog-coprocessor-98c5a0
+*
+* Modified by Maanika Kenneth Koththioda, for use on PSoC5LP (lpc_synth.c)
+*
+* Split out of lpc_synth.c after the original firmware
+* Created on 18/10/2026
+*
+* File:     lpc_decoder.c
+* Version:  1.0.0
+*
+* Brief: Hardware independent LPC bitstream decoder and lattice filter.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Source:
+*    LPC synth code adapted from https://github.com/going-digital/Talkie
+*
+*******************************************************************************/
+#include "lpc_decoder.h"
+#include "speech_store.h"
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+    #include <project.h>    /* CMSIS __SSAT */
+#endif
+
+/*******************************************************************************
+*   Macros
+*******************************************************************************/
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+    /* Saturate to a signed bits-wide value with the CMSIS SSAT intrinsic */
+    #define LPC_SSAT(value, bits)   ((int32_t)__SSAT((int32_t)(value), (bits)))
+#else
+    /* Portable equivalent of SSAT for host builds */
+    #define LPC_SSAT(value, bits) lpc_ssat((int32_t)(value), (bits))
+
+    static int32_t lpc_ssat(int32_t value, uint8_t bits)
+    {
+        const int32_t max = (1 << (bits - 1)) - 1;
+
+        if (value > max)
+        {
+            return max;
+        }
+        if (value < -max - 1)
+        {
+            return -max - 1;
+        }
+        return value;
+    }
+#endif
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+// Decoded parameters of one LPC frame.
+typedef struct lpc_frame_t{
+    uint16_t energy;
+    uint8_t  pitch;
+    int32_t  k[10];
+} lpc_frame_t;
+
+/*******************************************************************************
+*   Private Function Declarations
+*******************************************************************************/
+
+// Brief: Reset lattice filter, excitation and coefficient state.
+// Return: none
+static void reset_state(void);
+
+// Brief: Start playing the next frame once the current one has finished.
+// Return: none
+static void begin_frame(void);
+
+// Brief: Set current coefficients for the given position within the frame.
+// Param: position Sample position within the current frame.
+// Return: none
+static void interpolate(uint16_t position);
+
+// Brief: Generate the next excitation (voiced chirp or unvoiced noise) sample.
+// Return: int16_t Excitation sample u10.
+static int16_t next_excitation(void);
+
+// Brief: C reference lattice filter for a single sample.
+// Param: u10 Excitation sample.
+// Return: int16_t Filtered signed 9-bit sample.
+static int16_t lattice_reference(int16_t u10);
+
+// Brief: Block lattice filter kernel, filters samples in place.
+// Param: p_samples Excitation in, filtered samples out, count Block length.
+// Return: none
+static void lattice_block(int16_t *p_samples, uint16_t count);
+
+// Brief: Reverse bit order (LSB/MSB) in given byte.
+// Param: byte Byte to reverse bits from.
+// Return: uint8_t Byte with bit order reversed.
+static uint8_t reverse_bit_order(uint8_t byte);
+
+// Brief: Read given number of bits from LPC bitstream.
+// Param: bit_count Number of bits to read.
+// Return: uint8_t Binary value of read bits.
+static uint8_t get_bits(uint8_t bit_count);
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* LPC 'chirp' sample array */
+static const int8_t CHIRP[CHIRP_SIZE] =
+{
+    0x00, 0x2A, 0xD4, 0x32, 0xB2, 0x12, 0x25, 0x14,
+    0x02, 0xE1, 0xC5, 0x02, 0x5F, 0x5A, 0x05, 0x0F,
+    0x26, 0xFC, 0xA5, 0xA5, 0xD6, 0xDD, 0xDC, 0xFC,
+    0x25, 0x2B, 0x22, 0x21, 0x0F, 0xFF, 0xF8, 0xEE,
+    0xED, 0xEF, 0xF7, 0xF6, 0xFA, 0x00, 0x03, 0x02,
+    0x01
+};
+
+/* LPC energy lookup array */
+static const uint8_t ENERGY[0x10] =
+{
+    0x00, 0x02, 0x03, 0x04, 0x05, 0x07, 0x0A, 0x0F,
+    0x14, 0x20, 0x29, 0x39, 0x51, 0x72, 0xA1, 0xFF
+};
+
+/* LPC pitch lookup array */
+static const uint8_t PITCH[0x40] =
+{
+    0x00, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
+    0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E,
+    0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26,
+    0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2D, 0x2F, 0x31,
+    0x33, 0x35, 0x36, 0x39, 0x3B, 0x3D, 0x3F, 0x42,
+    0x45, 0x47, 0x49, 0x4D, 0x4F, 0x51, 0x55, 0x57,
+    0x5C, 0x5F, 0x63, 0x66, 0x6A, 0x6E, 0x73, 0x77,
+    0x7B, 0x80, 0x85, 0x8A, 0x8F, 0x95, 0x9A, 0xA0
+};
+
+/* LPC coefficient K1 lookup array */
+static const int16_t K1[0x20] =
+{
+    0x82C0, 0x8380, 0x83C0, 0x8440, 0x84C0, 0x8540, 0x8600, 0x8780,
+    0x8880, 0x8980, 0x8AC0, 0x8C00, 0x8D40, 0x8F00, 0x90C0, 0x92C0,
+    0x9900, 0xA140, 0xAB80, 0xB840, 0xC740, 0xD8C0, 0xEBC0, 0x0000,
+    0x1440, 0x2740, 0x38C0, 0x47C0, 0x5480, 0x5EC0, 0x6700, 0x6D40
+};
+
+/* LPC coefficient K2 lookup array */
+static const int16_t K2[0x20] =
+{
+    0xAE00, 0xB480, 0xBB80, 0xC340, 0xCB80, 0xD440, 0xDDC0, 0xE780,
+    0xF180, 0xFBC0, 0x0600, 0x1040, 0x1A40, 0x2400, 0x2D40, 0x3600,
+    0x3E40, 0x45C0, 0x4CC0, 0x5300, 0x5880, 0x5DC0, 0x6240, 0x6640,
+    0x69C0, 0x6CC0, 0x6F80, 0x71C0, 0x73C0, 0x7580, 0x7700, 0x7E80
+};
+
+/* LPC coefficient K3 lookup array */
+static const int8_t K3[0x10] =
+{
+    0x92, 0x9F, 0xAD, 0xBA, 0xC8, 0xD5, 0xE3, 0xF0,
+    0xFE, 0x0B, 0x19, 0x26, 0x34, 0x41, 0x4F, 0x5C
+};
+
+/* LPC coefficient K4 lookup array */
+static const int8_t K4[0x10] =
+{
+    0xAE, 0xBC, 0xCA, 0xD8, 0xE6, 0xF4, 0x01, 0x0F,
+    0x1D, 0x2B, 0x39, 0x47, 0x55, 0x63, 0x71, 0x7E
+};
+
+/* LPC coefficient K5 lookup array */
+static const int8_t K5[0x10] =
+{
+    0xAE, 0xBA, 0xC5, 0xD1, 0xDD, 0xE8, 0xF4, 0xFF,
+    0x0B, 0x17, 0x22, 0x2E, 0x39, 0x45, 0x51, 0x5C
+};
+
+/* LPC coefficient K6 lookup array */
+static const int8_t K6[0x10] =
+{
+    0xC0, 0xCB, 0xD6, 0xE1, 0xEC, 0xF7, 0x03, 0x0E,
+    0x19, 0x24, 0x2F, 0x3A, 0x45, 0x50, 0x5B, 0x66
+};
+
+/* LPC coefficient K7 lookup array */
+static const int8_t K7[0x10] =
+{
+    0xB3, 0xBF, 0xCB, 0xD7, 0xE3, 0xEF, 0xFB, 0x07,
+    0x13, 0x1F, 0x2B, 0x37, 0x43, 0x4F, 0x5A, 0x66
+};
+
+/* LPC coefficient K8 lookup array */
+static const int8_t K8[0x08] =
+{
+    0xC0, 0xD8, 0xF0, 0x07, 0x1F, 0x37, 0x4F, 0x66
+};
+
+/* LPC coefficient K9 lookup array */
+static const int8_t K9[0x08] =
+{
+    0xC0, 0xD4, 0xE8, 0xFC, 0x10, 0x25, 0x39, 0x4D
+};
+
+/* LPC coefficient K10 lookup array */
+static const int8_t K10[0x08] =
+{
+    0xCD, 0xDF, 0xF1, 0x04, 0x16, 0x20, 0x3B, 0x4D
+};
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+
+/* LPC bitstream byte pointer */
+static uint8_t *gp_byte;
+
+/* LPC bitstream bit pointer */
+static uint8_t  g_bit_pointer;
+
+/* LPC bitstream current read byte */
+static uint8_t  g_byte_1;
+
+/* LPC bitstream next read byte */
+static uint8_t  g_byte_2;
+
+/* Boolean flag whether FRAM is being used as LPC bitstream source */
+static uint8_t  gb_using_fram;
+
+/* Last frame decoded from the bitstream */
+static lpc_frame_t g_frame_decoded;
+
+/* Boolean flag whether g_frame_decoded is waiting to be played */
+static volatile uint8_t gb_frame_pending;
+
+/* Coefficients at the start of the playing frame */
+static lpc_frame_t g_frame_from;
+
+/* Coefficients at the end of the playing frame */
+static lpc_frame_t g_frame_to;
+
+/* Samples per frame, sets the playback rate */
+static uint16_t g_frame_samples = LPC_FRAME_SAMPLES;
+
+/* Sample position within the playing frame */
+static uint16_t g_frame_position;
+
+/* LPC synthesizer current pitch */
+static uint8_t  g_synth_pitch;
+
+/* LPC synthesizer current energy */
+static uint16_t g_synth_energy;
+
+/* LPC synthesizer current coefficient k1 */
+static int32_t  g_synth_k1;
+
+/* LPC synthesizer current coefficient k2 */
+static int32_t  g_synth_k2;
+
+/* LPC synthesizer current coefficient k3 */
+static int16_t  g_synth_k3;
+
+/* LPC synthesizer current coefficient k4 */
+static int16_t  g_synth_k4;
+
+/* LPC synthesizer current coefficient k5 */
+static int16_t  g_synth_k5;
+
+/* LPC synthesizer current coefficient k6 */
+static int16_t  g_synth_k6;
+
+/* LPC synthesizer current coefficient k7 */
+static int16_t  g_synth_k7;
+
+/* LPC synthesizer current coefficient k8 */
+static int16_t  g_synth_k8;
+
+/* LPC synthesizer current coefficient k9 */
+static int16_t  g_synth_k9;
+
+/* LPC synthesizer current coefficient k10 */
+static int16_t  g_synth_k10;
+
+/* LPC excitation pitch period counter */
+static uint8_t  g_period_counter;
+
+/* LPC unvoiced excitation noise generator state */
+static uint16_t g_synth_rand;
+
+/* LPC lattice filter state x0..x9 */
+static int16_t  g_synth_x[10];
+
+/*******************************************************************************
+* Function Name: lpc_start
+****************************************************************************//**
+* @par Summary
+*    Initializes reading of LPC bitstream from memory and resets the decoder.
+*******************************************************************************/
+void lpc_start(const uint8_t *p_lpc_data)
+{
+	/* Initialize pointers to LPC data bitstream */
+    gp_byte = (uint8_t *)p_lpc_data;
+	g_bit_pointer = 0u;
+    gb_using_fram = 0u;
+
+    /* Read the first and the second byte from bitstream */
+    g_byte_1 = reverse_bit_order(*gp_byte);
+    g_byte_2 = reverse_bit_order(*(gp_byte + 1));
+
+    reset_state();
+}
+
+#if SPEECH_STORE_MODE == 1
+/*******************************************************************************
+* Function Name: lpc_start_stored
+****************************************************************************//**
+* @par Summary
+*    Initializes reading of LPC bitstream from the external speech store and
+* resets the decoder. Unknown ids decode as an immediate end frame.
+*******************************************************************************/
+void lpc_start_stored(uint16_t id)
+{
+    (void)speechStoreOpen(id);
+	g_bit_pointer = 0u;
+    gb_using_fram = 1u;
+
+    /* Read the first and the second byte from bitstream */
+    g_byte_1 = reverse_bit_order(speechStoreNextByte());
+    g_byte_2 = reverse_bit_order(speechStoreNextByte());
+
+    reset_state();
+}
+#endif
+
+/*******************************************************************************
+* Function Name: lpc_set_frame_samples
+****************************************************************************//**
+* @par Summary
+*    Sets the number of samples each frame is played for. Fewer samples than
+* LPC_FRAME_SAMPLES speeds speech up without changing its pitch, as pitch is
+* set by the sample rate. Takes effect from the next lpc_start().
+*******************************************************************************/
+void lpc_set_frame_samples(uint16_t frame_samples)
+{
+    if (frame_samples < LPC_INTERP_BLOCK)
+    {
+        frame_samples = LPC_INTERP_BLOCK;
+    }
+    g_frame_samples = frame_samples;
+}
+
+/*******************************************************************************
+* Function Name: lpc_frame_needed
+****************************************************************************//**
+* @par Summary
+*    Returns 1 once the last frame read has started playing and the next one
+* can be read.
+*******************************************************************************/
+uint8_t lpc_frame_needed(void)
+{
+    return !gb_frame_pending;
+}
+
+/*******************************************************************************
+* Function Name: lpc_read_frame
+****************************************************************************//**
+* @par Summary
+*    Reads LPC coefficient indexes of one frame from bitstream and looks up
+* coefficient values. The frame starts playing once lpc_render() reaches the
+* end of the frame playing now. Only call when lpc_frame_needed() returns 1.
+*******************************************************************************/
+uint8_t lpc_read_frame(void)
+{
+    uint8_t energy;
+    uint8_t b_repeat_flag;
+    uint8_t i;
+
+    energy = get_bits(4);
+
+    if (0 == energy)
+    {
+        /* Energy = 0: silent frame */
+        g_frame_decoded.energy = 0;
+    }
+
+    else if (0xF == energy)
+    {
+        /* Energy = 15: end frame, stop synthesizer */
+        g_frame_decoded.energy = 0;
+        for (i = 0; i < 10; i++)
+        {
+            g_frame_decoded.k[i] = 0;
+        }
+    }
+
+    else
+    {
+        b_repeat_flag = get_bits(1);
+
+        g_frame_decoded.energy = ENERGY[energy];
+        g_frame_decoded.pitch  = PITCH[get_bits(6)];
+
+        /* A repeat frame would reuse previous coefficients */
+        /* otherwise read filter parameter values from input data */
+        if (!b_repeat_flag)
+        {
+            /* All frames use the first 4 coefficients */
+            g_frame_decoded.k[0] = K1[get_bits(5)];
+            g_frame_decoded.k[1] = K2[get_bits(5)];
+            g_frame_decoded.k[2] = K3[get_bits(4)];
+            g_frame_decoded.k[3] = K4[get_bits(4)];
+
+            if (g_frame_decoded.pitch)
+            {
+                /* Voiced frames use 6 extra coefficients. */
+                g_frame_decoded.k[4] = K5[get_bits(4)];
+                g_frame_decoded.k[5] = K6[get_bits(4)];
+                g_frame_decoded.k[6] = K7[get_bits(4)];
+                g_frame_decoded.k[7] = K8[get_bits(3)];
+                g_frame_decoded.k[8] = K9[get_bits(3)];
+                g_frame_decoded.k[9] = K10[get_bits(3)];
+            }
+        }
+    }
+
+    /* Hand the frame over to lpc_render() */
+    gb_frame_pending = 1u;
+
+    #if SPEECH_STORE_MODE == 1
+        /* Refill the idle speech store buffer while this frame plays */
+        if (gb_using_fram)
+        {
+            speechStorePrefetch();
+        }
+    #endif
+
+    return (0xF != energy);
+}
+
+/*******************************************************************************
+* Function Name: lpc_generate_sample
+****************************************************************************//**
+* @par Summary
+*    LPC decoder procedure. Calculates signed 9-bit audio sample value from
+* current global LPC coefficients. C reference for the lattice filter in
+* lpc_render(), does not advance frames.
+*******************************************************************************/
+int16_t lpc_generate_sample(void)
+{
+    return lattice_reference(next_excitation());
+}
+
+/*******************************************************************************
+* Function Name: lpc_render
+****************************************************************************//**
+* @par Summary
+*    Generates a block of samples using the block lattice kernel. Moves on to
+* the frame read by lpc_read_frame() every g_frame_samples samples, and
+* interpolates all frame parameters from the previous frame every
+* LPC_INTERP_BLOCK samples. Host tools call lpc_read_frame() followed by
+* lpc_render() of one frame.
+*******************************************************************************/
+void lpc_render(int16_t *p_samples, uint16_t count)
+{
+    uint16_t block;
+    uint16_t i;
+
+    while (count)
+    {
+        if (g_frame_position >= g_frame_samples)
+        {
+            begin_frame();
+        }
+
+        /* Largest block with constant coefficients */
+        block = g_frame_samples - g_frame_position;
+        if (block > LPC_INTERP_BLOCK)
+        {
+            block = LPC_INTERP_BLOCK;
+        }
+        if (block > count)
+        {
+            block = count;
+        }
+
+        interpolate(g_frame_position);
+
+        for (i = 0; i < block; i++)
+        {
+            p_samples[i] = next_excitation();
+        }
+        lattice_block(p_samples, block);
+
+        g_frame_position += block;
+        p_samples += block;
+        count -= block;
+    }
+}
+
+/*******************************************************************************
+* Function Name: lpc_lattice_compare
+****************************************************************************//**
+* @par Summary
+*    Runs loud frames with pseudo random coefficients through both
+* lattice_reference() and lattice_block() from the same filter state and
+* counts differing output samples and filter states. Leaves the decoder reset.
+*******************************************************************************/
+uint16_t lpc_lattice_compare(void)
+{
+    int16_t  reference[LPC_COMPARE_BLOCK];
+    int16_t  block[LPC_COMPARE_BLOCK];
+    int16_t  x_start[10];
+    int16_t  x_reference[10];
+    uint16_t mismatches = 0;
+    uint16_t frame;
+    uint8_t  i;
+    uint32_t seed = 1;
+
+    reset_state();
+
+    for (frame = 0; frame < LPC_COMPARE_FRAMES; frame++)
+    {
+        /* Loudest energies with pseudo random filter coefficients */
+        seed = seed * 1103515245u + 12345u;
+        g_synth_energy = ENERGY[13 + (frame & 1)];
+        g_synth_pitch  = (frame & 2) ? PITCH[(seed >> 8) & 0x3F] : 0;
+        g_synth_k1     = K1[(seed >> 14) & 0x1F];
+        g_synth_k2     = K2[(seed >> 19) & 0x1F];
+        g_synth_k3     = K3[(seed >> 24) & 0x0F];
+        g_synth_k4     = K4[(seed >> 28) & 0x0F];
+        seed = seed * 1103515245u + 12345u;
+        g_synth_k5     = K5[(seed >> 8) & 0x0F];
+        g_synth_k6     = K6[(seed >> 12) & 0x0F];
+        g_synth_k7     = K7[(seed >> 16) & 0x0F];
+        g_synth_k8     = K8[(seed >> 20) & 0x07];
+        g_synth_k9     = K9[(seed >> 23) & 0x07];
+        g_synth_k10    = K10[(seed >> 26) & 0x07];
+
+        for (i = 0; i < LPC_COMPARE_BLOCK; i++)
+        {
+            block[i] = next_excitation();
+        }
+        for (i = 0; i < 10; i++)
+        {
+            x_start[i] = g_synth_x[i];
+        }
+
+        /* C reference, one sample at a time */
+        for (i = 0; i < LPC_COMPARE_BLOCK; i++)
+        {
+            reference[i] = lattice_reference(block[i]);
+        }
+        for (i = 0; i < 10; i++)
+        {
+            x_reference[i] = g_synth_x[i];
+            g_synth_x[i] = x_start[i];
+        }
+
+        /* Block kernel from the same state */
+        lattice_block(block, LPC_COMPARE_BLOCK);
+
+        for (i = 0; i < LPC_COMPARE_BLOCK; i++)
+        {
+            mismatches += (reference[i] != block[i]);
+        }
+        for (i = 0; i < 10; i++)
+        {
+            mismatches += (x_reference[i] != g_synth_x[i]);
+        }
+    }
+
+    reset_state();
+
+    return mismatches;
+}
+
+/*******************************************************************************
+* Function Name: begin_frame
+****************************************************************************//**
+* @par Summary
+*    Starts the frame handed over by lpc_read_frame(), interpolating from the
+* parameters the last frame ended on. Holds the last frame if the next one
+* has not been read in time. As on the TI chips, interpolation is inhibited
+* into and out of silence and across voiced / unvoiced transitions, where the
+* new frame starts immediately.
+*******************************************************************************/
+static void begin_frame(void)
+{
+    g_frame_from = g_frame_to;
+
+    if (gb_frame_pending)
+    {
+        g_frame_to = g_frame_decoded;
+        gb_frame_pending = 0u;
+    }
+
+    if ((0 == g_frame_from.energy) || (0 == g_frame_to.energy) ||
+        ((0 == g_frame_from.pitch) != (0 == g_frame_to.pitch)))
+    {
+        g_frame_from = g_frame_to;
+    }
+
+    g_frame_position = 0;
+}
+
+/*******************************************************************************
+* Function Name: interpolate
+****************************************************************************//**
+* @par Summary
+*    Sets the current energy, pitch and reflection coefficients used by the
+* excitation and lattice filter, moving linearly from the previous frame to
+* the playing frame in integer arithmetic.
+*******************************************************************************/
+static void interpolate(uint16_t position)
+{
+    /* Fraction of the frame already played, Q8 */
+    const int32_t f = ((uint32_t)position << 8) / g_frame_samples;
+    const int32_t *p_from = g_frame_from.k;
+    const int32_t *p_to   = g_frame_to.k;
+
+    g_synth_energy = g_frame_from.energy +
+        ((((int32_t)g_frame_to.energy - g_frame_from.energy) * f) >> 8);
+    g_synth_pitch  = g_frame_from.pitch +
+        ((((int32_t)g_frame_to.pitch - g_frame_from.pitch) * f) >> 8);
+
+    g_synth_k1  = p_from[0] + (((p_to[0] - p_from[0]) * f) >> 8);
+    g_synth_k2  = p_from[1] + (((p_to[1] - p_from[1]) * f) >> 8);
+    g_synth_k3  = p_from[2] + (((p_to[2] - p_from[2]) * f) >> 8);
+    g_synth_k4  = p_from[3] + (((p_to[3] - p_from[3]) * f) >> 8);
+    g_synth_k5  = p_from[4] + (((p_to[4] - p_from[4]) * f) >> 8);
+    g_synth_k6  = p_from[5] + (((p_to[5] - p_from[5]) * f) >> 8);
+    g_synth_k7  = p_from[6] + (((p_to[6] - p_from[6]) * f) >> 8);
+    g_synth_k8  = p_from[7] + (((p_to[7] - p_from[7]) * f) >> 8);
+    g_synth_k9  = p_from[8] + (((p_to[8] - p_from[8]) * f) >> 8);
+    g_synth_k10 = p_from[9] + (((p_to[9] - p_from[9]) * f) >> 8);
+}
+
+/*******************************************************************************
+* Function Name: next_excitation
+****************************************************************************//**
+* @par Summary
+*    Generates the next excitation sample: the chirp repeated at the pitch
+* period for voiced frames, noise for unvoiced frames.
+*******************************************************************************/
+static int16_t next_excitation(void)
+{
+    int16_t u10;
+
+    if (g_synth_pitch)
+    {
+        /* Voiced source */
+        if (g_period_counter < g_synth_pitch)
+        {
+            g_period_counter++;
+        }
+        else
+        {
+            g_period_counter = 0;
+        }
+
+        if (g_period_counter < CHIRP_SIZE)
+        {
+            u10 = ((CHIRP[g_period_counter]) * (uint32_t)g_synth_energy) >> 8;
+        }
+        else
+        {
+            u10 = 0;
+        }
+    }
+    else
+    {
+        /* Unvoiced source */
+        g_synth_rand = (g_synth_rand >> 1) ^ ((g_synth_rand & 1) ? 0xB800 : 0);
+        u10 = (g_synth_rand & 1) ? g_synth_energy : -g_synth_energy;
+    }
+
+    return u10;
+}
+
+/*******************************************************************************
+* Function Name: lattice_reference
+****************************************************************************//**
+* @par Summary
+*    Reference 10-stage lattice filter for one sample. Every stage saturates
+* to 16 bits, so loud frames clip instead of wrapping around, and the output
+* saturates to the 9-bit VDAC_Synth range.
+*******************************************************************************/
+static int16_t lattice_reference(int16_t u10)
+{
+    int16_t u0;
+    int16_t u1;
+    int16_t u2;
+    int16_t u3;
+    int16_t u4;
+    int16_t u5;
+    int16_t u6;
+    int16_t u7;
+    int16_t u8;
+    int16_t u9;
+
+    /* Lattice filter forward path */
+    u9 = LPC_SSAT(u10 - ((g_synth_k10 * g_synth_x[9]) >> 7), 16);
+    u8 = LPC_SSAT(u9  - ((g_synth_k9  * g_synth_x[8]) >> 7), 16);
+    u7 = LPC_SSAT(u8  - ((g_synth_k8  * g_synth_x[7]) >> 7), 16);
+    u6 = LPC_SSAT(u7  - ((g_synth_k7  * g_synth_x[6]) >> 7), 16);
+    u5 = LPC_SSAT(u6  - ((g_synth_k6  * g_synth_x[5]) >> 7), 16);
+    u4 = LPC_SSAT(u5  - ((g_synth_k5  * g_synth_x[4]) >> 7), 16);
+    u3 = LPC_SSAT(u4  - ((g_synth_k4  * g_synth_x[3]) >> 7), 16);
+    u2 = LPC_SSAT(u3  - ((g_synth_k3  * g_synth_x[2]) >> 7), 16);
+    u1 = LPC_SSAT(u2  - ((g_synth_k2  * g_synth_x[1]) >> 15), 16);
+    u0 = LPC_SSAT(u1  - ((g_synth_k1  * g_synth_x[0]) >> 15), 16);
+
+    /* Lattice filter reverse path */
+    g_synth_x[9] = LPC_SSAT(g_synth_x[8] + ((g_synth_k9 * u8) >> 7), 16);
+    g_synth_x[8] = LPC_SSAT(g_synth_x[7] + ((g_synth_k8 * u7) >> 7), 16);
+    g_synth_x[7] = LPC_SSAT(g_synth_x[6] + ((g_synth_k7 * u6) >> 7), 16);
+    g_synth_x[6] = LPC_SSAT(g_synth_x[5] + ((g_synth_k6 * u5) >> 7), 16);
+    g_synth_x[5] = LPC_SSAT(g_synth_x[4] + ((g_synth_k5 * u4) >> 7), 16);
+    g_synth_x[4] = LPC_SSAT(g_synth_x[3] + ((g_synth_k4 * u3) >> 7), 16);
+    g_synth_x[3] = LPC_SSAT(g_synth_x[2] + ((g_synth_k3 * u2) >> 7), 16);
+    g_synth_x[2] = LPC_SSAT(g_synth_x[1] + ((g_synth_k2 * u1) >> 15), 16);
+    g_synth_x[1] = LPC_SSAT(g_synth_x[0] + ((g_synth_k1 * u0) >> 15), 16);
+    g_synth_x[0] = u0;
+
+    return LPC_SSAT(u0, 9);
+}
+
+/*******************************************************************************
+* Function Name: lattice_block
+****************************************************************************//**
+* @par Summary
+*    Block lattice filter kernel, filters excitation samples in place.
+*    - Filter state is loaded into locals once per block so the compiler keeps
+*      it in registers instead of reloading statics for every stage.
+*    - K3..K10 are pre-scaled to Q15 so every stage is one 32-bit MUL followed
+*      by SUB/ADD with ASR #15 and one SSAT.
+*    - Each reverse path update x(n+1) = x(n) + k(n+1) * u(n) is done as soon
+*      as u(n) is known, so only one u value is live at a time.
+*******************************************************************************/
+static void lattice_block(int16_t *p_samples, uint16_t count)
+{
+    const int32_t k[10] =
+    {
+        g_synth_k1,       g_synth_k2,
+        g_synth_k3 << 8,  g_synth_k4 << 8,
+        g_synth_k5 << 8,  g_synth_k6 << 8,
+        g_synth_k7 << 8,  g_synth_k8 << 8,
+        g_synth_k9 << 8,  g_synth_k10 << 8
+    };
+    int32_t x0 = g_synth_x[0];
+    int32_t x1 = g_synth_x[1];
+    int32_t x2 = g_synth_x[2];
+    int32_t x3 = g_synth_x[3];
+    int32_t x4 = g_synth_x[4];
+    int32_t x5 = g_synth_x[5];
+    int32_t x6 = g_synth_x[6];
+    int32_t x7 = g_synth_x[7];
+    int32_t x8 = g_synth_x[8];
+    int32_t x9 = g_synth_x[9];
+    int32_t u;
+
+    while (count--)
+    {
+        u = *p_samples;
+
+        u  = LPC_SSAT(u  - ((k[9] * x9) >> 15), 16);    /* u9 */
+        u  = LPC_SSAT(u  - ((k[8] * x8) >> 15), 16);    /* u8 */
+        x9 = LPC_SSAT(x8 + ((k[8] * u)  >> 15), 16);
+        u  = LPC_SSAT(u  - ((k[7] * x7) >> 15), 16);    /* u7 */
+        x8 = LPC_SSAT(x7 + ((k[7] * u)  >> 15), 16);
+        u  = LPC_SSAT(u  - ((k[6] * x6) >> 15), 16);    /* u6 */
+        x7 = LPC_SSAT(x6 + ((k[6] * u)  >> 15), 16);
+        u  = LPC_SSAT(u  - ((k[5] * x5) >> 15), 16);    /* u5 */
+        x6 = LPC_SSAT(x5 + ((k[5] * u)  >> 15), 16);
+        u  = LPC_SSAT(u  - ((k[4] * x4) >> 15), 16);    /* u4 */
+        x5 = LPC_SSAT(x4 + ((k[4] * u)  >> 15), 16);
+        u  = LPC_SSAT(u  - ((k[3] * x3) >> 15), 16);    /* u3 */
+        x4 = LPC_SSAT(x3 + ((k[3] * u)  >> 15), 16);
+        u  = LPC_SSAT(u  - ((k[2] * x2) >> 15), 16);    /* u2 */
+        x3 = LPC_SSAT(x2 + ((k[2] * u)  >> 15), 16);
+        u  = LPC_SSAT(u  - ((k[1] * x1) >> 15), 16);    /* u1 */
+        x2 = LPC_SSAT(x1 + ((k[1] * u)  >> 15), 16);
+        u  = LPC_SSAT(u  - ((k[0] * x0) >> 15), 16);    /* u0 */
+        x1 = LPC_SSAT(x0 + ((k[0] * u)  >> 15), 16);
+        x0 = u;
+
+        *p_samples++ = (int16_t)LPC_SSAT(u, 9);
+    }
+
+    g_synth_x[0] = x0;
+    g_synth_x[1] = x1;
+    g_synth_x[2] = x2;
+    g_synth_x[3] = x3;
+    g_synth_x[4] = x4;
+    g_synth_x[5] = x5;
+    g_synth_x[6] = x6;
+    g_synth_x[7] = x7;
+    g_synth_x[8] = x8;
+    g_synth_x[9] = x9;
+}
+
+/*******************************************************************************
+* Function Name: reset_state
+****************************************************************************//**
+* @par Summary
+*    Clears filter memory and coefficients so that every utterance decodes to
+* the same samples regardless of what was played before.
+*******************************************************************************/
+static void reset_state(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < 10; i++)
+    {
+        g_synth_x[i] = 0;
+    }
+    g_period_counter = 0;
+    g_synth_rand     = 1;
+    g_synth_pitch    = 0;
+    g_synth_energy   = 0;
+    g_synth_k1       = 0;
+    g_synth_k2       = 0;
+    g_synth_k3       = 0;
+    g_synth_k4       = 0;
+    g_synth_k5       = 0;
+    g_synth_k6       = 0;
+    g_synth_k7       = 0;
+    g_synth_k8       = 0;
+    g_synth_k9       = 0;
+    g_synth_k10      = 0;
+
+    for (i = 0; i < 10; i++)
+    {
+        g_frame_decoded.k[i] = 0;
+        g_frame_to.k[i]      = 0;
+    }
+    g_frame_decoded.energy = 0;
+    g_frame_decoded.pitch  = 0;
+    g_frame_to.energy      = 0;
+    g_frame_to.pitch       = 0;
+    gb_frame_pending       = 0u;
+
+    /* First lpc_render() starts the first frame */
+    g_frame_position = g_frame_samples;
+}
+
+/*******************************************************************************
+* Function Name: reverse_bit_order
+****************************************************************************//**
+* @par Summary
+*    Reverses bit order of given byte from LSB to MSB for easier processing.
+*******************************************************************************/
+static uint8_t
+reverse_bit_order(uint8_t byte)
+{
+	/* 76543210 */
+	byte = (byte >> 4) | (byte << 4); // Swap in groups of 4
+	/* 32107654 */
+	byte = ((byte & 0xCC) >> 2) | ((byte & 0x33) << 2); // Swap in groups of 2
+	/* 10325476 */
+	byte = ((byte & 0xAA) >> 1) | ((byte & 0x55) << 1); // Swap bit pairs
+	/* 01234567 */
+	return byte;
+}
+
+/*******************************************************************************
+* Function Name: get_bits
+****************************************************************************//**
+* @par Summary
+*    Reads given number of bits from current source byte. If there's not enough
+* bits available, more bits are added from next bitstream source byte.
+*******************************************************************************/
+static uint8_t get_bits(uint8_t bit_count)
+{
+	uint16_t data = (g_byte_1 << 8) | g_byte_2;
+	data = data << g_bit_pointer;
+	uint8_t value = data >> (16 - bit_count);
+
+    g_bit_pointer = g_bit_pointer + bit_count;
+	if (8 <= g_bit_pointer)
+    {
+		g_bit_pointer = g_bit_pointer - 8;
+        g_byte_1 = g_byte_2;
+        
+        if (!gb_using_fram)
+        {
+    		gp_byte++;
+            g_byte_2 = reverse_bit_order(*(gp_byte + 1));
+        }
+        #if SPEECH_STORE_MODE == 1
+        else
+        {
+            g_byte_2 = reverse_bit_order(speechStoreNextByte());
+        }
+        #endif
+	}
+
+	return value;
+}
+
+/* [] END OF FILE */
+
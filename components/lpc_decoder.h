@@ -0,0 +1,119 @@
+/*******************************************************************************
+* Written by Jaroslav Groman, for PSoC Analog Coprocessor
+* https://www.hackster.io/jardag/touch-controlled-talking-clock-for-psoc-analog-coprocessor-98c5a0
+*
+* Modified by Maanika Kenneth Koththioda, for use on PSoC5LP (lpc_synth.c)
+*
+* Split out of lpc_synth.c after the original firmware
+* Created on 18/10/2026
+*
+* File:     lpc_decoder.h
+* Version:  1.0.0
+*
+* Brief: Hardware independent LPC bitstream decoder and lattice filter.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    Only depends on <stdint.h> (and speech_store.c for stored utterances
+*    with SPEECH_STORE_MODE 1), so it can be linked into host tools to render
+*    utterances to WAV files, time lpc_generate_sample() or compare rendered
+*    output against golden files (tools/lpc_render.c). On the Cortex-M3 it saturates with the CMSIS
+*    __SSAT intrinsic from the PSoC core headers, on the host with C.
+*    Output is deterministic: every lpc_start() resets the filter and noise
+*    generator state.
+*
+* Source:
+*    LPC synth code adapted from https://github.com/going-digital/Talkie
+*
+*******************************************************************************/
+#ifndef LPC_DECODER_H
+	#define LPC_DECODER_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* @brief LPC audio sample rate in Hz */
+    #define SAMPLE_RATE     8000
+
+    /* @brief LPC chirp sample size in bytes */
+    #define CHIRP_SIZE        41
+
+    /* @brief LPC frame period in ms the vocabulary was encoded with. Frame
+     * parameters are interpolated, so vocabulary can be encoded with longer
+     * frames (fewer bytes per word) and built with a matching LPC_FRAME_MS */
+    #ifndef LPC_FRAME_MS
+        #define LPC_FRAME_MS  25
+    #endif
+
+    /* @brief Audio samples per LPC frame */
+    #define LPC_FRAME_SAMPLES ((SAMPLE_RATE / 1000) * LPC_FRAME_MS)
+
+    /* @brief Samples between frame parameter interpolation steps */
+    #define LPC_INTERP_BLOCK    8
+
+    /* @brief Samples per frame run through lpc_lattice_compare() */
+    #define LPC_COMPARE_BLOCK   64
+
+    /* @brief Frames run through lpc_lattice_compare() */
+    #define LPC_COMPARE_FRAMES  64
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+
+    // Brief: Start decoding an LPC bitstream held in memory.
+    // Param: p_lpc_data Pointer to LPC encoded bitstream data.
+    // Return: none
+    void lpc_start(const uint8_t *p_lpc_data);
+
+    // Brief: Start decoding an LPC bitstream from the speech store
+    //        (SPEECH_STORE_MODE 1 only).
+    // Param: id Utterance id in the selected speech store language.
+    // Return: none
+    void lpc_start_stored(uint16_t id);
+
+    // Brief: Set how many samples each frame plays for (playback rate).
+    // Param: frame_samples Samples per frame, LPC_FRAME_SAMPLES is normal speed.
+    // Return: none
+    void lpc_set_frame_samples(uint16_t frame_samples);
+
+    // Brief: Check whether the last frame read has started playing.
+    // Param: none.
+    // Return: uint8_t 1 if lpc_read_frame() may be called, 0 otherwise.
+    uint8_t lpc_frame_needed(void);
+
+    // Brief: Read the next frame, played once the current frame has finished.
+    // Param: none.
+    // Return: uint8_t 0 once the end frame has been read, 1 otherwise.
+    uint8_t lpc_read_frame(void);
+
+    // Brief: Generate single LPC audio sample with the C reference filter.
+    // Param: none.
+    // Return: int16_t Signed 9-bit sample value.
+    int16_t lpc_generate_sample(void);
+
+    // Brief: Generate a block of samples with the block lattice kernel.
+    // Param: p_samples Output buffer, count Number of samples to generate.
+    // Return: none
+    void lpc_render(int16_t *p_samples, uint16_t count);
+
+    // Brief: Compare the block lattice kernel against the C reference.
+    // Param: none.
+    // Return: uint16_t Number of mismatching samples and states (0 = bit exact).
+    uint16_t lpc_lattice_compare(void);
+
+#endif
+
+/* [] END OF FILE */
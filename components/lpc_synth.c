@@ -30,190 +30,42 @@
 *
 *******************************************************************************/
 #include "lpc_synth.h"
+#include "mode.h"
 
 /*******************************************************************************
 *   Private Function Declarations
 *******************************************************************************/
 
-// Brief: Read LPC coefficients from bitstream.
+// Brief: Set the decoder frame period for a playback rate.
+// Param: rate Playback rate in percent of normal speed.
 // Return: none
-static void synth_core(void);
-
-// Brief: Reverse bit order (LSB/MSB) in given byte.
-// Param: byte Byte to reverse bits from.
-// Return: uint8_t Byte with bit order reversed.
-static uint8_t reverse_bit_order(uint8_t byte);
-
-// Brief: Read given number of bits from LPC bitstream.
-// Param: bit_count Number of bits to read.
-// Return: uint8_t Binary value of read bits.
-static uint8_t get_bits(uint8_t bit_count);
-
-// Brief: Generate single LPC audio sample based on global coefficients.
-// Return: int16_t Generated sample value.
-static int16_t generate_sample(void);
-
-
-/*******************************************************************************
-*   Constant definitions
-*******************************************************************************/
-/* LPC 'chirp' sample array */
-static const int8_t CHIRP[CHIRP_SIZE] =
-{
-    0x00, 0x2A, 0xD4, 0x32, 0xB2, 0x12, 0x25, 0x14,
-    0x02, 0xE1, 0xC5, 0x02, 0x5F, 0x5A, 0x05, 0x0F,
-    0x26, 0xFC, 0xA5, 0xA5, 0xD6, 0xDD, 0xDC, 0xFC,
-    0x25, 0x2B, 0x22, 0x21, 0x0F, 0xFF, 0xF8, 0xEE,
-    0xED, 0xEF, 0xF7, 0xF6, 0xFA, 0x00, 0x03, 0x02,
-    0x01
-};
-
-/* LPC energy lookup array */
-static const uint8_t ENERGY[0x10] =
-{
-    0x00, 0x02, 0x03, 0x04, 0x05, 0x07, 0x0A, 0x0F,
-    0x14, 0x20, 0x29, 0x39, 0x51, 0x72, 0xA1, 0xFF
-};
-
-/* LPC pitch lookup array */
-static const uint8_t PITCH[0x40] =
-{
-    0x00, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
-    0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E,
-    0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26,
-    0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2D, 0x2F, 0x31,
-    0x33, 0x35, 0x36, 0x39, 0x3B, 0x3D, 0x3F, 0x42,
-    0x45, 0x47, 0x49, 0x4D, 0x4F, 0x51, 0x55, 0x57,
-    0x5C, 0x5F, 0x63, 0x66, 0x6A, 0x6E, 0x73, 0x77,
-    0x7B, 0x80, 0x85, 0x8A, 0x8F, 0x95, 0x9A, 0xA0
-};
-
-/* LPC coefficient K1 lookup array */
-static const int16_t K1[0x20] =
-{
-    0x82C0, 0x8380, 0x83C0, 0x8440, 0x84C0, 0x8540, 0x8600, 0x8780,
-    0x8880, 0x8980, 0x8AC0, 0x8C00, 0x8D40, 0x8F00, 0x90C0, 0x92C0,
-    0x9900, 0xA140, 0xAB80, 0xB840, 0xC740, 0xD8C0, 0xEBC0, 0x0000,
-    0x1440, 0x2740, 0x38C0, 0x47C0, 0x5480, 0x5EC0, 0x6700, 0x6D40
-};
-
-/* LPC coefficient K2 lookup array */
-static const int16_t K2[0x20] =
-{
-    0xAE00, 0xB480, 0xBB80, 0xC340, 0xCB80, 0xD440, 0xDDC0, 0xE780,
-    0xF180, 0xFBC0, 0x0600, 0x1040, 0x1A40, 0x2400, 0x2D40, 0x3600,
-    0x3E40, 0x45C0, 0x4CC0, 0x5300, 0x5880, 0x5DC0, 0x6240, 0x6640,
-    0x69C0, 0x6CC0, 0x6F80, 0x71C0, 0x73C0, 0x7580, 0x7700, 0x7E80
-};
-
-/* LPC coefficient K3 lookup array */
-static const int8_t K3[0x10] =
-{
-    0x92, 0x9F, 0xAD, 0xBA, 0xC8, 0xD5, 0xE3, 0xF0,
-    0xFE, 0x0B, 0x19, 0x26, 0x34, 0x41, 0x4F, 0x5C
-};
+static void set_rate(uint8_t rate);
 
-/* LPC coefficient K4 lookup array */
-static const int8_t K4[0x10] =
-{
-    0xAE, 0xBC, 0xCA, 0xD8, 0xE6, 0xF4, 0x01, 0x0F,
-    0x1D, 0x2B, 0x39, 0x47, 0x55, 0x63, 0x71, 0x7E
-};
-
-/* LPC coefficient K5 lookup array */
-static const int8_t K5[0x10] =
-{
-    0xAE, 0xBA, 0xC5, 0xD1, 0xDD, 0xE8, 0xF4, 0xFF,
-    0x0B, 0x17, 0x22, 0x2E, 0x39, 0x45, 0x51, 0x5C
-};
-
-/* LPC coefficient K6 lookup array */
-static const int8_t K6[0x10] =
-{
-    0xC0, 0xCB, 0xD6, 0xE1, 0xEC, 0xF7, 0x03, 0x0E,
-    0x19, 0x24, 0x2F, 0x3A, 0x45, 0x50, 0x5B, 0x66
-};
-
-/* LPC coefficient K7 lookup array */
-static const int8_t K7[0x10] =
-{
-    0xB3, 0xBF, 0xCB, 0xD7, 0xE3, 0xEF, 0xFB, 0x07,
-    0x13, 0x1F, 0x2B, 0x37, 0x43, 0x4F, 0x5A, 0x66
-};
-
-/* LPC coefficient K8 lookup array */
-static const int8_t K8[0x08] =
-{
-    0xC0, 0xD8, 0xF0, 0x07, 0x1F, 0x37, 0x4F, 0x66
-};
-
-/* LPC coefficient K9 lookup array */
-static const int8_t K9[0x08] =
-{
-    0xC0, 0xD4, 0xE8, 0xFC, 0x10, 0x25, 0x39, 0x4D
-};
-
-/* LPC coefficient K10 lookup array */
-static const int8_t K10[0x08] =
-{
-    0xCD, 0xDF, 0xF1, 0x04, 0x16, 0x20, 0x3B, 0x4D
-};
+// Brief: Play LPC frames until the end frame.
+// Return: none
+static void synth_core(void);
 
 /*******************************************************************************
 *   Variable definitions
 *******************************************************************************/
+/* Block of samples rendered by lpc_render, played out by synth_isr */
+static int16_t g_synth_block[SYNTH_BLOCK_SIZE];
 
-/* LPC bitstream byte pointer */
-static uint8_t *gp_byte;
-
-/* LPC bitstream bit pointer */
-static uint8_t  g_bit_pointer;
+/* Next sample of g_synth_block to play */
+static volatile uint8_t g_synth_block_position;
 
-/* LPC bitstream current read byte */
-static uint8_t  g_byte_1;
+#if SYNTH_PROFILE_MODE == 1
+    /* Samples generated since synthInitialize */
+    static volatile uint32_t g_profile_samples;
 
-/* LPC bitstream next read byte */
-static uint8_t  g_byte_2;
-
-/* Boolean flag whether FRAM is being used as LPC bitstream source */
-static uint8_t  gb_using_fram;
-
-/* LPC synthesizer current pitch */
-static uint8_t  g_synth_pitch;
-
-/* LPC synthesizer current energy */
-static uint16_t g_synth_energy;
-
-/* LPC synthesizer current coefficient k1 */
-static int32_t  g_synth_k1;
-
-/* LPC synthesizer current coefficient k2 */
-static int32_t  g_synth_k2;
-
-/* LPC synthesizer current coefficient k3 */
-static int16_t  g_synth_k3;
-
-/* LPC synthesizer current coefficient k4 */
-static int16_t  g_synth_k4;
-
-/* LPC synthesizer current coefficient k5 */
-static int16_t  g_synth_k5;
-
-/* LPC synthesizer current coefficient k6 */
-static int16_t  g_synth_k6;
-
-/* LPC synthesizer current coefficient k7 */
-static int16_t  g_synth_k7;
-
-/* LPC synthesizer current coefficient k8 */
-static int16_t  g_synth_k8;
-
-/* LPC synthesizer current coefficient k9 */
-static int16_t  g_synth_k9;
-
-/* LPC synthesizer current coefficient k10 */
-static int16_t  g_synth_k10;
+    /* CPU cycles spent in lpc_render since synthInitialize */
+    static volatile uint32_t g_profile_cycles;
 
+    /* First frame of "Hargrave library", timing does not depend on content */
+    static const uint8_t BENCHMARK_FRAME[] = {
+        0x6C, 0xCD, 0x69, 0xCD, 0xB3, 0xDC, 0xA9, 0xBF
+    };
+#endif
 
 /*******************************************************************************
 * Function Name: synth_hw_init
@@ -231,109 +83,136 @@ void synthInitialize(void)
     /* Timer generates interrupts at sampling rate */
     Timer_Synth_WritePeriod((CLOCK_SYNTH / SAMPLE_RATE) - 1);
 
+    #if SYNTH_PROFILE_MODE == 1
+        /* Enable the DWT cycle counter */
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        g_profile_samples = 0;
+        g_profile_cycles  = 0;
+    #endif
+
     /* Attach ISR */
     isr_Synth_StartEx(synth_isr);
 
 }
 
+/*******************************************************************************
+* Function Name: synthPowerDown
+****************************************************************************//**
+* @par Summary
+*    Stops the VDAC and output opamp between utterances. Timer_Synth only runs
+* while speaking, so it is already stopped.
+*******************************************************************************/
+void synthPowerDown(void)
+{
+    Opamp_Synth_Stop();
+    VDAC_Synth_Stop();
+}
+
+/*******************************************************************************
+* Function Name: synthPowerUp
+****************************************************************************//**
+* @par Summary
+*    Restarts the VDAC at mid-scale and the output opamp for the next
+* utterance.
+*******************************************************************************/
+void synthPowerUp(void)
+{
+    VDAC_Synth_Start();
+    VDAC_Synth_SetValue(SYNTH_DC_OFFSET);
+    Opamp_Synth_Start();
+}
+
 /*******************************************************************************
 * Function Name: synth_say
 ****************************************************************************//**
 * @par Summary
 *    Initializes reading of LPC bitstream from flash memory and starts audio
-* generator.
+* generator at the given playback rate.
 *******************************************************************************/
-void synth_say(const uint8_t *p_lpc_data)
+void synth_say(const uint8_t *p_lpc_data, uint8_t rate)
 {
-	/* Initialize pointers to LPC data bitstream */
-    gp_byte = (uint8_t *)p_lpc_data;
-	g_bit_pointer = 0u;
-    gb_using_fram = 0u;
-    
-    /* Read the first and the second byte from bitstream */
-    g_byte_1 = reverse_bit_order(*gp_byte);
-    g_byte_2 = reverse_bit_order(*(gp_byte + 1));
+    set_rate(rate);
+    lpc_start(p_lpc_data);
 
     synth_core();
 }
 
+#if SPEECH_STORE_MODE == 1
+/*******************************************************************************
+* Function Name: synth_say_stored
+****************************************************************************//**
+* @par Summary
+*    Initializes reading of LPC bitstream from the external speech store and
+* starts audio generator at the given playback rate. Unknown ids decode as an
+* immediate end frame.
+*******************************************************************************/
+void synth_say_stored(uint16_t id, uint8_t rate)
+{
+    set_rate(rate);
+    lpc_start_stored(id);
+
+    synth_core();
+}
+#endif
+
+/*******************************************************************************
+* Function Name: set_rate
+****************************************************************************//**
+* @par Summary
+*    Plays each frame for LPC_FRAME_SAMPLES * 100 / rate samples. The sample
+* rate is unchanged, so faster rates shorten the frame period without changing
+* pitch.
+*******************************************************************************/
+static void set_rate(uint8_t rate)
+{
+    if (rate < SYNTH_RATE_MIN)
+    {
+        rate = SYNTH_RATE_MIN;
+    }
+    else if (rate > SYNTH_RATE_MAX)
+    {
+        rate = SYNTH_RATE_MAX;
+    }
+
+    lpc_set_frame_samples((uint16_t)((LPC_FRAME_SAMPLES * 100u) / rate));
+}
+
 /*******************************************************************************
 * Function Name: synth_core
 ****************************************************************************//**
 * @par Summary
-*    Reads LPC coefficient indexes from bitstream, looks up coefficient values
-* and updates global current coefficients for DMA/ISR audio sample generator.
+*    Reads LPC frames until the end frame. Each frame is read while the one
+* before it plays, and synth_isr moves on to it once the frame period has
+* elapsed. Returns once the last frame has played.
 *******************************************************************************/
 static void synth_core()
 {
+    uint8_t b_more_frames;
+
+    /* First frame is ready before the first interrupt */
+    b_more_frames = lpc_read_frame();
+    g_synth_block_position = SYNTH_BLOCK_SIZE;
+
    /* Enable hardware */
     Timer_Synth_Start();
 
     /* Read LPC data bitstream until end frame */
-    uint8_t energy;
-    uint8_t b_repeat_flag;
-	do
+    while (b_more_frames)
     {
-		energy = get_bits(4);
-
-		if (0 == energy)
+        while (!lpc_frame_needed())
         {
-			/* Energy = 0: silent frame */
-			g_synth_energy = 0;
-		}
+            /* Previous frame still waiting for its turn */
+        }
+        b_more_frames = lpc_read_frame();
+    }
+
+    /* End frame starts once the last spoken frame has finished */
+    while (!lpc_frame_needed())
+    {
+    }
 
-        else if (0xF == energy)
-        {
-			/* Energy = 15: end frame, stop synthesizer */
-			g_synth_energy = 0;
-			g_synth_k1     = 0;
-			g_synth_k2     = 0;
-			g_synth_k3     = 0;
-			g_synth_k4     = 0;
-			g_synth_k5     = 0;
-			g_synth_k6     = 0;
-			g_synth_k7     = 0;
-			g_synth_k8     = 0;
-			g_synth_k9     = 0;
-			g_synth_k10    = 0;
-		}
-
-        else
-        {
-			b_repeat_flag = get_bits(1);
-
-            g_synth_energy = ENERGY[energy];
-			g_synth_pitch  = PITCH[get_bits(6)];
-
-			/* A repeat frame would reuse previous coefficients */
-            /* otherwise read filter parameter values from input data */
-			if (!b_repeat_flag)
-            {
-				/* All frames use the first 4 coefficients */
-				g_synth_k1 = K1[get_bits(5)];
-				g_synth_k2 = K2[get_bits(5)];
-				g_synth_k3 = K3[get_bits(4)];
-				g_synth_k4 = K4[get_bits(4)];
-
-				if (g_synth_pitch)
-                {
-					/* Voiced frames use 6 extra coefficients. */
-					g_synth_k5  = K5[get_bits(4)];
-					g_synth_k6  = K6[get_bits(4)];
-					g_synth_k7  = K7[get_bits(4)];
-					g_synth_k8  = K8[get_bits(3)];
-					g_synth_k9  = K9[get_bits(3)];
-					g_synth_k10 = K10[get_bits(3)];
-				}
-			}
-		}
-        
-        /* Generate 25 ms (23 + 2) worth of audio frames via ISR/DMA */
-        /* It takes approx 2 ms to update coefficients */
-        CyDelay(23);
-	}
-    while (0xF != energy);
-    
     Timer_Synth_Stop();
 }
 
@@ -341,156 +220,85 @@ static void synth_core()
 * Function Name: synth_isr
 ****************************************************************************//**
 * @par Summary
-*    Synth ISR routine generates audio samples at defined sample rate.
+*    Synth ISR routine outputs audio samples at defined sample rate. Samples
+* are rendered SYNTH_BLOCK_SIZE at a time so the lattice filter state stays in
+* registers for the whole block.
 *******************************************************************************/
 CY_ISR(synth_isr)
 {
-    /* Output clamp */
-    VDAC_Synth_SetValue(generate_sample());
+    if (g_synth_block_position >= SYNTH_BLOCK_SIZE)
+    {
+        #if SYNTH_PROFILE_MODE == 1
+            uint32_t start = DWT->CYCCNT;
+            lpc_render(g_synth_block, SYNTH_BLOCK_SIZE);
+            g_profile_cycles += DWT->CYCCNT - start;
+            g_profile_samples += SYNTH_BLOCK_SIZE;
+        #else
+            lpc_render(g_synth_block, SYNTH_BLOCK_SIZE);
+        #endif
+        g_synth_block_position = 0;
+    }
+
+    /* Samples are already saturated to the 9-bit VDAC range */
+    VDAC_Synth_SetValue(g_synth_block[g_synth_block_position++] + SYNTH_DC_OFFSET);
 
     /* Clear the interrupt (enable) */
    Timer_Synth_ReadStatusRegister();   
 }
 
+#if SYNTH_PROFILE_MODE == 1
 /*******************************************************************************
-* Function Name: reverse_bit_order
-****************************************************************************//**
-* @par Summary
-*    Reverses bit order of given byte from LSB to MSB for easier processing.
-*******************************************************************************/
-static uint8_t
-reverse_bit_order(uint8_t byte)
-{
-	/* 76543210 */
-	byte = (byte >> 4) | (byte << 4); // Swap in groups of 4
-	/* 32107654 */
-	byte = ((byte & 0xCC) >> 2) | ((byte & 0x33) << 2); // Swap in groups of 2
-	/* 10325476 */
-	byte = ((byte & 0xAA) >> 1) | ((byte & 0x55) << 1); // Swap bit pairs
-	/* 01234567 */
-	return byte;
-}
-
-/*******************************************************************************
-* Function Name: get_bits
+* Function Name: synth_samples_per_second
 ****************************************************************************//**
 * @par Summary
-*    Reads given number of bits from current source byte. If there's not enough
-* bits available, more bits are added from next bitstream source byte.
+*    Returns the sample rate lpc_generate_sample() could sustain if it had the
+* whole CPU, from the cycles measured in synth_isr. Divide SAMPLE_RATE by this
+* for the fraction of CPU the decoder uses.
 *******************************************************************************/
-static uint8_t get_bits(uint8_t bit_count)
+uint32_t synth_samples_per_second(void)
 {
-	uint16_t data = (g_byte_1 << 8) | g_byte_2;
-	data = data << g_bit_pointer;
-	uint8_t value = data >> (16 - bit_count);
+    uint32_t samples = g_profile_samples;
+    uint32_t cycles  = g_profile_cycles;
 
-    g_bit_pointer = g_bit_pointer + bit_count;
-	if (8 <= g_bit_pointer)
+    if (0 == cycles)
     {
-		g_bit_pointer = g_bit_pointer - 8;
-        g_byte_1 = g_byte_2;
-        
-        if (!gb_using_fram)
-        {
-    		gp_byte++;
-            g_byte_2 = reverse_bit_order(*(gp_byte + 1));
-        }
-	}
+        return 0;
+    }
 
-	return value;
+    return (uint32_t)(((uint64_t)samples * BCLK__BUS_CLK__HZ) / cycles);
 }
 
 /*******************************************************************************
-* Function Name: generate_sample
+* Function Name: synth_benchmark
 ****************************************************************************//**
 * @par Summary
-*    LPC decoder procedure. Calculates audio sample value from current global
-* LPC coefficients. Resulting 9-bit value is bitshifted and saturated in order
-* to fully use 13-bit VDAC.
+*    Times the C reference lpc_generate_sample() against the block kernel
+* lpc_render() over one frame and returns the average CPU cycles per sample of
+* each. Must not be called while speech is playing.
 *******************************************************************************/
-static int16_t generate_sample(void)
-{    
-    static uint8_t period_counter;
-
-    static int16_t x0;
-    static int16_t x1;
-    static int16_t x2;
-    static int16_t x3;
-    static int16_t x4;
-    static int16_t x5;
-    static int16_t x6;
-    static int16_t x7;
-    static int16_t x8;
-    static int16_t x9;
-    
-    int16_t u0;
-    int16_t u1;
-    int16_t u2;
-    int16_t u3;
-    int16_t u4;
-    int16_t u5;
-    int16_t u6;
-    int16_t u7;
-    int16_t u8;
-    int16_t u9;
-    int16_t u10;
-
-    if (g_synth_pitch)
-    {
-        /* Voiced source */
-        if (period_counter < g_synth_pitch)
-        {
-            period_counter++;
-        }
-        else
-        {
-            period_counter = 0;
-        }
+void synth_benchmark(uint32_t *p_reference_cycles, uint32_t *p_block_cycles)
+{
+    int16_t  samples[LPC_FRAME_SAMPLES];
+    uint32_t start;
+    uint16_t i;
 
-        if (period_counter < CHIRP_SIZE)
-        {
-            u10 = ((CHIRP[period_counter]) * (uint32_t)g_synth_energy) >> 8;
-        }
-        else
-        {
-            u10 = 0;
-        }
-    }
-    else
+    lpc_start(BENCHMARK_FRAME);
+    (void)lpc_read_frame();
+
+    start = DWT->CYCCNT;
+    for (i = 0; i < LPC_FRAME_SAMPLES; i++)
     {
-        /* Unvoiced source */
-        static uint16_t synth_rand = 1;
-        synth_rand = (synth_rand >> 1) ^ ((synth_rand & 1) ? 0xB800 : 0);
-        u10 = (synth_rand & 1) ? g_synth_energy : -g_synth_energy;
+        samples[i] = lpc_generate_sample();
     }
+    *p_reference_cycles = (DWT->CYCCNT - start) / LPC_FRAME_SAMPLES;
 
-    /* Lattice filter forward path */
-    u9 = u10 - ((g_synth_k10 * x9) >> 7);
-    u8 = u9  - ((g_synth_k9  * x8) >> 7);
-    u7 = u8  - ((g_synth_k8  * x7) >> 7);
-    u6 = u7  - ((g_synth_k7  * x6) >> 7);
-    u5 = u6  - ((g_synth_k6  * x5) >> 7);
-    u4 = u5  - ((g_synth_k5  * x4) >> 7);
-    u3 = u4  - ((g_synth_k4  * x3) >> 7);
-    u2 = u3  - ((g_synth_k3  * x2) >> 7);
-    u1 = u2  - ((g_synth_k2  * x1) >> 15);
-    u0 = u1  - ((g_synth_k1  * x0) >> 15);
-    
-    /* Lattice filter reverse path */
-    x9 = x8 + ((g_synth_k9 * u8) >> 7);
-    x8 = x7 + ((g_synth_k8 * u7) >> 7);
-    x7 = x6 + ((g_synth_k7 * u6) >> 7);
-    x6 = x5 + ((g_synth_k6 * u5) >> 7);
-    x5 = x4 + ((g_synth_k5 * u4) >> 7);
-    x4 = x3 + ((g_synth_k4 * u3) >> 7);
-    x3 = x2 + ((g_synth_k3 * u2) >> 7);
-    x2 = x1 + ((g_synth_k2 * u1) >> 15);
-    x1 = x0 + ((g_synth_k1 * u0) >> 15);
-    x0 = u0;
-    
-    uint16_t sample_out = u0 + 0b100000000; // temporary variable
-    
-    return sample_out;
+    lpc_start(BENCHMARK_FRAME);
+    (void)lpc_read_frame();
+
+    start = DWT->CYCCNT;
+    lpc_render(samples, LPC_FRAME_SAMPLES);
+    *p_block_cycles = (DWT->CYCCNT - start) / LPC_FRAME_SAMPLES;
 }
+#endif
 
 /* [] END OF FILE */
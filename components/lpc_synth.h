@@ -36,18 +36,28 @@
 *   Included Headers
 *******************************************************************************/
     #include <project.h>
+    #include "lpc_decoder.h"
 
 /*******************************************************************************
 *   Macros and #define Constants
 *******************************************************************************/
     /* Synthesizer timer clock frequency in Hz */
     #define CLOCK_SYNTH  1000000
-        
-    /* @brief LPC audio sample rate in Hz */
-    #define SAMPLE_RATE     8000
 
-    /* @brief LPC chirp sample size in bytes */
-    #define CHIRP_SIZE        41
+    /* @brief Mid-scale offset added to signed decoder samples for VDAC_Synth */
+    #define SYNTH_DC_OFFSET 0x100
+
+    /* @brief Normal playback rate in percent */
+    #define SYNTH_RATE_NORMAL   100
+
+    /* @brief Slowest playback rate in percent */
+    #define SYNTH_RATE_MIN      50
+
+    /* @brief Fastest playback rate in percent */
+    #define SYNTH_RATE_MAX      200
+
+    /* @brief Samples rendered per lpc_render() call in synth_isr */
+    #define SYNTH_BLOCK_SIZE 8
 
 /*******************************************************************************
 *   Function Declarations
@@ -57,15 +67,41 @@
     // Return: none
     void synthInitialize(void);
 
+    // Brief: Stop the synthesizer output stage between utterances.
+    // Return: none
+    void synthPowerDown(void);
+
+    // Brief: Restart the output stage stopped by synthPowerDown().
+    // Return: none
+    void synthPowerUp(void);
+
     // Brief: Generate speech audio based on LPC encoded bitstream.
-    // Param: p_lpc_data Pointer to LPC encoded bitstream data.
+    // Param: p_lpc_data Pointer to LPC encoded bitstream data,
+    //        rate Playback rate in percent (SYNTH_RATE_NORMAL is natural speed).
+    // Return: none
+    void synth_say(const uint8_t* p_lpc_data, uint8_t rate);
+
+    // Brief: Generate speech audio from the external speech store
+    //        (SPEECH_STORE_MODE 1 only).
+    // Param: id Utterance id in the selected speech store language,
+    //        rate Playback rate in percent (SYNTH_RATE_NORMAL is natural speed).
     // Return: none
-    void synth_say(const uint8_t* p_lpc_data);
+    void synth_say_stored(uint16_t id, uint8_t rate);
 
     // Brief: Synth ISR prototype.
     // Param: synth_isr ISR name.
     // Return: none
     CY_ISR_PROTO(synth_isr);
+
+    // Brief: Decoder throughput measured in synth_isr (SYNTH_PROFILE_MODE).
+    // Param: none.
+    // Return: samples per second lpc_render() can sustain.
+    uint32_t synth_samples_per_second(void);
+
+    // Brief: Cycles per sample of the C reference and block lattice kernels.
+    // Param: p_reference_cycles, p_block_cycles Results (SYNTH_PROFILE_MODE).
+    // Return: none
+    void synth_benchmark(uint32_t *p_reference_cycles, uint32_t *p_block_cycles);
     
 #endif
 
@@ -168,7 +168,7 @@ void compassStart() {
     
     I2C_1_Start();
     
-    I2C_Write(0x19, 0x20, 0x27u);//set CTRL_REG1_A register
+    I2C_Write(0x19, 0x20, 0x47u);//set CTRL_REG1_A register (50 Hz, fast enough for step detection)
     I2C_Write(0x19, 0x23, 0x08u);//set CTRL_REG4_A register
     
     I2C_Write(0x1E, 0x00, 0x0Cu);//set CRA_REG_M register
@@ -251,4 +251,19 @@ void compassRead(compassRaw *compassData)
     compassData->a_z = accelerometer(ZAXIS);   
 }
 
+/*******************************************************************************
+* Function Name: compassReadAccel
+********************************************************************************
+* @par Summary
+*   Reads only the acceleration data from all axes, for step detection at a
+*   higher rate than the heading is needed. Magnetometer fields are left as
+*   they were.
+*******************************************************************************/
+void compassReadAccel(compassRaw *compassData)
+{
+    compassData->a_x = accelerometer(XAXIS);
+    compassData->a_y = accelerometer(YAXIS);
+    compassData->a_z = accelerometer(ZAXIS);
+}
+
 /* [] END OF FILE */
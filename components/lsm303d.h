@@ -55,4 +55,8 @@ void compassStart();
 // Return: return varaibles
 void compassRead(compassRaw *compassData);
 
+// Brief: Reads the accelerometer data registers only
+// Return: return varaibles (accelerometer fields)
+void compassReadAccel(compassRaw *compassData);
+
 /* [] END OF FILE */
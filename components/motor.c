@@ -24,77 +24,84 @@
 *   Included Headers
 *******************************************************************************/
 #include <project.h>
-#include "stdio.h"
 #include "motor.h"
+#include "haptic.h"
 #include "mode.h"
+#include "trace.h"
 
 /*******************************************************************************
-*   Constant definitions
+*   Function Declarations
 *******************************************************************************/
-#define PWM_PERIOD      150
-#define MAX_DISTANCE    150
+static void setMotorUrgency(uint8 motor, uint8 urgency);
 
 /*******************************************************************************
-*   Variables
+*   Constant definitions
 *******************************************************************************/
-static char tempString[20];
+/* Urgency at and above which motors run continuously instead of pulsing */
+#define MOTOR_URGENT    192
+
+/* Urgency at and above which motors pulse fast */
+#define MOTOR_NEAR      96
 
 /*******************************************************************************
 * Function Name: startMotors
 ********************************************************************************
 * Summary:
-*   Start PWM components.
+*   Start PWM components and the haptic pattern engine.
 *******************************************************************************/
 void startMotors()
 {
     PWM_1_Start();
     PWM_2_Start();
+    hapticStart();
 }
 
 /*******************************************************************************
-* Function Name: setMotors
+* Function Name: setMotorUrgency
 ********************************************************************************
 * Summary:
-*   Set the pulse width according to the passed parameters.
+*   Select the obstacle layer pattern of one motor. Intensity follows
+*   urgency, and the pattern gets more insistent as it rises: slow pulses,
+*   fast pulses, then continuous.
 *******************************************************************************/
-void setMotors(int distance1, int distance2, int distance3)
+static void setMotorUrgency(uint8 motor, uint8 urgency)
 {
-    if ( distance1 <= MAX_DISTANCE )
-    {
-        PWM_1_WriteCompare1( PWM_PERIOD - distance1 );
-        #if DEBUG_PRINT_MODE == 1
-            sprintf( tempString, "num1: %d       Pulse width1: %d\n", distance1, PWM_PERIOD - distance1 );
-            UART_PutString( tempString );
-        #endif
-    }
-    else
-    {
-        PWM_2_WriteCompare(0);
-    }
-    if ( distance2 <= MAX_DISTANCE )
+    hapticPattern pattern;
+    
+    if ( urgency == 0 )
     {
-        PWM_1_WriteCompare2( PWM_PERIOD - distance2 );
-        #if DEBUG_PRINT_MODE == 1
-            sprintf( tempString, "num2: %d       Pulse width2: %d\n", distance2, PWM_PERIOD - distance2 );
-            UART_PutString( tempString );
-        #endif
+        hapticStop( 1u << motor, HAPTIC_PRIO_OBSTACLE );
+        return;
     }
-    else
+    
+    if ( urgency >= MOTOR_URGENT )
     {
-        PWM_1_WriteCompare2(0);
+        pattern = HAPTIC_CONSTANT;
     }
-    if ( distance3 <= MAX_DISTANCE )
+    else if ( urgency >= MOTOR_NEAR )
     {
-        PWM_2_WriteCompare( PWM_PERIOD - distance3 );
-        #if DEBUG_PRINT_MODE == 1
-            sprintf( tempString, "num3: %d       Pulse width3: %d\n", distance3, PWM_PERIOD - distance3 );
-            UART_PutString( tempString );
-        #endif
+        pattern = HAPTIC_PULSE_FAST;
     }
     else
     {
-        PWM_1_WriteCompare1(0);
+        pattern = HAPTIC_PULSE_SLOW;
     }
+    hapticPlay( 1u << motor, pattern, HAPTIC_PRIO_OBSTACLE, urgency, 1 );
+}
+
+/*******************************************************************************
+* Function Name: setMotors
+********************************************************************************
+* Summary:
+*   Set the haptic pattern according to the urgency of each sensor's obstacle.
+*******************************************************************************/
+void setMotors(uint8 urgency1, uint8 urgency2, uint8 urgency3)
+{
+    setMotorUrgency( 0, urgency1 );
+    setMotorUrgency( 1, urgency2 );
+    setMotorUrgency( 2, urgency3 );
+    
+    TRACE( TRACE_MOTOR_URGENCY, urgency1, urgency2, urgency3 );
     return;
 }
 
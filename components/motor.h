@@ -29,8 +29,8 @@
 void startMotors();
 
 // Brief: Set the Duty cycle according to the passed parameters.
-// Param: Distances from Ultrasonic readings
+// Param: Obstacle urgency (0..255) of each sensor (see obstacle.h).
 // Return: none
-void setMotors(int num1, int num2, int num3);
+void setMotors(uint8 urgency1, uint8 urgency2, uint8 urgency3);
 
 /* [] END OF FILE */
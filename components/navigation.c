@@ -0,0 +1,174 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     navigation.c
+* Version:  1.0.0
+*
+* Brief: Navigation session state machine.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "navigation.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* Next state for each state and event, NAV_STATES = event ignored */
+static const uint8_t TRANSITIONS[NAV_STATES][NAV_EVENTS] = {
+    /*                 BROWSE         SELECT         FIX             ARRIVE       ANNOUNCED */
+    /* IDLE */       { NAV_SELECTING, NAV_STATES,    NAV_STATES,     NAV_STATES,  NAV_STATES },
+    /* SELECTING */  { NAV_SELECTING, NAV_ACQUIRING, NAV_STATES,     NAV_STATES,  NAV_STATES },
+    /* ACQUIRING */  { NAV_STATES,    NAV_STATES,    NAV_NAVIGATING, NAV_STATES,  NAV_STATES },
+    /* NAVIGATING */ { NAV_STATES,    NAV_STATES,    NAV_STATES,     NAV_ARRIVED, NAV_STATES },
+    /* ARRIVED */    { NAV_STATES,    NAV_STATES,    NAV_STATES,     NAV_STATES,  NAV_IDLE },
+};
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+/* Current state, only changed by compare-and-swap */
+static volatile uint32_t g_state = NAV_IDLE;
+
+/*******************************************************************************
+* Function Name: navigationReset
+********************************************************************************
+* Summary:
+*    Back to IDLE.
+*******************************************************************************/
+void navigationReset(void)
+{
+    g_state = NAV_IDLE;
+}
+
+/*******************************************************************************
+* Function Name: navigationState
+********************************************************************************
+* Summary:
+*    Current state.
+*******************************************************************************/
+navState navigationState(void)
+{
+    return (navState)g_state;
+}
+
+/*******************************************************************************
+* Function Name: navigationEvent
+********************************************************************************
+* Summary:
+*    Looks up the next state and swaps it in, retrying if another task moved
+*    the state in between, so two tasks can never both make a transition
+*    out of the same state.
+*******************************************************************************/
+navState navigationEvent(navEvent event, navState *p_from)
+{
+    uint32_t from;
+    uint32_t to;
+
+    do
+    {
+        from = g_state;
+        to = (event < NAV_EVENTS) ? TRANSITIONS[from][event] : NAV_STATES;
+        if (NAV_STATES == to)
+        {
+            to = from;
+            break;
+        }
+    } while (!__sync_bool_compare_and_swap(&g_state, from, to));
+
+    if (p_from != 0)
+    {
+        *p_from = (navState)from;
+    }
+    return (navState)to;
+}
+
+#if NAV_HOST == 1
+/*******************************************************************************
+* Function Name: navigationSimulate
+********************************************************************************
+* Summary:
+*    Runs sessions the way the tasks drive them: a few browses, a select, the
+*    fix, arrival and its announcement, with an event that does not belong to
+*    the state posted before every scripted one. Each scripted event must
+*    reach its expected state and each stray event must change nothing.
+*******************************************************************************/
+void navigationSimulate(uint32_t sessions, navSimResult *p_result)
+{
+    static const uint8_t STRAY[NAV_STATES] = {
+        NAV_ARRIVE, NAV_FIX, NAV_BROWSE, NAV_SELECT, NAV_BROWSE
+    };
+    uint8_t  script[8];
+    uint8_t  expect[8];
+    uint8_t  steps;
+    uint8_t  browses;
+    uint8_t  i;
+    uint32_t seed = 1;
+    uint32_t session;
+    navState from;
+    navState to;
+
+    p_result->sessions    = 0;
+    p_result->transitions = 0;
+    p_result->ignored     = 0;
+    p_result->errors      = 0;
+
+    navigationReset();
+
+    for (session = 0; session < sessions; session++)
+    {
+        /* 1 to 4 browses, picked by a linear congruential generator */
+        seed = seed * 1103515245u + 12345u;
+        browses = (uint8_t)(1 + ((seed >> 16) & 3));
+
+        steps = 0;
+        for (i = 0; i < browses; i++)
+        {
+            script[steps] = NAV_BROWSE;    expect[steps++] = NAV_SELECTING;
+        }
+        script[steps] = NAV_SELECT;    expect[steps++] = NAV_ACQUIRING;
+        script[steps] = NAV_FIX;       expect[steps++] = NAV_NAVIGATING;
+        script[steps] = NAV_ARRIVE;    expect[steps++] = NAV_ARRIVED;
+        script[steps] = NAV_ANNOUNCED; expect[steps++] = NAV_IDLE;
+
+        for (i = 0; i < steps; i++)
+        {
+            to = navigationEvent((navEvent)STRAY[navigationState()], &from);
+            if (to == from)
+            {
+                p_result->ignored++;
+            }
+            else
+            {
+                p_result->errors++;
+            }
+
+            to = navigationEvent((navEvent)script[i], &from);
+            if (to != expect[i])
+            {
+                p_result->errors++;
+            }
+            if (to != from)
+            {
+                p_result->transitions++;
+            }
+        }
+
+        if (NAV_IDLE == navigationState())
+        {
+            p_result->sessions++;
+        }
+    }
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,112 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     navigation.h
+* Version:  1.0.0
+*
+* Brief: Navigation session state machine.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    A session runs IDLE -> SELECTING -> ACQUIRING -> NAVIGATING -> ARRIVED
+*    and back to IDLE:
+*      NAV_BROWSE    - short button press, IDLE/SELECTING -> SELECTING
+*      NAV_SELECT    - medium button hold, SELECTING -> ACQUIRING
+*      NAV_FIX       - first GPS fix, ACQUIRING -> NAVIGATING
+*      NAV_ARRIVE    - destination reached, NAVIGATING -> ARRIVED
+*      NAV_ANNOUNCED - arrival spoken, ARRIVED -> IDLE
+*    Any other event leaves the state unchanged. Transitions are a single
+*    compare-and-swap, so any task may post events.
+*
+*    The navigation tasks live for the whole run and sleep while the state
+*    is not NAVIGATING; whoever posts NAV_FIX wakes them.
+*
+*    Only depends on <stdint.h>. Build with NAV_HOST = 1 to add a simulation
+*    that cycles sessions with stray events on the host.
+*
+*******************************************************************************/
+#ifndef NAVIGATION_H
+	#define NAVIGATION_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+    #ifndef NAV_HOST
+        #define NAV_HOST 0
+    #endif
+
+/*******************************************************************************
+*   Enumerations
+*******************************************************************************/
+    // Session states.
+    typedef enum navState{
+        NAV_IDLE = 0,
+        NAV_SELECTING,
+        NAV_ACQUIRING,
+        NAV_NAVIGATING,
+        NAV_ARRIVED,
+        NAV_STATES
+    } navState;
+
+    // Events that move a session on.
+    typedef enum navEvent{
+        NAV_BROWSE = 0,
+        NAV_SELECT,
+        NAV_FIX,
+        NAV_ARRIVE,
+        NAV_ANNOUNCED,
+        NAV_EVENTS
+    } navEvent;
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+    #if NAV_HOST == 1
+        // Result of a simulated run.
+        typedef struct navSimResult{
+            uint32_t sessions;      // sessions that went back to IDLE
+            uint32_t transitions;   // state changes
+            uint32_t ignored;       // stray events that changed nothing
+            uint32_t errors;        // states that did not match the script
+        } navSimResult;
+    #endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    // Brief: Back to IDLE.
+    // Param: none.
+    // Return: none
+    void navigationReset(void);
+
+    // Brief: Current state.
+    // Param: none.
+    // Return: navState State.
+    navState navigationState(void);
+
+    // Brief: Apply an event.
+    // Param: event Event, p_from Set to the state the event was applied to
+    //        (may be 0).
+    // Return: navState State after the event.
+    navState navigationEvent(navEvent event, navState *p_from);
+
+    #if NAV_HOST == 1
+        // Brief: Cycle sessions through the state machine with stray events.
+        // Param: sessions Sessions to run, p_result Statistics of the run.
+        // Return: none
+        void navigationSimulate(uint32_t sessions, navSimResult *p_result);
+    #endif
+
+#endif
+
+/* [] END OF FILE */
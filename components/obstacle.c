@@ -0,0 +1,230 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    obstacle.c
+* Version: 1.0.0
+*
+* Brief: Per-sensor obstacle tracker. Estimates range rate and time to
+*        collision from the timestamped distance stream.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <stdint.h>
+#include "obstacle.h"
+#include "occupancy.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* Fraction bits of range and rate */
+#define TRACK_FRACTION      4
+
+/* Range correction gain alpha = 1 / 2^TRACK_ALPHA_SHIFT */
+#define TRACK_ALPHA_SHIFT   1
+
+/* Rate correction gain beta = 1 / 2^TRACK_BETA_SHIFT */
+#define TRACK_BETA_SHIFT    3
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+/* Filter state of one sensor */
+typedef struct trackState{
+    int32_t  range;       // Q4 cm
+    int32_t  rate;        // Q4 cm/s
+    uint32_t timeMs;      // time of the last sample
+    uint16_t ttc;
+    uint8_t  urgency;
+    uint8_t  valid;
+    uint8_t  clear;       // the last sample was OCC_RANGE_CLEAR
+} trackState;
+
+/*******************************************************************************
+*   Variables
+*******************************************************************************/
+static trackState tracks[OBSTACLE_SENSORS];
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Update time to collision and urgency of a track.
+// Param: track Track to update.
+// Return: none.
+static void updateUrgency( trackState *track );
+
+/*******************************************************************************
+* Function Name: obstacleReset
+********************************************************************************
+* Summary:
+*   Restart all tracks. The next sample of each sensor starts a new track.
+*******************************************************************************/
+void obstacleReset( void )
+{
+    uint8_t sensor;
+
+    for ( sensor = 0; sensor < OBSTACLE_SENSORS; sensor++ )
+    {
+        tracks[sensor].valid = 0;
+        tracks[sensor].ttc = OBSTACLE_TTC_NONE;
+        tracks[sensor].urgency = 0;
+    }
+}
+
+/*******************************************************************************
+* Function Name: obstacleUpdate
+********************************************************************************
+* Summary:
+*   Alpha-beta filter step. Predicts the range at the sample time from the
+*   current rate, then corrects range and rate by the prediction error. The
+*   rate correction is divided by the real sample gap, so irregular sample
+*   times (schedule changes, missed sequences) do not bias the rate. Steps
+*   no obstacle could close in the gap, and samples to or from clear,
+*   restart the track with no rate.
+*******************************************************************************/
+void obstacleUpdate( uint8_t sensor, int16_t distance, uint32_t timeMs )
+{
+    trackState *track;
+    int32_t measured, predicted, residual, gate;
+    uint32_t dt;
+    uint8_t clear, restart;
+
+    if ( sensor >= OBSTACLE_SENSORS )
+    {
+        return;
+    }
+
+    track = &tracks[sensor];
+    measured = (int32_t)distance << TRACK_FRACTION;
+    dt = timeMs - track->timeMs;
+    clear = ( distance >= OCC_RANGE_CLEAR );
+
+    if ( track->valid && dt == 0 )
+    {
+        /* Same sample time again, nothing new */
+        return;
+    }
+
+    restart = !track->valid || dt > OBSTACLE_STALE_MS || clear || track->clear;
+    if ( !restart )
+    {
+        predicted = track->range + ( track->rate * (int32_t)dt ) / 1000;
+        residual = measured - predicted;
+
+        /* Innovation gate: the most any obstacle can close in dt */
+        gate = ( ( OBSTACLE_MAX_CLOSING << TRACK_FRACTION ) * (int32_t)dt ) / 1000;
+        restart = ( residual > gate || residual < -gate );
+    }
+
+    if ( restart )
+    {
+        /* New track, no rate information yet */
+        track->range = measured;
+        track->rate = 0;
+        track->timeMs = timeMs;
+        track->valid = 1;
+    }
+    else
+    {
+        track->range = predicted + ( residual >> TRACK_ALPHA_SHIFT );
+        track->rate += ( ( residual * 1000 ) / (int32_t)dt ) >> TRACK_BETA_SHIFT;
+        track->timeMs = timeMs;
+    }
+    track->clear = clear;
+
+    updateUrgency( track );
+}
+
+/*******************************************************************************
+* Function Name: updateUrgency
+********************************************************************************
+* Summary:
+*   Time to collision is range / closing speed. Urgency is the larger of the
+*   proximity and time to collision terms, so a still obstacle close by is
+*   felt as before and a fast approaching one is felt while still far away.
+*******************************************************************************/
+static void updateUrgency( trackState *track )
+{
+    int32_t closing = -track->rate;
+    int32_t range = track->range >> TRACK_FRACTION;
+    uint32_t ttc;
+    uint8_t proximity = 0;
+    uint8_t collision = 0;
+
+    if ( range < 0 )
+    {
+        range = 0;
+    }
+
+    if ( closing >= ( OBSTACLE_MIN_CLOSING << TRACK_FRACTION ) )
+    {
+        ttc = ( (uint32_t)range * 1000 << TRACK_FRACTION ) / (uint32_t)closing;
+        track->ttc = ( ttc < OBSTACLE_TTC_NONE ) ? (uint16_t)ttc : OBSTACLE_TTC_NONE - 1;
+    }
+    else
+    {
+        track->ttc = OBSTACLE_TTC_NONE;
+    }
+
+    if ( range < OBSTACLE_MAX_RANGE )
+    {
+        proximity = (uint8_t)( ( OBSTACLE_MAX_RANGE - range ) * 255 / OBSTACLE_MAX_RANGE );
+    }
+
+    if ( track->ttc <= OBSTACLE_TTC_CRITICAL_MS )
+    {
+        collision = 255;
+    }
+    else if ( track->ttc < OBSTACLE_TTC_SAFE_MS )
+    {
+        collision = (uint8_t)( (uint32_t)( OBSTACLE_TTC_SAFE_MS - track->ttc ) * 255
+            / ( OBSTACLE_TTC_SAFE_MS - OBSTACLE_TTC_CRITICAL_MS ) );
+    }
+
+    track->urgency = ( proximity > collision ) ? proximity : collision;
+}
+
+/*******************************************************************************
+* Function Name: obstacleGet
+********************************************************************************
+* Summary:
+*   Read one sensor's track.
+*******************************************************************************/
+void obstacleGet( uint8_t sensor, obstacleTrack *track )
+{
+    if ( sensor >= OBSTACLE_SENSORS || !tracks[sensor].valid )
+    {
+        track->range = 0;
+        track->rate = 0;
+        track->ttc = OBSTACLE_TTC_NONE;
+        track->urgency = 0;
+        return;
+    }
+
+    track->range = (int16_t)( tracks[sensor].range >> TRACK_FRACTION );
+    track->rate = (int16_t)( tracks[sensor].rate >> TRACK_FRACTION );
+    track->ttc = tracks[sensor].ttc;
+    track->urgency = tracks[sensor].urgency;
+}
+
+/*******************************************************************************
+* Function Name: obstacleUrgency
+********************************************************************************
+* Summary:
+*   Urgency of one sensor's track, 0 when there is no track.
+*******************************************************************************/
+uint8_t obstacleUrgency( uint8_t sensor )
+{
+    return ( sensor < OBSTACLE_SENSORS && tracks[sensor].valid ) ? tracks[sensor].urgency : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,104 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    obstacle.h
+* Version: 1.0.0
+*
+* Brief: Per-sensor obstacle tracker. Estimates range rate and time to
+*        collision from the timestamped distance stream.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*   Each sensor runs an integer alpha-beta filter (alpha = 1/2, beta = 1/8)
+*   on range in Q4 cm: one prediction, one correction and two divisions per
+*   sample. Range rate is negative while an obstacle is approaching. Urgency
+*   (0..255) is the larger of a proximity term, which keeps the old linear
+*   range mapping for still obstacles, and a time to collision term, which
+*   rises from 0 at OBSTACLE_TTC_SAFE_MS to 255 at OBSTACLE_TTC_CRITICAL_MS.
+*
+*   A sample further from the prediction than OBSTACLE_MAX_CLOSING allows
+*   in the time since the last one is a different obstacle, not motion (the
+*   user turned towards a wall, or the arc cleared), and restarts the track
+*   instead of turning the step into a closing speed. So do samples to or
+*   from OCC_RANGE_CLEAR.
+*
+*   Only depends on <stdint.h> (and occupancy.h for OCC_RANGE_CLEAR), so it
+*   runs in the host tests (tests/host_sim.c).
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+// Number of tracked sensors.
+#define OBSTACLE_SENSORS            3
+
+// Ranges beyond this (cm) carry no proximity urgency.
+#define OBSTACLE_MAX_RANGE          150
+
+// Time to collision (ms) at or below which urgency is full.
+#define OBSTACLE_TTC_CRITICAL_MS    1000
+
+// Time to collision (ms) at or above which it adds no urgency.
+#define OBSTACLE_TTC_SAFE_MS        4000
+
+// Slowest closing speed (cm/s) a time to collision is computed for.
+#define OBSTACLE_MIN_CLOSING        10
+
+// Fastest closing speed (cm/s) a track follows, a walking user meeting a
+// walking person. Faster range steps restart the track.
+#define OBSTACLE_MAX_CLOSING        300
+
+// Gap between samples (ms) after which a track restarts.
+#define OBSTACLE_STALE_MS           500
+
+// Time to collision when the obstacle is not closing.
+#define OBSTACLE_TTC_NONE           0xFFFF
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+// Tracked obstacle in front of one sensor.
+typedef struct obstacleTrack{
+    int16_t  range;       // filtered range (cm)
+    int16_t  rate;        // range rate (cm/s), negative when approaching
+    uint16_t ttc;         // time to collision (ms), OBSTACLE_TTC_NONE if not closing
+    uint8_t  urgency;     // 0 (clear) .. 255 (imminent)
+} obstacleTrack;
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Restart all tracks.
+// Param: none.
+// Return: none.
+void obstacleReset( void );
+
+// Brief: Update one sensor's track with a new distance sample.
+// Param: sensor Sensor number, distance Measured range (cm),
+//        timeMs Time the sample was taken (ms).
+// Return: none.
+void obstacleUpdate( uint8_t sensor, int16_t distance, uint32_t timeMs );
+
+// Brief: Read one sensor's track.
+// Param: sensor Sensor number, track Filled with the current estimate.
+// Return: none.
+void obstacleGet( uint8_t sensor, obstacleTrack *track );
+
+// Brief: Urgency of one sensor's track.
+// Param: sensor Sensor number.
+// Return: urgency 0..255.
+uint8_t obstacleUrgency( uint8_t sensor );
+
+/* [] END OF FILE */
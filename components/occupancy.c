@@ -0,0 +1,197 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     occupancy.c
+* Version:  1.0.0
+*
+* Brief: Polar occupancy map around the user, fusing the ultrasonic array
+*        with compass heading.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "occupancy.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* Sensor mounting angles */
+static const int16_t SENSOR_ANGLES[OCC_SENSORS] = OCC_SENSOR_ANGLES;
+
+/* Body arc felt by each belt motor, degrees right of straight ahead */
+static const int16_t CUE_ARCS[OCC_CUE_ARCS][2] = {
+    { -90, -16 },
+    { -15,  15 },
+    {  16,  90 },
+};
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+/* One compass sector */
+typedef struct occupancyCell{
+    int16_t  range;     // nearest range seen (cm)
+    uint32_t seen_ms;   // time it was seen
+} occupancyCell;
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+/* Map, sector n is centred on n * 360 / OCC_SECTORS degrees */
+static occupancyCell g_cells[OCC_SECTORS];
+
+/* Heading samples are placed with, degrees 0..359 */
+static volatile int16_t g_heading;
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Wrap an angle into 0..359 degrees.
+static int16_t wrap_360(int32_t degrees);
+
+/*******************************************************************************
+* Function Name: occupancyReset
+********************************************************************************
+* Summary:
+*    Empties the map. The heading is kept.
+*******************************************************************************/
+void occupancyReset(void)
+{
+    uint8_t sector;
+
+    for (sector = 0; sector < OCC_SECTORS; sector++)
+    {
+        g_cells[sector].range = OCC_RANGE_CLEAR;
+        g_cells[sector].seen_ms = 0;
+    }
+}
+
+/*******************************************************************************
+* Function Name: occupancySetHeading
+********************************************************************************
+* Summary:
+*    Sets the compass heading the next samples are placed with.
+*******************************************************************************/
+void occupancySetHeading(int16_t degrees)
+{
+    g_heading = wrap_360(degrees);
+}
+
+/*******************************************************************************
+* Function Name: occupancyHeading
+********************************************************************************
+* Summary:
+*    Returns the compass heading samples are placed with.
+*******************************************************************************/
+int16_t occupancyHeading(void)
+{
+    return g_heading;
+}
+
+/*******************************************************************************
+* Function Name: occupancyUpdate
+********************************************************************************
+* Summary:
+*    Places one sample in the sector the sensor is facing. The sample
+*    replaces the sector, except that samples taken at the same time keep
+*    the nearest range.
+*******************************************************************************/
+void occupancyUpdate(uint8_t sensor, int16_t distance, uint32_t now_ms)
+{
+    occupancyCell *cell;
+    int16_t angle;
+
+    if (sensor >= OCC_SENSORS)
+    {
+        return;
+    }
+
+    if (distance > OCC_RANGE_CLEAR || distance < 0)
+    {
+        distance = OCC_RANGE_CLEAR;
+    }
+
+    angle = wrap_360((int32_t)g_heading + SENSOR_ANGLES[sensor]);
+    cell = &g_cells[((angle * OCC_SECTORS + 180) / 360) % OCC_SECTORS];
+
+    if (cell->seen_ms == now_ms && cell->range < distance)
+    {
+        return;
+    }
+    cell->range = distance;
+    cell->seen_ms = now_ms;
+}
+
+/*******************************************************************************
+* Function Name: occupancyRange
+********************************************************************************
+* Summary:
+*    Returns the nearest range held by sectors seen within OCC_WINDOW_MS
+*    whose centre lies in the body relative arc.
+*******************************************************************************/
+int16_t occupancyRange(int16_t from_deg, int16_t to_deg, uint32_t now_ms)
+{
+    int16_t nearest = OCC_RANGE_CLEAR;
+    int16_t body;
+    uint8_t sector;
+
+    for (sector = 0; sector < OCC_SECTORS; sector++)
+    {
+        if ((now_ms - g_cells[sector].seen_ms) > OCC_WINDOW_MS ||
+            g_cells[sector].range >= nearest)
+        {
+            continue;
+        }
+
+        /* Sector centre relative to the body, -180..179 */
+        body = wrap_360((int32_t)sector * 360 / OCC_SECTORS - g_heading + 180) - 180;
+        if (body >= from_deg && body <= to_deg)
+        {
+            nearest = g_cells[sector].range;
+        }
+    }
+
+    return nearest;
+}
+
+/*******************************************************************************
+* Function Name: occupancyCueRange
+********************************************************************************
+* Summary:
+*    Returns the nearest range in the arc of one belt motor.
+*******************************************************************************/
+int16_t occupancyCueRange(uint8_t cue, uint32_t now_ms)
+{
+    if (cue >= OCC_CUE_ARCS)
+    {
+        return OCC_RANGE_CLEAR;
+    }
+    return occupancyRange(CUE_ARCS[cue][0], CUE_ARCS[cue][1], now_ms);
+}
+
+/*******************************************************************************
+* Function Name: wrap_360
+********************************************************************************
+* Summary:
+*    Wraps an angle into 0..359 degrees.
+*******************************************************************************/
+static int16_t wrap_360(int32_t degrees)
+{
+    degrees %= 360;
+    if (degrees < 0)
+    {
+        degrees += 360;
+    }
+    return (int16_t)degrees;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,104 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     occupancy.h
+* Version:  1.0.0
+*
+* Brief: Polar occupancy map around the user, fusing the ultrasonic array
+*        with compass heading.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    The map is OCC_SECTORS compass fixed sectors, each holding the nearest
+*    range seen in it and when. A sample is placed in the sector at heading +
+*    the sensor's mounting angle and replaces what the sector held, so a clear
+*    reading also clears it. Sectors not seen for OCC_WINDOW_MS are empty.
+*    Because sectors are fixed to the compass, an obstacle stays in the map as
+*    the user turns away from it and is felt on the motor now facing it.
+*
+*    Cues read the map by body angle (0 = straight ahead, positive = right):
+*    occupancyRange() for any arc, occupancyCueRange() for the arc of each
+*    belt motor. Costs are bounded: one sector per sample, at most
+*    OCC_SECTORS per query, and 16 * 6 bytes of state.
+*
+*    The heading stays at its last value while no compass task runs, which
+*    makes the map body fixed.
+*
+*    Only depends on <stdint.h>, so walks can be replayed through it on the
+*    host (tests/host_sim.c).
+*
+*******************************************************************************/
+#ifndef OCCUPANCY_H
+	#define OCCUPANCY_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* Number of compass sectors, 22.5 degrees each */
+    #define OCC_SECTORS         16
+
+    /* Number of sensors placed into the map */
+    #define OCC_SENSORS         3
+
+    /* Mounting angle of each sensor, degrees right of straight ahead */
+    #define OCC_SENSOR_ANGLES   { -30, 0, 30 }
+
+    /* Time a sector is remembered after it was last seen (ms) */
+    #define OCC_WINDOW_MS       1500
+
+    /* Ranges at or beyond this are clear (cm, HRLV-MaxSonar maximum) */
+    #define OCC_RANGE_CLEAR     500
+
+    /* Number of cue arcs, one per belt motor (left, centre, right) */
+    #define OCC_CUE_ARCS        3
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    // Brief: Empty the map.
+    // Param: none.
+    // Return: none
+    void occupancyReset(void);
+
+    // Brief: Set the compass heading the next samples are placed with.
+    // Param: degrees Heading, clockwise from north.
+    // Return: none
+    void occupancySetHeading(int16_t degrees);
+
+    // Brief: Compass heading samples are placed with.
+    // Param: none.
+    // Return: int16_t Heading in degrees 0..359.
+    int16_t occupancyHeading(void);
+
+    // Brief: Place one sensor sample into the map.
+    // Param: sensor Sensor number, distance Range in cm, now_ms Sample time.
+    // Return: none
+    void occupancyUpdate(uint8_t sensor, int16_t distance, uint32_t now_ms);
+
+    // Brief: Nearest remembered obstacle in a body relative arc.
+    // Param: from_deg, to_deg Arc in degrees right of straight ahead
+    //        (from_deg <= to_deg), now_ms Current time.
+    // Return: int16_t Range in cm, OCC_RANGE_CLEAR if the arc is clear.
+    int16_t occupancyRange(int16_t from_deg, int16_t to_deg, uint32_t now_ms);
+
+    // Brief: Nearest remembered obstacle in the arc of one belt motor.
+    // Param: cue Motor number (0 = left), now_ms Current time.
+    // Return: int16_t Range in cm, OCC_RANGE_CLEAR if the arc is clear.
+    int16_t occupancyCueRange(uint8_t cue, uint32_t now_ms);
+
+#endif
+
+/* [] END OF FILE */
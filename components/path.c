@@ -23,6 +23,7 @@
 #include "path.h"
 #include "gps.h"
 #include "mode.h"
+#include "debug_tx.h"
 
 /*******************************************************************************
 *   Variables
@@ -90,7 +91,7 @@ void pathStart ( struct Path *path, double latitudeInDec, double longitudeInDec
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "Starting Point: H%d \nDestination is: H%d\n", 
                     checkpointName[path->checkpointCurrent], checkpointName[path->checkpointDest] );
-                UART_PutString( tempStr );
+                debugPrint( tempStr );
             #endif
             break;
         case 1: /* H3 is the starting point */
@@ -116,7 +117,7 @@ void pathStart ( struct Path *path, double latitudeInDec, double longitudeInDec
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "Starting Point: H%d \nDestination is: H%d\n", 
                     checkpointName[path->checkpointCurrent], checkpointName[path->checkpointDest] );
-                UART_PutString( tempStr );
+                debugPrint( tempStr );
             #endif
             break;
         case 2: /* H8 is the starting point */
@@ -142,13 +143,13 @@ void pathStart ( struct Path *path, double latitudeInDec, double longitudeInDec
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "Starting Point: H%d \nDestination is: H%d\n", 
                     checkpointName[path->checkpointCurrent], checkpointName[path->checkpointDest] );
-                UART_PutString( tempStr );
+                debugPrint( tempStr );
             #endif
             break;
         default:
             #if DEBUG_PRINT_MODE == 1
                 sprintf( tempStr, "ERROR in destination name\n");
-                UART_PutString( tempStr );
+                debugPrint( tempStr );
             #endif
             break;
     }
@@ -0,0 +1,272 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     periodic.c
+* Version:  1.0.0
+*
+* Brief: Timing statistics for periodic tasks: release jitter, execution
+*        time and deadline misses.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "periodic.h"
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+/* Registered tasks */
+static periodicTask *g_tasks[PERIODIC_MAX_TASKS];
+
+/* Number of registered tasks */
+static uint8_t g_count = 0;
+
+/*******************************************************************************
+* Function Name: periodicReset
+********************************************************************************
+* Summary:
+*    Forgets every registered task.
+*******************************************************************************/
+void periodicReset(void)
+{
+    g_count = 0;
+}
+
+/*******************************************************************************
+* Function Name: periodicInit
+********************************************************************************
+* Summary:
+*    Clears a task's statistics and registers it, once.
+*******************************************************************************/
+void periodicInit(periodicTask *p_task, const char *name, uint32_t period_ms)
+{
+    uint8_t i;
+
+    p_task->name          = name;
+    p_task->periodUs      = period_ms * 1000u;
+    p_task->release       = 0;
+    p_task->start         = 0;
+    p_task->jobs          = 0;
+    p_task->misses        = 0;
+    p_task->worstJitterUs = 0;
+    p_task->worstExecUs   = 0;
+    for (i = 0; i < PERIODIC_BINS; i++)
+    {
+        p_task->jitter[i] = 0;
+        p_task->exec[i]   = 0;
+    }
+
+    for (i = 0; i < g_count; i++)
+    {
+        if (g_tasks[i] == p_task)
+        {
+            return;
+        }
+    }
+    if (g_count < PERIODIC_MAX_TASKS)
+    {
+        g_tasks[g_count++] = p_task;
+    }
+}
+
+/*******************************************************************************
+* Function Name: periodicSetPeriod
+********************************************************************************
+* Summary:
+*    Changes the period without clearing the statistics. Call before
+*    periodicJobEnd(), which puts the next release one new period on.
+*******************************************************************************/
+void periodicSetPeriod(periodicTask *p_task, uint32_t period_ms)
+{
+    p_task->periodUs = period_ms * 1000u;
+}
+
+/*******************************************************************************
+* Function Name: periodicBegin
+********************************************************************************
+* Summary:
+*    Starts the release grid at now, used for the first job and after a task
+*    slept outside its periodic schedule.
+*******************************************************************************/
+void periodicBegin(periodicTask *p_task, uint32_t now_us)
+{
+    p_task->release = now_us;
+    p_task->start   = now_us;
+}
+
+/*******************************************************************************
+* Function Name: periodicJobStart
+********************************************************************************
+* Summary:
+*    Records how late the job started after its release.
+*******************************************************************************/
+void periodicJobStart(periodicTask *p_task, uint32_t now_us)
+{
+    uint32_t jitter = now_us - p_task->release;
+
+    /* Woken a little before the release (counter and tick disagree) */
+    if (jitter & 0x80000000u)
+    {
+        jitter = 0;
+    }
+
+    p_task->jitter[periodicBin(jitter)]++;
+    if (jitter > p_task->worstJitterUs)
+    {
+        p_task->worstJitterUs = jitter;
+    }
+    p_task->start = now_us;
+}
+
+/*******************************************************************************
+* Function Name: periodicJobEnd
+********************************************************************************
+* Summary:
+*    Records the execution time and whether the deadline (next release) was
+*    missed, then moves to the next release on the grid.
+*******************************************************************************/
+void periodicJobEnd(periodicTask *p_task, uint32_t now_us)
+{
+    uint32_t exec = now_us - p_task->start;
+
+    p_task->exec[periodicBin(exec)]++;
+    if (exec > p_task->worstExecUs)
+    {
+        p_task->worstExecUs = exec;
+    }
+    if (now_us - p_task->release > p_task->periodUs)
+    {
+        p_task->misses++;
+    }
+    p_task->jobs++;
+    p_task->release += p_task->periodUs;
+}
+
+/*******************************************************************************
+* Function Name: periodicBin
+********************************************************************************
+* Summary:
+*    Histogram bin of a time, log2 from PERIODIC_BIN0_US.
+*******************************************************************************/
+uint8_t periodicBin(uint32_t us)
+{
+    uint32_t edge = PERIODIC_BIN0_US;
+    uint8_t  bin = 0;
+
+    while (us >= edge && bin < PERIODIC_BINS - 1)
+    {
+        edge <<= 1;
+        bin++;
+    }
+    return bin;
+}
+
+/*******************************************************************************
+* Function Name: periodicCount
+********************************************************************************
+* Summary:
+*    Number of registered tasks.
+*******************************************************************************/
+uint8_t periodicCount(void)
+{
+    return g_count;
+}
+
+/*******************************************************************************
+* Function Name: periodicGet
+********************************************************************************
+* Summary:
+*    A registered task, 0 if out of range.
+*******************************************************************************/
+periodicTask *periodicGet(uint8_t index)
+{
+    return (index < g_count) ? g_tasks[index] : 0;
+}
+
+#if PERIODIC_HOST == 1
+/*******************************************************************************
+* Function Name: periodicSimulate
+********************************************************************************
+* Summary:
+*    Each microsecond the highest priority released task with work left
+*    runs. A job starts the first time it runs after its release and ends
+*    when its execution time is used up; the next release is one period
+*    later on the grid (delay until) or one period after the end (delay).
+*******************************************************************************/
+void periodicSimulate(const periodicSimTask *p_sim, periodicTask *p_timing,
+    uint8_t count, uint32_t duration_ms, uint8_t delay_until)
+{
+    uint32_t next[PERIODIC_MAX_TASKS];
+    uint32_t left[PERIODIC_MAX_TASKS];
+    uint8_t  started[PERIODIC_MAX_TASKS];
+    uint32_t now;
+    uint32_t end = duration_ms * 1000u;
+    uint8_t  run;
+    uint8_t  i;
+
+    if (count > PERIODIC_MAX_TASKS)
+    {
+        count = PERIODIC_MAX_TASKS;
+    }
+
+    periodicReset();
+    for (i = 0; i < count; i++)
+    {
+        periodicInit(&p_timing[i], p_sim[i].name, p_sim[i].periodMs);
+        periodicBegin(&p_timing[i], 0);
+        next[i]    = 0;
+        left[i]    = 0;
+        started[i] = 1;
+    }
+
+    for (now = 0; now < end; now++)
+    {
+        /* Release jobs whose time has come */
+        for (i = 0; i < count; i++)
+        {
+            if (left[i] == 0 && now >= next[i])
+            {
+                left[i] = p_sim[i].execUs;
+                started[i] = (now == 0);
+            }
+        }
+
+        /* Highest priority task with work left runs for 1 us */
+        run = count;
+        for (i = 0; i < count; i++)
+        {
+            if (left[i] > 0 && (run == count || p_sim[i].priority > p_sim[run].priority))
+            {
+                run = i;
+            }
+        }
+        if (run == count)
+        {
+            continue;
+        }
+
+        if (!started[run])
+        {
+            periodicJobStart(&p_timing[run], now);
+            started[run] = 1;
+        }
+        if (--left[run] == 0)
+        {
+            periodicJobEnd(&p_timing[run], now + 1);
+            next[run] = delay_until ? p_timing[run].release
+                                    : now + 1 + p_timing[run].periodUs;
+        }
+    }
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,151 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     periodic.h
+* Version:  1.0.0
+*
+* Brief: Timing statistics for periodic tasks: release jitter, execution
+*        time and deadline misses.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    A periodic task is released every period on a fixed grid (the one
+*    vTaskDelayUntil keeps), release n at begin + n * period. Per job:
+*      jitter    - job start minus its release,
+*      execution - job end minus job start,
+*      miss      - job ended later than its release + period (deadline =
+*                  period).
+*    Jitter and execution time go into PERIODIC_BINS log2 histograms, bin 0
+*    below PERIODIC_BIN0_US, each next bin twice as wide, the last bin open.
+*
+*    Times are in microseconds from a free running counter, differences
+*    use unsigned wrap around.
+*
+*    Only depends on <stdint.h>. Build with PERIODIC_HOST = 1 to add a
+*    fixed priority scheduler simulation on the host.
+*
+*******************************************************************************/
+#ifndef PERIODIC_H
+	#define PERIODIC_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+    #ifndef PERIODIC_HOST
+        #define PERIODIC_HOST 0
+    #endif
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* Most periodic tasks registered */
+    #define PERIODIC_MAX_TASKS      8
+
+    /* Histogram bins, log2 from PERIODIC_BIN0_US */
+    #define PERIODIC_BINS           12
+
+    /* Upper edge of the first bin (us) */
+    #define PERIODIC_BIN0_US        64
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+    // Timing of one periodic task.
+    typedef struct periodicTask{
+        const char *name;
+        uint32_t periodUs;
+        uint32_t release;                   // release time of the current job
+        uint32_t start;                     // start time of the current job
+        uint32_t jobs;                      // jobs completed
+        uint32_t misses;                    // jobs that ended after their deadline
+        uint32_t worstJitterUs;
+        uint32_t worstExecUs;
+        uint32_t jitter[PERIODIC_BINS];     // release jitter histogram
+        uint32_t exec[PERIODIC_BINS];       // execution time histogram
+    } periodicTask;
+
+    #if PERIODIC_HOST == 1
+        // A simulated task: fixed execution time, higher priority preempts.
+        typedef struct periodicSimTask{
+            const char *name;
+            uint32_t periodMs;
+            uint32_t execUs;
+            uint8_t  priority;
+        } periodicSimTask;
+    #endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    // Brief: Forget every registered task.
+    // Param: none.
+    // Return: none
+    void periodicReset(void);
+
+    // Brief: Clear a task's statistics and register it.
+    // Param: p_task Task timing, name Name (kept, must be static),
+    //        period_ms Period.
+    // Return: none
+    void periodicInit(periodicTask *p_task, const char *name, uint32_t period_ms);
+
+    // Brief: Change the period, from the next release on.
+    // Param: p_task Task timing, period_ms Period.
+    // Return: none
+    void periodicSetPeriod(periodicTask *p_task, uint32_t period_ms);
+
+    // Brief: Start the release grid at now, the first job starts now.
+    // Param: p_task Task timing, now_us Time.
+    // Return: none
+    void periodicBegin(periodicTask *p_task, uint32_t now_us);
+
+    // Brief: A job started, records its release jitter.
+    // Param: p_task Task timing, now_us Time.
+    // Return: none
+    void periodicJobStart(periodicTask *p_task, uint32_t now_us);
+
+    // Brief: A job ended, records its execution time and a deadline miss,
+    //        and moves to the next release.
+    // Param: p_task Task timing, now_us Time.
+    // Return: none
+    void periodicJobEnd(periodicTask *p_task, uint32_t now_us);
+
+    // Brief: Histogram bin of a time.
+    // Param: us Time.
+    // Return: uint8_t Bin.
+    uint8_t periodicBin(uint32_t us);
+
+    // Brief: Number of registered tasks.
+    // Param: none.
+    // Return: uint8_t Count.
+    uint8_t periodicCount(void);
+
+    // Brief: A registered task.
+    // Param: index 0 .. periodicCount() - 1.
+    // Return: periodicTask* Task timing, 0 if out of range.
+    periodicTask *periodicGet(uint8_t index);
+
+    #if PERIODIC_HOST == 1
+        // Brief: Run tasks on a simulated fixed priority CPU in 1 us steps,
+        //        registering one periodicTask per simulated task.
+        // Param: p_sim Tasks, p_timing Filled with their timing, count
+        //        Number of tasks, duration_ms Simulated time, delay_until
+        //        1 = release on the fixed grid (vTaskDelayUntil), 0 = one
+        //        period after the job ends (vTaskDelay).
+        // Return: none
+        void periodicSimulate(const periodicSimTask *p_sim, periodicTask *p_timing,
+            uint8_t count, uint32_t duration_ms, uint8_t delay_until);
+    #endif
+
+#endif
+
+/* [] END OF FILE */
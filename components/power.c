@@ -0,0 +1,390 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    power.c
+* Version: 1.0.0
+*
+* Brief: Tickless idle, energy estimate counters per navigation state and
+*        reference counted power gating of the audio blocks.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "power.h"
+#include "console.h"
+#include "sound.h"
+#include "lpc_synth.h"
+#include "mode.h"
+#include "task.h"
+
+#if OBJ_DETECT_MODE == 1
+    #include "distance.h"
+    #include "haptic.h"
+#endif
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+#define RUNTIME_PER_TICK    ( CONSOLE_RUNTIME_HZ / configTICK_RATE_HZ )
+
+/* SysTick counts per microsecond */
+#define SYSTICK_PER_US      ( configCPU_CLOCK_HZ / 1000000UL )
+
+/* Power down and power up of each audio block */
+static const struct { void (*down)( void ); void (*up)( void ); } BLOCK_SWITCH[POWER_BLOCKS] = {
+    { soundPowerDown, soundPowerUp },
+    { synthPowerDown, synthPowerUp },
+};
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+/* Counters per navigation state, time[POWER_ACTIVE] is filled on reading */
+static powerStats stats[NAV_STATES];
+
+/* Wall time per navigation state, run-time counter units */
+static uint64_t wallTime[NAV_STATES];
+
+/* Run-time counter and state when wall time was last added */
+static uint32 lastMark = 0;
+static navState lastState = NAV_IDLE;
+
+/* Audio block counters, onTime is added to on reading while powered */
+static powerBlockStats blocks[POWER_BLOCKS];
+
+/* Run-time counter when each powered block was powered up */
+static uint32 blockOnSince[POWER_BLOCKS];
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+/* Port SysTick tickless idle (port.c), replaced by portSUPPRESS_TICKS_AND_SLEEP */
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+
+static TickType_t tickHookIdle( void );
+static uint32 sleepWithTick( void );
+static uint32 sysTickCounts( uint32 before, uint32 after, uint32 load );
+
+/*******************************************************************************
+* Function Name: powerStart
+********************************************************************************
+* Summary:
+*   Clears the counters, time starts counting in the current state. Every
+*   audio block is powered down until its first claim.
+*******************************************************************************/
+void powerStart( void )
+{
+    uint8 state, mode, block;
+
+    for ( state = 0; state < NAV_STATES; state++ )
+    {
+        wallTime[state] = 0;
+        for ( mode = 0; mode < POWER_MODES; mode++ )
+        {
+            stats[state].time[mode] = 0;
+            stats[state].sleeps[mode] = 0;
+        }
+    }
+    lastMark = portGET_RUN_TIME_COUNTER_VALUE();
+    lastState = navigationState();
+
+    for ( block = 0; block < POWER_BLOCKS; block++ )
+    {
+        BLOCK_SWITCH[block].down();
+        blocks[block].users = 0;
+        blocks[block].wakes = 0;
+        blocks[block].lastWakeUs = 0;
+        blocks[block].worstWakeUs = 0;
+        blocks[block].onTime = 0;
+        blocks[block].totalTime = 0;
+    }
+}
+
+/*******************************************************************************
+* Function Name: powerSuppressTicksAndSleep
+********************************************************************************
+* Summary:
+*   Adds the wall time since the last call to the state it was spent in, then
+*   sleeps: with the tick stopped until the next deadline, or with the tick
+*   running while a tick hook needs every tick. The scheduler is suspended,
+*   so no task reads the counters half written.
+*******************************************************************************/
+void powerSuppressTicksAndSleep( TickType_t expectedIdle )
+{
+    uint32 now = portGET_RUN_TIME_COUNTER_VALUE();
+    uint32 slept;
+    TickType_t before, hookIdle;
+    powerMode mode;
+
+    wallTime[lastState] += now - lastMark;
+    lastMark = now;
+    lastState = navigationState();
+
+    hookIdle = tickHookIdle();
+    if ( hookIdle < configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+    {
+        mode = POWER_WFI;
+        slept = sleepWithTick();
+    }
+    else
+    {
+        /* Wake for the tick a tick hook needs next */
+        if ( expectedIdle > hookIdle )
+        {
+            expectedIdle = hookIdle;
+        }
+        mode = POWER_TICKLESS;
+        before = xTaskGetTickCount();
+        vPortSuppressTicksAndSleep( expectedIdle );
+        slept = ( xTaskGetTickCount() - before ) * RUNTIME_PER_TICK;
+    }
+
+    if ( slept > 0 )
+    {
+        stats[lastState].time[mode] += slept;
+        stats[lastState].sleeps[mode]++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: powerGetStats
+********************************************************************************
+* Summary:
+*   Copies a state's counters; active time is its wall time, including the
+*   time spent in it since the idle task last ran, less its sleep time.
+*******************************************************************************/
+void powerGetStats( navState state, powerStats *result )
+{
+    uint64_t wall;
+    uint64_t asleep;
+
+    taskENTER_CRITICAL();
+    *result = stats[state];
+    wall = wallTime[state];
+    if ( state == lastState )
+    {
+        wall += (uint32)( portGET_RUN_TIME_COUNTER_VALUE() - lastMark );
+    }
+    taskEXIT_CRITICAL();
+
+    asleep = result->time[POWER_WFI] + result->time[POWER_TICKLESS];
+    result->time[POWER_ACTIVE] = ( wall > asleep ) ? wall - asleep : 0;
+}
+
+/*******************************************************************************
+* Function Name: powerChargeUah
+********************************************************************************
+* Summary:
+*   Time in each mode times its estimated current.
+*******************************************************************************/
+uint32 powerChargeUah( const powerStats *stats )
+{
+    uint64_t charge;
+
+    charge = stats->time[POWER_ACTIVE] * POWER_ACTIVE_UA
+           + ( stats->time[POWER_WFI] + stats->time[POWER_TICKLESS] ) * POWER_SLEEP_UA;
+    return (uint32)( charge / ( (uint64_t)CONSOLE_RUNTIME_HZ * 3600 ) );
+}
+
+/*******************************************************************************
+* Function Name: powerAverageUa
+********************************************************************************
+* Summary:
+*   Time weighted mean of the estimated currents.
+*******************************************************************************/
+uint32 powerAverageUa( const powerStats *stats )
+{
+    uint64_t asleep = stats->time[POWER_WFI] + stats->time[POWER_TICKLESS];
+    uint64_t total = stats->time[POWER_ACTIVE] + asleep;
+
+    if ( total == 0 )
+    {
+        return 0;
+    }
+    return (uint32)( ( stats->time[POWER_ACTIVE] * POWER_ACTIVE_UA + asleep * POWER_SLEEP_UA ) / total );
+}
+
+/*******************************************************************************
+* Function Name: powerClaim
+********************************************************************************
+* Summary:
+*   The first claim powers the block up inside a critical section, so a
+*   second claimer never sees it counted but off, then waits for the output
+*   to settle and records the wake latency. Also called before the
+*   scheduler starts (welcome message), hence no taskENTER_CRITICAL.
+*******************************************************************************/
+void powerClaim( powerBlock block )
+{
+    uint32 load = SysTick->LOAD;
+    uint32 before = SysTick->VAL;
+    uint32 latency;
+    uint8 interruptState;
+    uint8 woken = 0;
+
+    interruptState = CyEnterCriticalSection();
+    if ( blocks[block].users++ == 0 )
+    {
+        BLOCK_SWITCH[block].up();
+        blockOnSince[block] = portGET_RUN_TIME_COUNTER_VALUE();
+        woken = 1;
+    }
+    CyExitCriticalSection( interruptState );
+
+    if ( woken )
+    {
+        CyDelayUs( POWER_SETTLE_US );
+        latency = sysTickCounts( before, SysTick->VAL, load ) / SYSTICK_PER_US;
+        blocks[block].wakes++;
+        blocks[block].lastWakeUs = latency;
+        if ( latency > blocks[block].worstWakeUs )
+        {
+            blocks[block].worstWakeUs = latency;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: powerRelease
+********************************************************************************
+* Summary:
+*   The last release powers the block down and adds the time it was on.
+*******************************************************************************/
+void powerRelease( powerBlock block )
+{
+    uint8 interruptState;
+
+    interruptState = CyEnterCriticalSection();
+    if ( blocks[block].users > 0 && --blocks[block].users == 0 )
+    {
+        BLOCK_SWITCH[block].down();
+        blocks[block].onTime += (uint32)( portGET_RUN_TIME_COUNTER_VALUE() - blockOnSince[block] );
+    }
+    CyExitCriticalSection( interruptState );
+}
+
+/*******************************************************************************
+* Function Name: powerBlockOn
+********************************************************************************
+* Summary:
+*   Whether a block is held powered, a single byte read.
+*******************************************************************************/
+uint8 powerBlockOn( powerBlock block )
+{
+    return blocks[block].users > 0;
+}
+
+/*******************************************************************************
+* Function Name: powerGetBlockStats
+********************************************************************************
+* Summary:
+*   Copies a block's counters, adding the time it has been on so far. Total
+*   time is the wall time of all navigation states.
+*******************************************************************************/
+void powerGetBlockStats( powerBlock block, powerBlockStats *result )
+{
+    uint32 now;
+    uint8 state;
+
+    taskENTER_CRITICAL();
+    now = portGET_RUN_TIME_COUNTER_VALUE();
+    *result = blocks[block];
+    if ( result->users > 0 )
+    {
+        result->onTime += (uint32)( now - blockOnSince[block] );
+    }
+    result->totalTime = (uint32)( now - lastMark );
+    for ( state = 0; state < NAV_STATES; state++ )
+    {
+        result->totalTime += wallTime[state];
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: powerPreSleep
+********************************************************************************
+* Summary:
+*   Called by the port with interrupts masked, just before its WFI. A tick
+*   between the idle task's check and the port masking interrupts can leave
+*   a tick hook due sooner (a sonar trigger pin to drop), so the WFI is
+*   skipped and the idle task checks again.
+*******************************************************************************/
+TickType_t powerPreSleep( TickType_t idle )
+{
+    return ( tickHookIdle() < idle ) ? 0 : idle;
+}
+
+/*******************************************************************************
+* Function Name: tickHookIdle
+********************************************************************************
+* Summary:
+*   Ticks the tick hook users can go without running: none during haptic
+*   playback, up to the next sonar slot while sampling.
+*******************************************************************************/
+static TickType_t tickHookIdle( void )
+{
+    #if OBJ_DETECT_MODE == 1
+        if ( hapticBusy() )
+        {
+            return 0;
+        }
+        return distanceIdleTicks();
+    #else
+        return portMAX_DELAY;
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: sleepWithTick
+********************************************************************************
+* Summary:
+*   WFI with the tick running, so the next tick at the latest wakes the CPU.
+*   Interrupts are masked around it (a pending interrupt still ends WFI) so
+*   the sleep is measured from SysTick before any interrupt runs. Returns
+*   run-time counter units slept, 0 if a task was readied before the sleep.
+*******************************************************************************/
+static uint32 sleepWithTick( void )
+{
+    uint32 load, before, after, counts;
+
+    CyGlobalIntDisable;
+    if ( eTaskConfirmSleepModeStatus() == eAbortSleep )
+    {
+        CyGlobalIntEnable;
+        return 0;
+    }
+
+    load = SysTick->LOAD;
+    before = SysTick->VAL;
+    __DSB();
+    __WFI();
+    __ISB();
+    after = SysTick->VAL;
+    CyGlobalIntEnable;
+
+    counts = sysTickCounts( before, after, load );
+    return counts * RUNTIME_PER_TICK / ( load + 1 );
+}
+
+/*******************************************************************************
+* Function Name: sysTickCounts
+********************************************************************************
+* Summary:
+*   SysTick counts between two readings less than one tick apart. SysTick
+*   counts down, a later reading above the first means it reloaded.
+*******************************************************************************/
+static uint32 sysTickCounts( uint32 before, uint32 after, uint32 load )
+{
+    return ( after <= before ) ? before - after : before + load + 1 - after;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,178 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    power.h
+* Version: 1.0.0
+*
+* Brief: Tickless idle, energy estimate counters per navigation state and
+*        reference counted power gating of the audio blocks.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*   VDAC8_1, VDAC8_2, Opamp_1, Opamp_2, DDS24_1, DMA_1, DMA_2 (sound.h)
+*   VDAC_Synth, Opamp_Synth (lpc_synth.h)
+*
+* Notes:
+*   The idle task calls powerSuppressTicksAndSleep() (portSUPPRESS_TICKS_AND_
+*   SLEEP in FreeRTOSConfig.h) when no task is due for at least
+*   configEXPECTED_IDLE_TIME_BEFORE_SLEEP ticks. The CPU then sleeps (WFI)
+*   in one of two ways:
+*     tickless - the port's SysTick tickless idle: the tick is stopped and
+*                SysTick reprogrammed to fire at the next task deadline, or
+*                sooner at the tick a tick hook needs next: the next sonar
+*                slot (distanceIdleTicks()), which the tick ending the sleep
+*                runs.
+*     wfi      - the tick keeps running and wakes the CPU every tick. Used
+*                while a tick hook is needed on the next tick: a sonar
+*                trigger pin to drop, or haptic playback (hapticBusy()).
+*   Either way any enabled interrupt wakes the CPU: UART RX (isr_GPS_
+*   Received), the button (isr_button), the ADC and the next deadline.
+*   Clocks and UDBs keep running in WFI, so no GPS character is lost and the
+*   button hold counter keeps counting. The PSoC Sleep and Hibernate modes
+*   would stop the UART and need a sleep timer or RTC wake source, which
+*   the design does not have.
+*
+*   Time is split per navigation state into active, wfi and tickless, in
+*   run-time counter units (CONSOLE_RUNTIME_HZ): wall time from the run-time
+*   counter, sleep time from SysTick around each WFI. Charge is estimated
+*   from POWER_ACTIVE_UA and POWER_SLEEP_UA, the MCU only (GPS, compass,
+*   sonars and amplifier are not in it). Each navigation state change writes
+*   a TRACE_ENERGY record of the state left, so walk traces carry the
+*   counters. The console energy command prints them.
+*
+*   Audio blocks are powered while anyone holds them: powerClaim() before a
+*   cue, powerRelease() after it. The first claim powers the block up and
+*   waits POWER_SETTLE_US for the VDAC and opamp outputs to settle, so a
+*   cue starts at most start calls + POWER_SETTLE_US after its claim (the
+*   wake latency, measured with SysTick); the last release powers it down.
+*   Sound is held for the whole walk by vTaskSound, speech for each
+*   utterance. Per block the time powered, wakes and latency are counted,
+*   and its current estimated from POWER_SOUND_UA and POWER_SPEECH_UA.
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <project.h>
+#include "FreeRTOS.h"
+#include "navigation.h"
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+// MCU current with the CPU running (uA), datasheet typical at the bus clock.
+#define POWER_ACTIVE_UA         6300
+
+// MCU current with the CPU halted in WFI, peripherals running (uA).
+#define POWER_SLEEP_UA          2500
+
+// Sound block current: 2 VDAC8 at high speed, 2 opamps at high power, DDS (uA).
+#define POWER_SOUND_UA          3200
+
+// Speech block current: VDAC and opamp (uA).
+#define POWER_SPEECH_UA         1500
+
+// Output settling after a block powers up (us).
+#define POWER_SETTLE_US         20
+
+/*******************************************************************************
+*   Enumerations
+*******************************************************************************/
+// What the CPU was doing.
+typedef enum powerMode{
+    POWER_ACTIVE = 0,
+    POWER_WFI,
+    POWER_TICKLESS,
+    POWER_MODES
+} powerMode;
+
+// Audio blocks with a reference count.
+typedef enum powerBlock{
+    POWER_SOUND = 0,
+    POWER_SPEECH,
+    POWER_BLOCKS
+} powerBlock;
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+// Energy counters of one navigation state.
+typedef struct powerStats{
+    uint64_t time[POWER_MODES];     // run-time counter units per mode
+    uint32 sleeps[POWER_MODES];     // sleeps entered per mode
+} powerStats;
+
+// Counters of one audio block.
+typedef struct powerBlockStats{
+    uint8 users;                    // claims held now
+    uint32 wakes;                   // times powered up
+    uint32 lastWakeUs;              // claim to ready, last power up
+    uint32 worstWakeUs;             // claim to ready, worst power up
+    uint64_t onTime;                // run-time counter units powered
+    uint64_t totalTime;             // run-time counter units since powerStart()
+} powerBlockStats;
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Clear the counters and power down the audio blocks, call after
+//        their components are started and before the scheduler starts.
+// Param: none.
+// Return: none.
+void powerStart( void );
+
+// Brief: Sleep until the next deadline or interrupt, called by the idle task
+//        with the scheduler suspended (portSUPPRESS_TICKS_AND_SLEEP).
+// Param: expectedIdle Ticks until the next task is due.
+// Return: none.
+void powerSuppressTicksAndSleep( TickType_t expectedIdle );
+
+// Brief: Last check before the port's tickless WFI (configPRE_SLEEP_PROCESSING),
+//        called with interrupts masked.
+// Param: idle Ticks the port is about to sleep for.
+// Return: idle, or 0 to skip the WFI when a tick hook is due sooner.
+TickType_t powerPreSleep( TickType_t idle );
+
+// Brief: Read the counters of a state, including the time spent in it so far.
+// Param: state Navigation state, stats Filled with its counters.
+// Return: none.
+void powerGetStats( navState state, powerStats *stats );
+
+// Brief: Estimated MCU charge used.
+// Param: stats Counters.
+// Return: charge (uAh).
+uint32 powerChargeUah( const powerStats *stats );
+
+// Brief: Estimated average MCU current.
+// Param: stats Counters.
+// Return: current (uA), 0 if no time was counted.
+uint32 powerAverageUa( const powerStats *stats );
+
+// Brief: Hold an audio block powered, powering it up if it was off.
+// Param: block Block.
+// Return: none, the block is ready for output.
+void powerClaim( powerBlock block );
+
+// Brief: Drop a hold, the last one powers the block down.
+// Param: block Block.
+// Return: none.
+void powerRelease( powerBlock block );
+
+// Brief: Whether an audio block is powered, without a lock.
+// Param: block Block.
+// Return: 1 while claimed.
+uint8 powerBlockOn( powerBlock block );
+
+// Brief: Read the counters of an audio block.
+// Param: block Block, stats Filled with its counters.
+// Return: none.
+void powerGetBlockStats( powerBlock block, powerBlockStats *stats );
+
+/* [] END OF FILE */
@@ -0,0 +1,446 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     rate_policy.c
+* Version:  1.0.0
+*
+* Brief: Adaptive rate policy: scales the GPS, compass, sonar and sound loop
+*        periods with the user's motion and the battery charge.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "rate_policy.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* Rate plans: gps, compass, sonar, sound (ms) */
+static const ratePlan PLANS[RATE_MOTIONS][RATE_BATTERY_BANDS] = {
+    {   /* stationary */
+        { { 2000,  500,  300,  500 } },
+        { { 3000, 1000,  500, 1000 } },
+        { { 5000, 1000, 1000, 1000 } },
+    },
+    {   /* walking, sonar at full rate */
+        { { RATE_GPS_BASE_MS, RATE_COMPASS_BASE_MS, RATE_SONAR_BASE_MS, RATE_SOUND_BASE_MS } },
+        { { RATE_GPS_BASE_MS, RATE_COMPASS_BASE_MS, RATE_SONAR_BASE_MS,  500 } },
+        { { RATE_GPS_BASE_MS,  500, RATE_SONAR_BASE_MS,  500 } },
+    },
+};
+
+/* Estimated current of each loop at its base period (uA) */
+static const uint32_t LOOP_UA[RATE_LOOPS] = {
+    RATE_GPS_UA, RATE_COMPASS_UA, RATE_SONAR_UA, RATE_SOUND_UA
+};
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+/* Current plan, one word per loop so readers need no lock */
+static volatile uint32_t g_period[RATE_LOOPS] = {
+    RATE_GPS_BASE_MS, RATE_COMPASS_BASE_MS, RATE_SONAR_BASE_MS, RATE_SOUND_BASE_MS
+};
+
+/* Classifier state */
+static rateMotion  g_motion = RATE_WALKING;
+static rateBattery g_battery = RATE_BATTERY_OK;
+static uint32_t    g_gravity = 0;          // magnitude average, mg << RATE_GRAVITY_SHIFT
+static int16_t     g_heading = -1;         // heading of the last sample, -1 = none
+static uint32_t    g_last_motion = 0;      // time of the last step or turn
+
+/* Boolean flag whether the policy runs, and when it was last counted */
+static uint8_t     gb_running = 0;
+static uint32_t    g_mark = 0;
+
+/* Counters */
+static rateStats   g_stats;
+
+/*******************************************************************************
+*   Private Function Declarations
+*******************************************************************************/
+// Brief: Add the time since the last mark to the counters.
+// Param: now_ms Time.
+// Return: none
+static void account(uint32_t now_ms);
+
+// Brief: Switch to a plan.
+// Param: p_plan Plan.
+// Return: uint8_t 1 if it differs from the current one.
+static uint8_t usePlan(const ratePlan *p_plan);
+
+/*******************************************************************************
+* Function Name: rateReset
+********************************************************************************
+* Summary:
+*    Clears the counters and the classifier and applies the base plan.
+*******************************************************************************/
+void rateReset(void)
+{
+    uint8_t motion;
+
+    gb_running = 0;
+    g_motion   = RATE_WALKING;
+    g_battery  = RATE_BATTERY_OK;
+    g_gravity  = 0;
+    g_heading  = -1;
+
+    for (motion = 0; motion < RATE_MOTIONS; motion++)
+    {
+        g_stats.timeMs[motion] = 0;
+    }
+    g_stats.changes   = 0;
+    g_stats.savedUaMs = 0;
+
+    usePlan(&PLANS[RATE_WALKING][RATE_BATTERY_OK]);
+}
+
+/*******************************************************************************
+* Function Name: rateStart
+********************************************************************************
+* Summary:
+*    A walk starts at full rate: the user is about to move. Gravity is
+*    learnt again from the first sample, the device may have been put down.
+*******************************************************************************/
+void rateStart(uint32_t now_ms)
+{
+    g_motion      = RATE_WALKING;
+    g_gravity     = 0;
+    g_heading     = -1;
+    g_last_motion = now_ms;
+    g_mark        = now_ms;
+    gb_running    = 1;
+
+    usePlan(&PLANS[RATE_WALKING][g_battery]);
+}
+
+/*******************************************************************************
+* Function Name: rateStop
+********************************************************************************
+* Summary:
+*    Counts up to now and goes back to the base plan.
+*******************************************************************************/
+void rateStop(uint32_t now_ms)
+{
+    if (gb_running)
+    {
+        account(now_ms);
+        gb_running = 0;
+    }
+    g_motion = RATE_WALKING;
+    usePlan(&PLANS[RATE_WALKING][RATE_BATTERY_OK]);
+}
+
+/*******************************************************************************
+* Function Name: rateUpdate
+********************************************************************************
+* Summary:
+*    Counts the time spent in the plan so far, classifies the sample and
+*    switches to the plan of the motion and battery band. A step or turn
+*    makes the user walking at once; stationary needs RATE_STILL_MS without
+*    one.
+*******************************************************************************/
+uint8_t rateUpdate(uint32_t magnitude_mg, int16_t heading_deg,
+    uint8_t level_pct, uint32_t now_ms)
+{
+    uint32_t gravity;
+    uint32_t deviation;
+    int16_t  turn;
+
+    if (gb_running)
+    {
+        account(now_ms);
+    }
+
+    /* Steps: magnitude away from its slow average */
+    if (0 == g_gravity)
+    {
+        g_gravity = magnitude_mg << RATE_GRAVITY_SHIFT;
+    }
+    gravity = g_gravity >> RATE_GRAVITY_SHIFT;
+    deviation = (magnitude_mg > gravity) ? magnitude_mg - gravity : gravity - magnitude_mg;
+    g_gravity += magnitude_mg - gravity;
+
+    /* Turns: heading change, the short way round */
+    turn = 0;
+    if (g_heading >= 0)
+    {
+        turn = (int16_t)(heading_deg - g_heading);
+        if (turn > 180)   turn -= 360;
+        if (turn < -180)  turn += 360;
+        if (turn < 0)     turn = (int16_t)-turn;
+    }
+    g_heading = heading_deg;
+
+    if (deviation >= RATE_WALK_MG || turn >= RATE_TURN_DEG)
+    {
+        g_last_motion = now_ms;
+    }
+    g_motion = (now_ms - g_last_motion < RATE_STILL_MS) ? RATE_WALKING : RATE_STATIONARY;
+
+    if (level_pct < RATE_BATTERY_CRITICAL_PCT)
+    {
+        g_battery = RATE_BATTERY_CRITICAL;
+    }
+    else if (level_pct < RATE_BATTERY_LOW_PCT)
+    {
+        g_battery = RATE_BATTERY_LOW;
+    }
+    else
+    {
+        g_battery = RATE_BATTERY_OK;
+    }
+
+    return usePlan(&PLANS[g_motion][g_battery]);
+}
+
+/*******************************************************************************
+* Function Name: ratePeriod
+********************************************************************************
+* Summary:
+*    Period of a loop, a single word read.
+*******************************************************************************/
+uint32_t ratePeriod(rateLoop loop)
+{
+    return (loop < RATE_LOOPS) ? g_period[loop] : 0;
+}
+
+/*******************************************************************************
+* Function Name: rateMotionNow
+********************************************************************************
+* Summary:
+*    Current motion.
+*******************************************************************************/
+rateMotion rateMotionNow(void)
+{
+    return g_motion;
+}
+
+/*******************************************************************************
+* Function Name: rateBatteryNow
+********************************************************************************
+* Summary:
+*    Current battery band.
+*******************************************************************************/
+rateBattery rateBatteryNow(void)
+{
+    return g_battery;
+}
+
+/*******************************************************************************
+* Function Name: rateSavedUa
+********************************************************************************
+* Summary:
+*    Each loop costs its base current times base period / period.
+*******************************************************************************/
+uint32_t rateSavedUa(const ratePlan *p_plan)
+{
+    static const uint32_t BASE_MS[RATE_LOOPS] = {
+        RATE_GPS_BASE_MS, RATE_COMPASS_BASE_MS, RATE_SONAR_BASE_MS, RATE_SOUND_BASE_MS
+    };
+    uint32_t saved = 0;
+    uint8_t  loop;
+
+    for (loop = 0; loop < RATE_LOOPS; loop++)
+    {
+        if (p_plan->periodMs[loop] > BASE_MS[loop])
+        {
+            saved += LOOP_UA[loop] - LOOP_UA[loop] * BASE_MS[loop] / p_plan->periodMs[loop];
+        }
+    }
+    return saved;
+}
+
+/*******************************************************************************
+* Function Name: rateGetPlan
+********************************************************************************
+* Summary:
+*    Copies the current plan.
+*******************************************************************************/
+void rateGetPlan(ratePlan *p_plan)
+{
+    uint8_t loop;
+
+    for (loop = 0; loop < RATE_LOOPS; loop++)
+    {
+        p_plan->periodMs[loop] = g_period[loop];
+    }
+}
+
+/*******************************************************************************
+* Function Name: rateGetStats
+********************************************************************************
+* Summary:
+*    Copies the counters and adds the time since the last sample, spent in
+*    the current plan.
+*******************************************************************************/
+void rateGetStats(rateStats *p_stats, uint32_t now_ms)
+{
+    ratePlan plan;
+    uint32_t elapsed;
+
+    *p_stats = g_stats;
+    if (gb_running)
+    {
+        rateGetPlan(&plan);
+        elapsed = now_ms - g_mark;
+        p_stats->timeMs[g_motion] += elapsed;
+        p_stats->savedUaMs += (uint64_t)elapsed * rateSavedUa(&plan);
+    }
+}
+
+/*******************************************************************************
+* Function Name: account
+********************************************************************************
+* Summary:
+*    Time since the last mark went to the current motion and plan.
+*******************************************************************************/
+static void account(uint32_t now_ms)
+{
+    ratePlan plan;
+    uint32_t elapsed = now_ms - g_mark;
+
+    rateGetPlan(&plan);
+    g_stats.timeMs[g_motion] += elapsed;
+    g_stats.savedUaMs += (uint64_t)elapsed * rateSavedUa(&plan);
+    g_mark = now_ms;
+}
+
+/*******************************************************************************
+* Function Name: usePlan
+********************************************************************************
+* Summary:
+*    Writes the plan a word at a time, readers may see a mix of the old and
+*    new plan for one period, which is harmless.
+*******************************************************************************/
+static uint8_t usePlan(const ratePlan *p_plan)
+{
+    uint8_t changed = 0;
+    uint8_t loop;
+
+    for (loop = 0; loop < RATE_LOOPS; loop++)
+    {
+        if (g_period[loop] != p_plan->periodMs[loop])
+        {
+            g_period[loop] = p_plan->periodMs[loop];
+            changed = 1;
+        }
+    }
+    if (changed)
+    {
+        g_stats.changes++;
+    }
+    return changed;
+}
+
+#if RATE_HOST == 1
+/*******************************************************************************
+* Function Name: rateSimulate
+********************************************************************************
+* Summary:
+*    The user walks for 60 s, then stands for 30 s, in turns, with a turn on
+*    the spot half way through every stop. Walking adds a triangle wave of
+*    +-300 mg to 1 g, one cycle per stride of 480 .. 560 ms (a stride of
+*    exactly a sample period would alias to a constant). Every sample has
+*    +-40 mg of noise and +-3 degrees of heading noise, from a linear
+*    congruential generator. Samples are taken at the compass period of the
+*    plan, as on the board.
+*******************************************************************************/
+void rateSimulate(uint32_t duration_ms, uint8_t level_pct, rateSimResult *p_result)
+{
+    const uint32_t walk_ms = 60000u;
+    const uint32_t stand_ms = 30000u;
+    uint32_t seed = 1;
+    uint32_t now = 0;
+    uint32_t step;
+    uint32_t stride_start = 0;
+    uint32_t stride_ms = 500;
+    uint32_t phase;
+    uint32_t correct = 0;
+    uint32_t walk_start = 0;
+    uint8_t  waking = 0;
+    uint32_t period;
+    int32_t  magnitude;
+    int32_t  heading;
+    uint8_t  walking;
+    uint8_t  was_walking = 1;
+    rateStats stats;
+
+    p_result->samples     = 0;
+    p_result->worstWakeMs = 0;
+
+    rateReset();
+    rateStart(0);
+
+    while (now < duration_ms)
+    {
+        phase = now % (walk_ms + stand_ms);
+        walking = (phase < walk_ms);
+
+        magnitude = 1000;
+        heading = 90;
+        if (walking)
+        {
+            while (now - stride_start >= stride_ms)
+            {
+                stride_start += stride_ms;
+                seed = seed * 1103515245u + 12345u;
+                stride_ms = 480u + (seed >> 16) % 81u;
+            }
+            step = (now - stride_start) * 500u / stride_ms;
+            magnitude += (step < 250u) ? (int32_t)step * 600 / 250 - 300
+                                       : 300 - (int32_t)(step - 250u) * 600 / 250;
+            if (!was_walking)
+            {
+                walk_start = now - phase;
+                waking = 1;
+            }
+        }
+        else if (phase >= walk_ms + stand_ms / 2)
+        {
+            heading = 180;      // turned round on the spot
+        }
+
+        seed = seed * 1103515245u + 12345u;
+        magnitude += (int32_t)((seed >> 16) % 81u) - 40;
+        seed = seed * 1103515245u + 12345u;
+        heading += (int32_t)((seed >> 16) % 7u) - 3;
+
+        rateUpdate((uint32_t)magnitude, (int16_t)heading, level_pct, now);
+        p_result->samples++;
+
+        if (waking && RATE_WALKING == g_motion && ratePeriod(RATE_SONAR) == RATE_SONAR_BASE_MS)
+        {
+            if (now - walk_start > p_result->worstWakeMs)
+            {
+                p_result->worstWakeMs = now - walk_start;
+            }
+            waking = 0;
+        }
+
+        was_walking = walking;
+        period = ratePeriod(RATE_COMPASS);
+        if ((uint8_t)(RATE_WALKING == g_motion) == walking)
+        {
+            correct += period;
+        }
+        now += period;
+    }
+
+    rateStop(now);
+    rateGetStats(&stats, now);
+    p_result->correctPct = correct * 100u / now;
+    p_result->savedUa = (uint32_t)(stats.savedUaMs / now);
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,210 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     rate_policy.h
+* Version:  1.0.0
+*
+* Brief: Adaptive rate policy: scales the GPS, compass, sonar and sound loop
+*        periods with the user's motion and the battery charge.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    Motion is classified from each accelerometer sample the compass loop
+*    reads. The magnitude is compared with a slow average of it (gravity);
+*    a deviation of RATE_WALK_MG or more is a step. A heading change of
+*    RATE_TURN_DEG or more between samples counts as motion too, so turning
+*    on the spot restores full rate. The user is walking from the first step
+*    and stationary once RATE_STILL_MS pass without one: fast to speed up,
+*    slow to slow down.
+*
+*    The battery band comes from the fuel gauge level: low below
+*    RATE_BATTERY_LOW_PCT, critical below RATE_BATTERY_CRITICAL_PCT.
+*
+*    Each motion and battery band pair has a rate plan, one period per loop:
+*      gps     - shortest time between GGA fixes used (the receiver sends
+*                one a second, sentences in between are read and dropped),
+*      compass - direction loop period, which also samples the classifier,
+*      sonar   - sonar slot length (sonarSchedulePace()),
+*      sound   - sound cue update period.
+*    Sonar keeps its full rate whenever the user walks, whatever the battery.
+*
+*    Savings are estimated per loop as RATE_*_UA, the current the loop costs
+*    at its base period, scaled with the period. They are estimates from
+*    the component datasheets and the loop execution times; measure them on
+*    the board before trusting the totals.
+*
+*    Only depends on <stdint.h>. Build with RATE_HOST = 1 to add a simulated
+*    walk with stops on the host.
+*
+*******************************************************************************/
+#ifndef RATE_POLICY_H
+	#define RATE_POLICY_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+    #ifndef RATE_HOST
+        #define RATE_HOST 0
+    #endif
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* Deviation from gravity that is a step (mg) */
+    #define RATE_WALK_MG                150
+
+    /* Heading change between samples that is a turn (degrees) */
+    #define RATE_TURN_DEG               20
+
+    /* Time without a step or turn before the user is stationary (ms) */
+    #define RATE_STILL_MS               4000
+
+    /* Gravity average weight 1 / 2^shift per sample */
+    #define RATE_GRAVITY_SHIFT          4
+
+    /* Battery bands (%) */
+    #define RATE_BATTERY_LOW_PCT        30
+    #define RATE_BATTERY_CRITICAL_PCT   15
+
+    /* Base periods, the full rate plan (ms) */
+    #define RATE_GPS_BASE_MS            1000
+    #define RATE_COMPASS_BASE_MS        250
+    #define RATE_SONAR_BASE_MS          100
+    #define RATE_SOUND_BASE_MS          250
+
+    /* Estimated current of each loop at its base period (uA) */
+    #define RATE_GPS_UA                 100     // GGA parse and double maths
+    #define RATE_COMPASS_UA             500     // 12 I2C register reads, calibration, atan2
+    #define RATE_SONAR_UA               3000    // ranging share of three HRLV sensors
+    #define RATE_SOUND_UA               300     // ITD / IID maths, wave table rewrite
+
+/*******************************************************************************
+*   Enumerations
+*******************************************************************************/
+    // What the user is doing.
+    typedef enum rateMotion{
+        RATE_STATIONARY = 0,
+        RATE_WALKING,
+        RATE_MOTIONS
+    } rateMotion;
+
+    // Battery band.
+    typedef enum rateBattery{
+        RATE_BATTERY_OK = 0,
+        RATE_BATTERY_LOW,
+        RATE_BATTERY_CRITICAL,
+        RATE_BATTERY_BANDS
+    } rateBattery;
+
+    // Loops with a scaled period.
+    typedef enum rateLoop{
+        RATE_GPS = 0,
+        RATE_COMPASS,
+        RATE_SONAR,
+        RATE_SOUND,
+        RATE_LOOPS
+    } rateLoop;
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+    // Period of each loop (ms), indexed by rateLoop.
+    typedef struct ratePlan{
+        uint32_t periodMs[RATE_LOOPS];
+    } ratePlan;
+
+    // Policy counters while running.
+    typedef struct rateStats{
+        uint32_t timeMs[RATE_MOTIONS];  // time classified in each motion
+        uint32_t changes;               // plan changes
+        uint64_t savedUaMs;             // estimated saving, uA * ms
+    } rateStats;
+
+    #if RATE_HOST == 1
+        // Result of a simulated walk.
+        typedef struct rateSimResult{
+            uint32_t samples;           // classifier samples taken
+            uint32_t correctPct;        // time classified right (%)
+            uint32_t worstWakeMs;       // walking start to full rate, worst
+            uint32_t savedUa;           // mean estimated saving (uA)
+        } rateSimResult;
+    #endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    // Brief: Clear the counters and the classifier, back to the base plan.
+    // Param: none.
+    // Return: none
+    void rateReset(void);
+
+    // Brief: Start running: walking on the base plan from now.
+    // Param: now_ms Time.
+    // Return: none
+    void rateStart(uint32_t now_ms);
+
+    // Brief: Stop running and go back to the base plan.
+    // Param: now_ms Time, counted up to here.
+    // Return: none
+    void rateStop(uint32_t now_ms);
+
+    // Brief: Add a sample and pick the plan.
+    // Param: magnitude_mg Acceleration magnitude, heading_deg Compass
+    //        heading 0 .. 359, level_pct Battery level, now_ms Time.
+    // Return: uint8_t 1 if the plan changed.
+    uint8_t rateUpdate(uint32_t magnitude_mg, int16_t heading_deg,
+        uint8_t level_pct, uint32_t now_ms);
+
+    // Brief: Period of a loop in the current plan.
+    // Param: loop Loop.
+    // Return: uint32_t Period (ms).
+    uint32_t ratePeriod(rateLoop loop);
+
+    // Brief: Current motion.
+    // Param: none.
+    // Return: rateMotion Motion, walking while not running.
+    rateMotion rateMotionNow(void);
+
+    // Brief: Current battery band.
+    // Param: none.
+    // Return: rateBattery Band.
+    rateBattery rateBatteryNow(void);
+
+    // Brief: Estimated saving of a plan against the base plan.
+    // Param: p_plan Plan.
+    // Return: uint32_t Current (uA).
+    uint32_t rateSavedUa(const ratePlan *p_plan);
+
+    // Brief: Copy the current plan.
+    // Param: p_plan Filled with the plan.
+    // Return: none
+    void rateGetPlan(ratePlan *p_plan);
+
+    // Brief: Copy the counters, including the time in the current plan so far.
+    // Param: p_stats Filled with the counters, now_ms Time.
+    // Return: none
+    void rateGetStats(rateStats *p_stats, uint32_t now_ms);
+
+    #if RATE_HOST == 1
+        // Brief: Walk and stand in turns with simulated steps, sensor noise
+        //        and turns on the spot, sampling at the compass period the
+        //        plan picks.
+        // Param: duration_ms Simulated time, level_pct Battery level,
+        //        p_result Statistics of the run.
+        // Return: none
+        void rateSimulate(uint32_t duration_ms, uint8_t level_pct, rateSimResult *p_result);
+    #endif
+
+#endif
+
+/* [] END OF FILE */
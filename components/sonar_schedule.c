@@ -0,0 +1,382 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     sonar_schedule.c
+* Version:  1.0.0
+*
+* Brief: Trigger scheduler for the HRLV-MaxSonar ultrasonic array.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Source:
+*    Range cycle and chaining from the HRLV-MaxSonar-EZ datasheet
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "sonar_schedule.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* Sound travels 343 m/s: an echo delay of 1 ms is 17.15 cm of range */
+#define SIM_CM_PER_MS_X100  1715
+
+/* Built in trigger patterns, bit n = sensor n */
+static const uint8_t SLOTS_TOGETHER[]    = { 0x07 };
+static const uint8_t SLOTS_CHAIN[]       = { 0x01, 0x02, 0x04 };
+static const uint8_t SLOTS_INTERLEAVED[] = { 0x05, 0x02 };
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+/* Running pattern */
+static uint8_t  g_slots[SONAR_MAX_SLOTS];
+
+/* Number of slots in the running pattern */
+static uint8_t  g_slot_count;
+
+/* Next slot to fire */
+static uint8_t  g_slot;
+
+/* Time between slots in ms */
+static uint32_t g_slot_ms;
+
+/* Shortest time between slots the pattern allows, and the pace asked for */
+static uint32_t g_min_slot_ms;
+static uint32_t g_pace_ms = 0;
+
+/* Time the next slot fires */
+static uint32_t g_next_slot;
+
+/* Boolean flag whether the first slot has fired */
+static uint8_t  gb_running;
+
+/* Sensors triggered but not read yet */
+static uint8_t  g_unread;
+
+/* Time each sensor was last triggered */
+static uint32_t g_trigger_time[SONAR_SENSORS];
+
+#if SONAR_HOST == 1
+    /* True distance in front of each simulated sensor (cm) */
+    static uint16_t g_sim_cm[SONAR_SENSORS];
+#endif
+
+/*******************************************************************************
+* Function Name: sonarScheduleStart
+********************************************************************************
+* Summary:
+*    Starts one of the built in trigger patterns.
+*******************************************************************************/
+void sonarScheduleStart(sonarPolicy policy)
+{
+    switch (policy)
+    {
+        case SONAR_CHAIN:
+            sonarScheduleCustom(SLOTS_CHAIN, sizeof(SLOTS_CHAIN));
+            break;
+        case SONAR_INTERLEAVED:
+            sonarScheduleCustom(SLOTS_INTERLEAVED, sizeof(SLOTS_INTERLEAVED));
+            break;
+        default:
+            sonarScheduleCustom(SLOTS_TOGETHER, sizeof(SLOTS_TOGETHER));
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: sonarScheduleCustom
+********************************************************************************
+* Summary:
+*    Starts a trigger pattern. The slot length is the shortest that keeps
+*    slots SONAR_LISTEN_MS apart and lets every sensor finish its range cycle
+*    before it is triggered again, which gives the highest update rate the
+*    pattern allows.
+*******************************************************************************/
+void sonarScheduleCustom(const uint8_t *slots, uint8_t count)
+{
+    uint8_t min_gap = SONAR_MAX_SLOTS;
+    uint8_t last[SONAR_SENSORS];
+    uint8_t sensor;
+    uint8_t i;
+
+    if (count > SONAR_MAX_SLOTS)
+    {
+        count = SONAR_MAX_SLOTS;
+    }
+    if (0 == count)
+    {
+        slots = SLOTS_TOGETHER;
+        count = 1;
+    }
+
+    /* Fewest slots between two triggers of the same sensor */
+    for (sensor = 0; sensor < SONAR_SENSORS; sensor++)
+    {
+        last[sensor] = 0xFF;
+    }
+    for (i = 0; i < 2 * count; i++)
+    {
+        for (sensor = 0; sensor < SONAR_SENSORS; sensor++)
+        {
+            if (slots[i % count] & (1u << sensor))
+            {
+                if (last[sensor] != 0xFF && (i - last[sensor]) < min_gap)
+                {
+                    min_gap = i - last[sensor];
+                }
+                last[sensor] = i;
+            }
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        g_slots[i] = slots[i];
+    }
+    g_slot_count = count;
+
+    g_min_slot_ms = (SONAR_RANGE_CYCLE_MS + min_gap - 1) / min_gap;
+    if (g_min_slot_ms < SONAR_LISTEN_MS)
+    {
+        g_min_slot_ms = SONAR_LISTEN_MS;
+    }
+    g_slot_ms = (g_pace_ms > g_min_slot_ms) ? g_pace_ms : g_min_slot_ms;
+
+    g_slot = 0;
+    g_unread = 0;
+    gb_running = 0;
+}
+
+/*******************************************************************************
+* Function Name: sonarSchedulePace
+********************************************************************************
+* Summary:
+*    Sets the slot length, never below the shortest the pattern allows. The
+*    slot already scheduled keeps its time, the new length applies from the
+*    one after. Longer slots only delay triggers, so no sensor is triggered
+*    before its range cycle is over or heard by another.
+*******************************************************************************/
+void sonarSchedulePace(uint32_t slot_ms)
+{
+    g_pace_ms = slot_ms;
+    g_slot_ms = (slot_ms > g_min_slot_ms) ? slot_ms : g_min_slot_ms;
+}
+
+/*******************************************************************************
+* Function Name: sonarSlotMs
+********************************************************************************
+* Summary:
+*    Returns the slot length of the running pattern.
+*******************************************************************************/
+uint32_t sonarSlotMs(void)
+{
+    return g_slot_ms;
+}
+
+/*******************************************************************************
+* Function Name: sonarMsToNextSlot
+********************************************************************************
+* Summary:
+*    Returns the time until the next slot fires, so the caller can sleep
+*    until then instead of calling sonarScheduleTick() every ms.
+*******************************************************************************/
+uint32_t sonarMsToNextSlot(uint32_t now)
+{
+    if (!gb_running || (int32_t)(g_next_slot - now) <= 0)
+    {
+        return 0;
+    }
+
+    return g_next_slot - now;
+}
+
+/*******************************************************************************
+* Function Name: sonarScheduleTick
+********************************************************************************
+* Summary:
+*    Fires the next slot when it is due. Sensors whose range cycle has
+*    finished are read in the same slot, before any of them is triggered
+*    again, so their outputs are sampled together with one ADC sequence.
+*******************************************************************************/
+uint8_t sonarScheduleTick(uint32_t now, uint8_t *p_read_mask)
+{
+    uint8_t mask;
+    uint8_t sensor;
+
+    *p_read_mask = 0;
+
+    if (!gb_running)
+    {
+        gb_running = 1;
+        g_next_slot = now;
+    }
+
+    if ((int32_t)(now - g_next_slot) < 0)
+    {
+        return 0;
+    }
+
+    for (sensor = 0; sensor < SONAR_SENSORS; sensor++)
+    {
+        if ((g_unread & (1u << sensor)) &&
+            (now - g_trigger_time[sensor]) >= SONAR_RANGE_CYCLE_MS)
+        {
+            *p_read_mask |= (1u << sensor);
+        }
+    }
+    g_unread &= ~*p_read_mask;
+
+    mask = g_slots[g_slot];
+    for (sensor = 0; sensor < SONAR_SENSORS; sensor++)
+    {
+        if (mask & (1u << sensor))
+        {
+            g_trigger_time[sensor] = now;
+        }
+    }
+    g_unread |= mask;
+
+    g_slot = (g_slot + 1) % g_slot_count;
+    g_next_slot += g_slot_ms;
+
+    return mask;
+}
+
+/*******************************************************************************
+* Function Name: sonarTriggerTime
+********************************************************************************
+* Summary:
+*    Returns the time a sensor was last triggered.
+*******************************************************************************/
+uint32_t sonarTriggerTime(uint8_t sensor)
+{
+    return (sensor < SONAR_SENSORS) ? g_trigger_time[sensor] : 0;
+}
+
+#if SONAR_HOST == 1
+/*******************************************************************************
+* Function Name: sonarSimSetDistance
+********************************************************************************
+* Summary:
+*    Sets the true distance in front of a simulated sensor.
+*******************************************************************************/
+void sonarSimSetDistance(uint8_t sensor, uint16_t cm)
+{
+    if (sensor < SONAR_SENSORS)
+    {
+        g_sim_cm[sensor] = cm;
+    }
+}
+
+/*******************************************************************************
+* Function Name: sonarSimulate
+********************************************************************************
+* Summary:
+*    Runs the running pattern for duration_ms against simulated sensors. A
+*    sensor reports the first echo it hears while listening: its own, or the
+*    echo of a ping from a sensor it can hear, which arrives earlier or later
+*    by the time between the two triggers.
+*******************************************************************************/
+void sonarSimulate(uint32_t duration_ms, sonarCrosstalk crosstalk,
+    sonarSimResult *p_result)
+{
+    /* Last two trigger times of each sensor, for pings still in the air */
+    int32_t  history[SONAR_SENSORS][2];
+    uint8_t  history_count[SONAR_SENSORS] = { 0 };
+    uint32_t last_read[SONAR_SENSORS] = { 0 };
+    uint32_t now;
+    uint8_t  trigger;
+    uint8_t  read;
+    uint8_t  sensor;
+    uint8_t  other;
+    uint8_t  i;
+    int32_t  t0;
+    int32_t  heard;
+    int32_t  apparent;
+
+    p_result->readings   = 0;
+    p_result->corrupted  = 0;
+    p_result->worstAgeMs = 0;
+
+    g_slot = 0;
+    g_unread = 0;
+    gb_running = 0;
+
+    for (now = 0; now < duration_ms; now++)
+    {
+        trigger = sonarScheduleTick(now, &read);
+
+        for (sensor = 0; sensor < SONAR_SENSORS; sensor++)
+        {
+            if (trigger & (1u << sensor))
+            {
+                history[sensor][0] = history[sensor][1];
+                history[sensor][1] = (int32_t)now;
+                if (history_count[sensor] < 2)
+                {
+                    history_count[sensor]++;
+                }
+            }
+        }
+
+        for (sensor = 0; sensor < SONAR_SENSORS; sensor++)
+        {
+            if (!(read & (1u << sensor)))
+            {
+                continue;
+            }
+
+            /* Trigger this reading belongs to (a new one may have just fired) */
+            t0 = (trigger & (1u << sensor)) ? history[sensor][0] : history[sensor][1];
+            heard = g_sim_cm[sensor];
+
+            for (other = 0; other < SONAR_SENSORS; other++)
+            {
+                if ((other == sensor) || (SONAR_SIM_NO_CROSSTALK == crosstalk) ||
+                    ((SONAR_SIM_ADJACENT == crosstalk) && (other + 1 != sensor) &&
+                     (sensor + 1 != other)))
+                {
+                    continue;
+                }
+
+                for (i = 2 - history_count[other]; i < 2; i++)
+                {
+                    if (history[other][i] < t0 - SONAR_LISTEN_MS ||
+                        history[other][i] >= t0 + SONAR_LISTEN_MS)
+                    {
+                        continue;
+                    }
+                    apparent = g_sim_cm[other] +
+                        ((history[other][i] - t0) * SIM_CM_PER_MS_X100) / 100;
+                    if (apparent > 0 && apparent < heard)
+                    {
+                        heard = apparent;
+                    }
+                }
+            }
+
+            p_result->readings++;
+            if (heard != g_sim_cm[sensor])
+            {
+                p_result->corrupted++;
+            }
+            if (last_read[sensor] && (now - last_read[sensor]) > p_result->worstAgeMs)
+            {
+                p_result->worstAgeMs = now - last_read[sensor];
+            }
+            last_read[sensor] = now;
+        }
+    }
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,151 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     sonar_schedule.h
+* Version:  1.0.0
+*
+* Brief: Trigger scheduler for the HRLV-MaxSonar ultrasonic array.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*    Sensors are fired in slots. Each slot triggers a set of sensors (bit n =
+*    sensor n) and lasts at least SONAR_LISTEN_MS, so sensors in different
+*    slots never hear each other's pings. Slots are stretched when needed so
+*    no sensor is triggered again before its SONAR_RANGE_CYCLE_MS range cycle
+*    has finished. A sensor's output is read once its range cycle is over.
+*
+*    Policies:
+*      SONAR_TOGETHER    - all sensors in one slot (single shared RX line).
+*      SONAR_CHAIN       - one sensor per slot, in order.
+*      SONAR_INTERLEAVED - outer sensors together, then the centre sensor.
+*    Any other pattern can be set with sonarScheduleCustom().
+*
+*    Only depends on <stdint.h>. Build with SONAR_HOST = 1 to add a sensor
+*    simulation with crosstalk for comparing policies on the host
+*    (tests/host_sim.c runs it).
+*
+*******************************************************************************/
+#ifndef SONAR_SCHEDULE_H
+	#define SONAR_SCHEDULE_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #include <stdint.h>
+
+    #ifndef SONAR_HOST
+        #define SONAR_HOST 0
+    #endif
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* Number of sensors in the array */
+    #define SONAR_SENSORS           3
+
+    /* Time from trigger until a sensor's analog output is updated (ms) */
+    #define SONAR_RANGE_CYCLE_MS    100
+
+    /* Time a ping can be heard after a trigger, 5 m round trip + ring down (ms) */
+    #define SONAR_LISTEN_MS         50
+
+    /* Most slots in a schedule */
+    #define SONAR_MAX_SLOTS         SONAR_SENSORS
+
+/*******************************************************************************
+*   Enumerations
+*******************************************************************************/
+    // Built in trigger patterns.
+    typedef enum sonarPolicy{
+        SONAR_TOGETHER = 0,
+        SONAR_CHAIN,
+        SONAR_INTERLEAVED
+    } sonarPolicy;
+
+    #if SONAR_HOST == 1
+        // Which simulated sensors can hear each other's pings.
+        typedef enum sonarCrosstalk{
+            SONAR_SIM_NO_CROSSTALK = 0,
+            SONAR_SIM_ADJACENT,         // neighbouring sensors only
+            SONAR_SIM_ALL               // every sensor hears every other
+        } sonarCrosstalk;
+    #endif
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+    #if SONAR_HOST == 1
+        // Result of a simulated run.
+        typedef struct sonarSimResult{
+            uint32_t readings;      // sensor readings delivered
+            uint32_t corrupted;     // readings shortened by crosstalk
+            uint32_t worstAgeMs;    // oldest reading age when replaced
+        } sonarSimResult;
+    #endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    // Brief: Start one of the built in trigger patterns.
+    // Param: policy Trigger pattern.
+    // Return: none
+    void sonarScheduleStart(sonarPolicy policy);
+
+    // Brief: Start a custom trigger pattern.
+    // Param: slots Sensor mask of each slot, count Number of slots.
+    // Return: none
+    void sonarScheduleCustom(const uint8_t *slots, uint8_t count);
+
+    // Brief: Stretch the slots of the running pattern to save power.
+    // Param: slot_ms Slot length wanted, 0 or anything below the shortest
+    //        the pattern allows gives the shortest.
+    // Return: none
+    void sonarSchedulePace(uint32_t slot_ms);
+
+    // Brief: Slot length of the running pattern.
+    // Param: none.
+    // Return: uint32_t ms between slots.
+    uint32_t sonarSlotMs(void);
+
+    // Brief: Time until the next slot fires.
+    // Param: now Time in ms.
+    // Return: uint32_t ms to the next slot, 0 if it is due or the schedule
+    //         has not fired its first slot yet.
+    uint32_t sonarMsToNextSlot(uint32_t now);
+
+    // Brief: Advance the schedule, call once per ms.
+    // Param: now Time in ms, p_read_mask Set to the sensors whose range cycle
+    //        has finished and should be read now.
+    // Return: uint8_t Mask of sensors to trigger now (0 between slots).
+    uint8_t sonarScheduleTick(uint32_t now, uint8_t *p_read_mask);
+
+    // Brief: Time a sensor was last triggered.
+    // Param: sensor Sensor number.
+    // Return: uint32_t Trigger time in ms.
+    uint32_t sonarTriggerTime(uint8_t sensor);
+
+    #if SONAR_HOST == 1
+        // Brief: Set the true distance in front of a simulated sensor.
+        // Param: sensor Sensor number, cm Distance in cm.
+        // Return: none
+        void sonarSimSetDistance(uint8_t sensor, uint16_t cm);
+
+        // Brief: Run the running pattern against simulated sensors.
+        // Param: duration_ms Simulated time, crosstalk Which sensors hear each
+        //        other's pings, p_result Statistics of the run.
+        // Return: none
+        void sonarSimulate(uint32_t duration_ms, sonarCrosstalk crosstalk,
+            sonarSimResult *p_result);
+    #endif
+
+#endif
+
+/* [] END OF FILE */
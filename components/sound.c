@@ -229,6 +229,45 @@ void startSoundComponents(void)
     DDS24_1_Start();
 }
 
+/*******************************************************************************
+* Function Name: soundPowerDown
+********************************************************************************
+* Summary:
+*    stops the DDS, both DMA channels, VDACs and opamps. The DDS frequency,
+*    DMA descriptors and sine tables are kept for soundPowerUp().
+*******************************************************************************/
+void soundPowerDown(void)
+{
+    DDS24_1_Stop();
+    CyDmaChDisable(DMA_1_Chan);
+    CyDmaChDisable(DMA_2_Chan);
+    Opamp_1_Stop();
+    Opamp_2_Stop();
+    VDAC8_1_Stop();
+    VDAC8_2_Stop();
+}
+
+/*******************************************************************************
+* Function Name: soundPowerUp
+********************************************************************************
+* Summary:
+*    restarts what soundPowerDown() stopped. The DMA channels restart from
+*    the top of their sine tables; DDS24_1_Enable() keeps the frequency set
+*    (Start would reset it to the preset).
+*******************************************************************************/
+void soundPowerUp(void)
+{
+    VDAC8_1_Start();
+    VDAC8_2_Start();
+    Opamp_1_Start();
+    Opamp_2_Start();
+    CyDmaChSetInitialTd(DMA_1_Chan, DMA_1_TD[0]);
+    CyDmaChSetInitialTd(DMA_2_Chan, DMA_2_TD[0]);
+    CyDmaChEnable(DMA_1_Chan, 1);
+    CyDmaChEnable(DMA_2_Chan, 1);
+    DDS24_1_Enable();
+}
+
 /*******************************************************************************
 * Function Name: dmaConfiguration
 ********************************************************************************
@@ -52,6 +52,16 @@
 // Return: none 
 void startSoundComponents(void);
 
+// Brief: Stops the sound peripherals and DMA, settings are kept.
+// Param:  none.
+// Return: none 
+void soundPowerDown(void);
+
+// Brief: Restarts the sound peripherals and DMA after soundPowerDown().
+// Param:  none.
+// Return: none 
+void soundPowerUp(void);
+
 // Brief: Sets up DMA configs.
 // Param:  none.
 // Return: none 
@@ -0,0 +1,356 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     speech_store.c
+* Version:  1.0.0
+*
+* Brief: Streaming LPC speech asset store in external SPI flash / FRAM.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*    - SPI_Master     [SPIM_Flash]
+*    - cy_pins        [Pin_Flash_CS]
+*
+* Notes:
+*    Uses the plain READ (0x03) command with a 24-bit address, which is
+*    supported by both SPI NOR flash and SPI FRAM parts. Pin_Flash_CS is driven
+*    manually so that chip select stays low across the whole transfer.
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include "speech_store.h"
+
+#if SPEECH_STORE_MODE == 1
+
+#if SPEECH_STORE_HOST == 1
+    #include <stdio.h>
+#endif
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+/* SPI flash / FRAM read command */
+#define STORE_CMD_READ      0x03
+
+/* Image header size in bytes */
+#define STORE_HEADER_SIZE   8
+
+/*******************************************************************************
+*   Private Function Declarations
+*******************************************************************************/
+
+// Brief: Read a block of bytes from the image.
+// Param: address Image address, buffer Destination, length Number of bytes.
+// Return: none
+static void storeRead(uint32_t address, uint8_t *buffer, uint16_t length);
+
+// Brief: Fill one prefetch buffer from the current fetch address.
+// Param: buffer_number Buffer to fill (0 or 1).
+// Return: none
+static void fillBuffer(uint8_t buffer_number);
+
+/*******************************************************************************
+*   Variable definitions
+*******************************************************************************/
+#if SPEECH_STORE_HOST == 1
+    /* Image file standing in for the external memory */
+    static FILE *gp_image;
+#endif
+
+/* Prefetch buffers */
+static uint8_t  g_buffer[2][SPEECH_STORE_BUFFER_SIZE];
+
+/* Number of valid bytes in each prefetch buffer */
+static uint8_t  g_buffer_length[2];
+
+/* Buffer currently read by the decoder */
+static uint8_t  g_front;
+
+/* Read position inside the front buffer */
+static uint8_t  g_position;
+
+/* Boolean flag whether the back buffer holds the next bytes */
+static uint8_t  gb_back_ready;
+
+/* Image address of the next byte to fetch */
+static uint32_t g_fetch_address;
+
+/* Bytes of the open utterance not yet fetched */
+static uint32_t g_fetch_remaining;
+
+/* Boolean flag whether a valid image header was found */
+static uint8_t  gb_store_valid;
+
+/* Number of language banks in the image */
+static uint8_t  g_language_count;
+
+/* Number of utterances in each language bank */
+static uint16_t g_utterance_count;
+
+/* Selected language bank */
+static uint8_t  g_language;
+
+/* Reads that found the back buffer empty */
+static uint32_t g_stalls;
+
+#if SPEECH_STORE_HOST == 1
+/*******************************************************************************
+* Function Name: speechStoreOpenImage
+********************************************************************************
+* Summary:
+*    Opens an image file to stand in for the external memory on the host.
+*******************************************************************************/
+uint8_t speechStoreOpenImage(const char *path)
+{
+    if (gp_image != NULL)
+    {
+        fclose(gp_image);
+    }
+    gp_image = fopen(path, "rb");
+
+    return (gp_image != NULL);
+}
+#endif
+
+/*******************************************************************************
+* Function Name: speechStoreStart
+********************************************************************************
+* Summary:
+*    Starts the SPI bus and reads the image header.
+*******************************************************************************/
+uint8_t speechStoreStart(void)
+{
+    uint8_t header[STORE_HEADER_SIZE];
+
+    #if SPEECH_STORE_HOST == 0
+        Pin_Flash_CS_Write(1);
+        SPIM_Flash_Start();
+    #endif
+
+    storeRead(0, header, STORE_HEADER_SIZE);
+
+    gb_store_valid = (header[0] == 'L') && (header[1] == 'P') &&
+                     (header[2] == 'C') && (header[3] == 'S') &&
+                     (header[4] == SPEECH_STORE_VERSION);
+
+    g_language_count  = header[5];
+    g_utterance_count = (uint16_t)(header[6] | (header[7] << 8));
+    g_language = 0;
+    g_stalls = 0;
+
+    return gb_store_valid;
+}
+
+/*******************************************************************************
+* Function Name: speechStoreSelectLanguage
+********************************************************************************
+* Summary:
+*    Selects the language bank used for subsequent lookups.
+*******************************************************************************/
+uint8_t speechStoreSelectLanguage(uint8_t language)
+{
+    if (!gb_store_valid || language >= g_language_count)
+    {
+        return 0;
+    }
+    g_language = language;
+
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: speechStoreOpen
+********************************************************************************
+* Summary:
+*    Looks up the offset and length of an utterance in the index and fills
+*    both prefetch buffers with its first bytes.
+*******************************************************************************/
+uint8_t speechStoreOpen(uint16_t id)
+{
+    uint8_t entry[SPEECH_STORE_ENTRY_SIZE];
+    uint32_t entry_address;
+
+    /* Nothing to play - decoder reads end bytes */
+    g_fetch_remaining = 0;
+    g_buffer_length[0] = 0;
+    g_buffer_length[1] = 0;
+    g_front = 0;
+    g_position = 0;
+    gb_back_ready = 0;
+
+    if (!gb_store_valid || id >= g_utterance_count)
+    {
+        return 0;
+    }
+
+    entry_address = STORE_HEADER_SIZE +
+        ((uint32_t)g_language * g_utterance_count + id) * SPEECH_STORE_ENTRY_SIZE;
+    storeRead(entry_address, entry, SPEECH_STORE_ENTRY_SIZE);
+
+    g_fetch_address   = entry[0] | ((uint32_t)entry[1] << 8) | ((uint32_t)entry[2] << 16);
+    g_fetch_remaining = entry[3] | ((uint32_t)entry[4] << 8);
+
+    fillBuffer(0);
+    speechStorePrefetch();
+
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: speechStoreNextByte
+********************************************************************************
+* Summary:
+*    Returns the next byte of the open utterance from the front buffer,
+*    swapping to the back buffer once the front buffer is consumed.
+*******************************************************************************/
+uint8_t speechStoreNextByte(void)
+{
+    if (g_position >= g_buffer_length[g_front])
+    {
+        if (!gb_back_ready)
+        {
+            if (0 == g_fetch_remaining)
+            {
+                return SPEECH_STORE_END_BYTE;
+            }
+
+            /* Prefetch did not keep up - read on demand */
+            g_stalls++;
+            fillBuffer(g_front ^ 1u);
+        }
+
+        g_front ^= 1u;
+        g_position = 0;
+        gb_back_ready = 0;
+    }
+
+    return g_buffer[g_front][g_position++];
+}
+
+/*******************************************************************************
+* Function Name: speechStorePrefetch
+********************************************************************************
+* Summary:
+*    Refills the back buffer while the decoder reads the front buffer.
+*******************************************************************************/
+void speechStorePrefetch(void)
+{
+    if (!gb_back_ready && g_fetch_remaining)
+    {
+        fillBuffer(g_front ^ 1u);
+        gb_back_ready = 1;
+    }
+}
+
+/*******************************************************************************
+* Function Name: speechStoreStalls
+********************************************************************************
+* Summary:
+*    Returns the number of reads that had to wait for the bus.
+*******************************************************************************/
+uint32_t speechStoreStalls(void)
+{
+    return g_stalls;
+}
+
+/*******************************************************************************
+* Function Name: fillBuffer
+********************************************************************************
+* Summary:
+*    Reads the next block of the open utterance into a prefetch buffer.
+*******************************************************************************/
+static void fillBuffer(uint8_t buffer_number)
+{
+    uint8_t length = SPEECH_STORE_BUFFER_SIZE;
+
+    if (g_fetch_remaining < SPEECH_STORE_BUFFER_SIZE)
+    {
+        length = (uint8_t)g_fetch_remaining;
+    }
+
+    storeRead(g_fetch_address, g_buffer[buffer_number], length);
+
+    g_buffer_length[buffer_number] = length;
+    g_fetch_address   += length;
+    g_fetch_remaining -= length;
+}
+
+#if SPEECH_STORE_HOST == 1
+/*******************************************************************************
+* Function Name: storeRead
+********************************************************************************
+* Summary:
+*    Reads a block of bytes from the image file. Bytes past the end of the
+*    file read as erased memory (0xFF).
+*******************************************************************************/
+static void storeRead(uint32_t address, uint8_t *buffer, uint16_t length)
+{
+    size_t count = 0;
+
+    if (gp_image != NULL && 0 == fseek(gp_image, (long)address, SEEK_SET))
+    {
+        count = fread(buffer, 1, length, gp_image);
+    }
+    while (count < length)
+    {
+        buffer[count++] = 0xFF;
+    }
+}
+
+#else
+/*******************************************************************************
+* Function Name: spiTransfer
+********************************************************************************
+* Summary:
+*    Clocks one byte out and returns the byte clocked in.
+*******************************************************************************/
+static uint8_t spiTransfer(uint8_t byte)
+{
+    SPIM_Flash_WriteTxData(byte);
+    while (0u == SPIM_Flash_GetRxBufferSize())
+    {
+        /* wait for the byte to be shifted in */
+    }
+
+    return SPIM_Flash_ReadRxData();
+}
+
+/*******************************************************************************
+* Function Name: storeRead
+********************************************************************************
+* Summary:
+*    Reads a block of bytes from the external memory.
+*******************************************************************************/
+static void storeRead(uint32_t address, uint8_t *buffer, uint16_t length)
+{
+    uint16_t i;
+
+    SPIM_Flash_ClearRxBuffer();
+    Pin_Flash_CS_Write(0);
+
+    (void)spiTransfer(STORE_CMD_READ);
+    (void)spiTransfer((uint8_t)(address >> 16));
+    (void)spiTransfer((uint8_t)(address >> 8));
+    (void)spiTransfer((uint8_t)address);
+
+    for (i = 0; i < length; i++)
+    {
+        buffer[i] = spiTransfer(0x00);
+    }
+
+    Pin_Flash_CS_Write(1);
+}
+#endif
+
+#endif /* SPEECH_STORE_MODE == 1 */
+
+/* [] END OF FILE */
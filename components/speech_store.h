@@ -0,0 +1,120 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:     speech_store.h
+* Version:  1.0.0
+*
+* Brief: Streaming LPC speech asset store in external SPI flash / FRAM.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*    - SPI_Master     [SPIM_Flash]
+*    - cy_pins        [Pin_Flash_CS]
+*
+* Image layout (all multi-byte fields little endian):
+*    offset 0 : 'L' 'P' 'C' 'S'                  magic
+*    offset 4 : uint8  version                   SPEECH_STORE_VERSION
+*    offset 5 : uint8  language count
+*    offset 6 : uint16 utterances per language
+*    offset 8 : index, language major, one entry per utterance id:
+*               uint24 offset of the LPC bitstream from start of image
+*               uint16 length of the LPC bitstream in bytes
+*    followed by the LPC bitstreams (python_wizard output, see custom_synth.h)
+*
+* Notes:
+*    The LPC decoder consumes at most 7 bytes per 25 ms frame. Bytes are served
+*    from one of two buffers while the other is refilled by
+*    speechStorePrefetch(), which lpc_decoder.c calls once per frame, so the
+*    decoder never waits on the bus.
+*    Only built with SPEECH_STORE_MODE 1 (mode.h), the mode that adds
+*    SPIM_Flash and Pin_Flash_CS to the design.
+*    Build with SPEECH_STORE_HOST = 1 to read the image from a file instead of
+*    SPIM_Flash (host tools and tests), which implies SPEECH_STORE_MODE 1.
+*
+*******************************************************************************/
+#ifndef SPEECH_STORE_H
+	#define SPEECH_STORE_H
+
+/*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+    #ifndef SPEECH_STORE_HOST
+        #define SPEECH_STORE_HOST 0
+    #endif
+
+    #if SPEECH_STORE_HOST == 1
+        #include <stdint.h>
+        #ifndef SPEECH_STORE_MODE
+            #define SPEECH_STORE_MODE 1
+        #endif
+    #else
+        #include <project.h>
+        #include "mode.h"
+    #endif
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+    /* Image format version understood by this driver */
+    #define SPEECH_STORE_VERSION        1
+
+    /* Size of each of the two prefetch buffers in bytes */
+    #define SPEECH_STORE_BUFFER_SIZE    32
+
+    /* Size of one index entry in bytes (uint24 offset + uint16 length) */
+    #define SPEECH_STORE_ENTRY_SIZE     5
+
+    /* Byte returned once an utterance is exhausted (decodes as an end frame) */
+    #define SPEECH_STORE_END_BYTE       0xFF
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+    #if SPEECH_STORE_HOST == 1
+        // Brief: Use an image file in place of the external memory.
+        // Param: path Path to the speech store image.
+        // Return: 1 if the file was opened, 0 otherwise.
+        uint8_t speechStoreOpenImage(const char *path);
+    #endif
+
+    // Brief: Start the bus and validate the image header.
+    // Param: none.
+    // Return: 1 if a valid image was found, 0 otherwise.
+    uint8_t speechStoreStart(void);
+
+    // Brief: Select the language bank used by speechStoreOpen().
+    // Param: language Language number (0 is the default bank).
+    // Return: 1 if the language exists in the image, 0 otherwise.
+    uint8_t speechStoreSelectLanguage(uint8_t language);
+
+    // Brief: Look up an utterance in the index and fill both buffers.
+    // Param: id Utterance id in the selected language bank.
+    // Return: 1 if the utterance exists, 0 otherwise.
+    uint8_t speechStoreOpen(uint16_t id);
+
+    // Brief: Read the next byte of the open utterance.
+    // Param: none.
+    // Return: next bitstream byte, SPEECH_STORE_END_BYTE once exhausted.
+    uint8_t speechStoreNextByte(void);
+
+    // Brief: Refill the idle buffer if it has been consumed.
+    // Param: none.
+    // Return: none
+    void speechStorePrefetch(void);
+
+    // Brief: Number of reads that had to wait for the bus since start.
+    // Param: none.
+    // Return: stall count (0 when prefetching keeps up).
+    uint32_t speechStoreStalls(void);
+
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,66 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    task_config.h
+* Version: 1.0.0
+*
+* Brief: Task priorities and periods, shared by main.c and the host tests
+*        (tests/host_sim.c), so the simulated schedule matches the firmware.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*   Priorities are relative to configMAX_PRIORITIES (FreeRTOSConfig.h) and
+*   the optional tasks follow the switches of mode.h, so include it after
+*   mode.h. No includes, so the host tests can use it as is.
+*
+*******************************************************************************/
+#ifndef TASK_CONFIG_H
+	#define TASK_CONFIG_H
+
+/*******************************************************************************
+*                               TASK PRIORITIES
+*******************************************************************************/
+#define TASK_GPS_PRIO           (configMAX_PRIORITIES - 2)
+#define TASK_PATH_PRIO          (configMAX_PRIORITIES - 3)
+#define TASK_MOTION_PRIO        (configMAX_PRIORITIES - 3)
+#define TASK_DIRECTION_PRIO     (configMAX_PRIORITIES - 4)
+#define TASK_SOUND_PRIO         (configMAX_PRIORITIES - 5)
+#define TASK_SPEECH_PRIO        (configMAX_PRIORITIES - 6)
+#define TASK_BATTERY_LEVEL_PRIO (configMAX_PRIORITIES - 7)
+#define TASK_BUTTON_PRIO        (configMAX_PRIORITIES - 1)
+#define TASK_LED_PRIO           (configMAX_PRIORITIES - 10)
+#if OBJ_DETECT_MODE == 1
+    #define TASK_MOTOR_PRIO     (configMAX_PRIORITIES - 8)
+    #define TASK_DIS_PRIO       (configMAX_PRIORITIES - 9)
+#endif
+#if CONSOLE_MODE == 1
+    #define TASK_CONSOLE_PRIO   (configMAX_PRIORITIES - 10)
+#endif
+#if TRACE_MODE == 1
+    #define TASK_TRACE_PRIO     (configMAX_PRIORITIES - 10)
+#endif
+#define TASK_DEBUG_TX_PRIO      (configMAX_PRIORITIES - 10)
+
+/*******************************************************************************
+*                                 TASK PERIODS
+*******************************************************************************/
+#define TASK_PATH_PERIOD_MS         1000
+#define TASK_MOTION_PERIOD_MS       50    // accelerometer samples for step detection
+#define TASK_DIRECTION_PERIOD_MS    250
+#define TASK_SOUND_PERIOD_MS        250
+#define BATTERY_SAMPLE_MS           1000  // fuel gauge sample period
+#if TRACE_MODE == 1
+    #define TRACE_DRAIN_MS          20    // time between trace ring drains
+#endif
+
+#endif
+
+/* [] END OF FILE */
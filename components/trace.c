@@ -0,0 +1,202 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    trace.c
+* Version: 1.0.0
+*
+* Brief: Deferred binary trace. Tasks and ISRs record a format id, timestamp
+*        and raw arguments; a low priority task sends them on the UART, and
+*        tools/trace_decode.c formats them on the host.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*   UART
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <project.h>
+#include "trace.h"
+#include "debug_tx.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+/* One stored record */
+typedef struct traceEntry{
+    volatile uint32 ready;      // index + 1 once the record is complete
+    uint32 timestamp;
+    uint32 args[TRACE_MAX_ARGS];
+    uint8  id;
+} traceEntry;
+
+/*******************************************************************************
+*   Variables
+*******************************************************************************/
+static traceEntry ring[TRACE_RING_SIZE];
+
+/* Next index to reserve, advanced by producers with compare-and-swap */
+static volatile uint32 head = 0;
+
+/* Next index to send, only advanced by traceDrain() */
+static volatile uint32 tail = 0;
+
+/* Records dropped because the ring was full, and how many were reported */
+static volatile uint32 dropped = 0;
+static uint32 droppedReported = 0;
+
+/* Frames sent, low byte goes in every frame */
+static uint8 sequence = 0;
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Send one record as a frame.
+static void sendFrame( uint8 id, uint32 timestamp, const uint32 *args );
+
+/*******************************************************************************
+* Function Name: traceRecord
+********************************************************************************
+* Summary:
+*   Reserve a slot by advancing head with compare-and-swap, so tasks and ISRs
+*   can record at the same time without locks. The slot is marked ready last,
+*   after a barrier, so traceDrain() never sends a half written record.
+*******************************************************************************/
+void traceRecord( uint8 id, uint32 a0, uint32 a1, uint32 a2, uint32 a3 )
+{
+    traceEntry *entry;
+    uint32 index;
+
+    do
+    {
+        index = head;
+        if ( index - tail >= TRACE_RING_SIZE )
+        {
+            __sync_fetch_and_add( &dropped, 1 );
+            return;
+        }
+    } while ( !__sync_bool_compare_and_swap( &head, index, index + 1 ) );
+
+    entry = &ring[index & (TRACE_RING_SIZE - 1)];
+    entry->id = id;
+    entry->timestamp = xTaskGetTickCountFromISR();
+    entry->args[0] = a0;
+    entry->args[1] = a1;
+    entry->args[2] = a2;
+    entry->args[3] = a3;
+    __sync_synchronize();
+    entry->ready = index + 1;
+}
+
+/*******************************************************************************
+* Function Name: traceDrain
+********************************************************************************
+* Summary:
+*   Send records in order until one is not ready yet, then report any new
+*   drops. Only one task may drain.
+*******************************************************************************/
+uint8 traceDrain( void )
+{
+    traceEntry *entry;
+    uint32 drops;
+    uint8 sent = 0;
+
+    while ( tail != head )
+    {
+        entry = &ring[tail & (TRACE_RING_SIZE - 1)];
+        if ( entry->ready != tail + 1 )
+        {
+            break;
+        }
+        sendFrame( entry->id, entry->timestamp, entry->args );
+        __sync_synchronize();
+        tail = tail + 1;
+        sent++;
+    }
+
+    drops = dropped;
+    if ( drops != droppedReported )
+    {
+        uint32 args[TRACE_MAX_ARGS] = { drops - droppedReported, 0, 0, 0 };
+        sendFrame( TRACE_DROPPED, xTaskGetTickCount(), args );
+        droppedReported = drops;
+    }
+
+    return sent;
+}
+
+/*******************************************************************************
+* Function Name: sendFrame
+********************************************************************************
+* Summary:
+*   Build a TRACE_FRAME_SIZE frame (see trace_formats.h) and queue it on the
+*   debug transmit path. A frame that does not fit is dropped whole; the
+*   decoder reports the gap from the sequence number.
+*******************************************************************************/
+static void sendFrame( uint8 id, uint32 timestamp, const uint32 *args )
+{
+    uint8 frame[TRACE_FRAME_SIZE];
+    uint8 sum = 0;
+    uint8 i, j;
+
+    frame[0] = TRACE_SYNC;
+    frame[1] = id;
+    frame[2] = sequence++;
+    frame[3] = 0;
+    for ( j = 0; j < 4; j++ )
+    {
+        frame[4 + j] = (uint8)( timestamp >> (8 * j) );
+    }
+    for ( i = 0; i < TRACE_MAX_ARGS; i++ )
+    {
+        for ( j = 0; j < 4; j++ )
+        {
+            frame[8 + 4 * i + j] = (uint8)( args[i] >> (8 * j) );
+        }
+    }
+    for ( i = 0; i < TRACE_FRAME_SIZE; i++ )
+    {
+        sum += frame[i];
+    }
+    frame[3] = (uint8)( 0 - sum );
+
+    debugWrite( frame, TRACE_FRAME_SIZE );
+}
+
+/*******************************************************************************
+* Function Name: traceFloat
+********************************************************************************
+* Summary:
+*   Raw bits of a float argument.
+*******************************************************************************/
+uint32 traceFloat( float value )
+{
+    union { float f; uint32 u; } bits;
+
+    bits.f = value;
+    return bits.u;
+}
+
+/*******************************************************************************
+* Function Name: traceCoordinate
+********************************************************************************
+* Summary:
+*   Coordinate argument in 1e-7 degrees (full GPS resolution, float would
+*   round to about 1 m).
+*******************************************************************************/
+uint32 traceCoordinate( double degrees )
+{
+    return (uint32)(int32)( degrees * 1e7 + ( degrees < 0 ? -0.5 : 0.5 ) );
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,78 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    trace.h
+* Version: 1.0.0
+*
+* Brief: Deferred binary trace. Tasks and ISRs record a format id, timestamp
+*        and raw arguments; a low priority task sends them on the UART, and
+*        tools/trace_decode.c formats them on the host.
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Components:
+*   UART
+*
+* Notes:
+*   Recording costs a compare-and-swap on the ring head (LDREX/STREX) and six
+*   word stores: no formatting, no locks, no blocking, callable from ISRs.
+*   When the ring is full records are dropped and counted; the count is sent
+*   as a TRACE_DROPPED record. Formats live in trace_formats.h.
+*
+*   Usage: TRACE( TRACE_DISTANCE, d1, d2, d3 ); floats through traceFloat(),
+*   coordinates through traceCoordinate(). TRACE() compiles to nothing when
+*   TRACE_MODE is 0.
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <project.h>
+#include "mode.h"
+#include "trace_formats.h"
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+// Records held until sent, power of 2.
+#define TRACE_RING_SIZE     32
+
+// Record with 0..TRACE_MAX_ARGS arguments, missing ones are sent as 0.
+#if TRACE_MODE == 1
+    #define TRACE(...)      TRACE_ARGS(__VA_ARGS__, 0, 0, 0, 0, 0)
+    #define TRACE_ARGS(id, a0, a1, a2, a3, ...) \
+        traceRecord( (id), (uint32)(a0), (uint32)(a1), (uint32)(a2), (uint32)(a3) )
+#else
+    #define TRACE(...)
+#endif
+
+/*******************************************************************************
+*   Function Declarations
+*******************************************************************************/
+// Brief: Store one record, drops it if the ring is full.
+// Param: id Format id, a0..a3 Raw arguments.
+// Return: none.
+void traceRecord( uint8 id, uint32 a0, uint32 a1, uint32 a2, uint32 a3 );
+
+// Brief: Send every stored record on the UART.
+// Param: none.
+// Return: number of records sent.
+uint8 traceDrain( void );
+
+// Brief: Raw bits of a float argument.
+// Param: value Float to record.
+// Return: argument word.
+uint32 traceFloat( float value );
+
+// Brief: Coordinate argument in 1e-7 degrees.
+// Param: degrees Latitude or longitude.
+// Return: argument word.
+uint32 traceCoordinate( double degrees );
+
+/* [] END OF FILE */
@@ -0,0 +1,65 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    trace_formats.h
+* Version: 1.0.0
+*
+* Brief: Trace record formats, shared by the firmware and the host decoder
+*        (tools/trace_decode.c).
+*
+* Target device:
+*    CY8C5888LTI - LP097
+*
+* Code Tested With:
+*    - Silicon: PSoC 5LP
+*    - IDE: PSoC Creator 4.3
+*    - Compiler: GCC 5.4
+*
+* Notes:
+*   Each entry is X( id, printf format, argument types ), one type character
+*   per argument:
+*     'i' int32, 'u' uint32, 'f' float (traceFloat()),
+*     'c' coordinate in 1e-7 degrees (traceCoordinate()).
+*   Only append new formats at the end, so logs from older firmware still
+*   decode. No includes, so the host decoder can use it as is.
+*
+*******************************************************************************/
+#ifndef TRACE_FORMATS_H
+	#define TRACE_FORMATS_H
+
+// Wire frame, little endian: sync, id, sequence (low byte), checksum,
+// timestamp (RTOS ticks), TRACE_MAX_ARGS arguments. The checksum makes the
+// byte sum of the frame 0, so text on the same UART is told apart.
+#define TRACE_SYNC          0x7E
+#define TRACE_MAX_ARGS      4
+#define TRACE_FRAME_SIZE    (4 + 4 + 4 * TRACE_MAX_ARGS)
+
+// Record formats.
+#define TRACE_FORMATS(X) \
+    X( TRACE_DROPPED,         "Trace dropped %u records",                                 "u"    ) \
+    X( TRACE_GPS_POSITION,    "longitude: %.7f    latitude: %.7f",                        "cc"   ) \
+    X( TRACE_PATH_CHECKPOINT, "Current Checkpoint: H%d      Next Checkpoint:    H%d",     "ii"   ) \
+    X( TRACE_PATH_DISTANCE,   "Distance to next checkpoint: %.2f",                        "f"    ) \
+    X( TRACE_DIRECTION,       "Bearings: %.2f      Difference: %.2f",                     "ff"   ) \
+    X( TRACE_SOUND_OFFSET,    "offsetAngle: %.2f",                                        "f"    ) \
+    X( TRACE_DISTANCE,        "Distance 1 : %d cm   Distance 2 : %d cm   Distance 3 : %d cm", "iii" ) \
+    X( TRACE_MOTOR_URGENCY,   "urgency: %3d %3d %3d",                                     "iii"  ) \
+    X( TRACE_OBSTACLE,        "Obstacle %d: %d cm  %d cm/s  ttc %u ms",                   "iiiu" ) \
+    X( TRACE_ENERGY,          "Left state %d: active %u ms  asleep %u ms  %u uAh",        "iuuu" ) \
+    X( TRACE_RATE_PLAN,       "Rates: compass %u ms  sonar %u ms  sound %u ms  saving %u uA", "uuuu" ) \
+    X( TRACE_DEAD_RECKONING,  "Fix: dead reckoning off %u mm after %u steps  step %u mm  K %u mm", "uuuu" ) \
+    X( TRACE_KALMAN,          "Fix: innovation %u mm  sigma %u mm  hdop x10 %u  update %u us", "uuuu" ) \
+    X( TRACE_HEADING,         "Course: %u mm/s  compass bias %d ddeg  field %u of %u nT", "uiuu" )
+
+// Record ids.
+#define TRACE_ID(id, format, types) id,
+typedef enum traceId{
+    TRACE_FORMATS(TRACE_ID)
+    TRACE_ID_COUNT
+} traceId;
+#undef TRACE_ID
+
+#endif
+
+/* [] END OF FILE */
@@ -30,6 +30,10 @@
     /*Define your macro callbacks here */
     /*For more information, refer to the Writing Code topic in the PSoC Creator Help.*/
 
+    /* Ultrasonic sensor sequence complete - stores samples (distance.c) */
+    #define ADC_SAR_Seq_1_ISR_INTERRUPT_CALLBACK
+    void ADC_SAR_Seq_1_ISR_InterruptCallback( void );
+
     
 #endif /* CYAPICALLBACKS_H */   
 /* [] */
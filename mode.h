@@ -34,6 +34,25 @@
     // Run Obstacle Detection System.
     #define OBJ_DETECT_MODE  1
 
+    // Stream speech from the external SPI flash/FRAM speech store (requires
+    // SPIM_Flash and an image programmed with speech_store.h layout) instead
+    // of the utterances compiled into internal flash.
+    #define SPEECH_STORE_MODE 0
+
+    // Measure LPC decoder throughput with the DWT cycle counter in synth_isr
+    // (reported after each utterance when debugging).
+    #define SYNTH_PROFILE_MODE 0
+
+    // Run the UART profiling console (tasks, heap, queues commands). Command
+    // lines share the UART RX with the GPS, so they are sent as the
+    // proprietary sentence "$PSMAP,<command>" (CONSOLE_SENTENCE in console.h).
+    #define CONSOLE_MODE 1
+
+    // Record run-time data (positions, headings, distances, urgencies) in the
+    // binary trace (trace.h). Cheap enough to stay on in actual use; decode the
+    // UART capture with tools/trace_decode.c.
+    #define TRACE_MODE 1
+
 #endif
 
 /* [] END OF FILE */
@@ -0,0 +1,477 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    host_sim.c
+* Version: 1.0.0
+*
+* Brief: Host test driver for the simulations built into the pure modules.
+*        Runs each one and fails if it reports errors or its results fall
+*        behind the limits below.
+*
+* Build:
+*    make -C tests            builds and runs it (see tests/Makefile)
+*
+* Notes:
+*    Every simulation is deterministic (fixed seeds), so a result past its
+*    limit is a regression in the module, not noise. The limits leave some
+*    room over the results reported when each module was added:
+*      navigation      10000 sessions back to IDLE, 0 errors, no heap use
+*      periodic        delay-until: 0 deadline misses, jitter 8.5 ms
+*      fuel gauge      compensated: worst 4 %, mean 0.67 %
+*      rate policy     87..89 % classified right, wake 250..750 ms
+*      dead reckoning  5 s fixes: 2.3 m, last fix held 3.8 m
+*      kalman filter   1 s fixes: 4.0 -> 2.6 m, jitter 5.4 -> 1.5 m
+*      heading fusion  13.4 -> 3.2 deg, 90 -> 4 swings, 98 % flagged
+*      sonar schedule  10 s at 120/300/80 cm, readings/s and corrupted with
+*                      no/adjacent/all-pairs crosstalk:
+*                        together 29.7, 0/99/198; chain 19.8, 0/0/0;
+*                        interleaved 29.7, 0/0/99
+*      occupancy       a 1 m obstacle moves from the centre to the left arc
+*                      on a 60 deg right turn and expires after the window
+*      obstacle        a still wall entering the arc gives no urgency,
+*                      approaching at 1 m/s is felt from 4 s away
+*    The heap check uses glibc mallinfo2() and is skipped elsewhere.
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <stdio.h>
+#if defined(__GLIBC__)
+    #include <malloc.h>
+#endif
+#include "navigation.h"
+#include "periodic.h"
+#include "fuel_gauge.h"
+#include "rate_policy.h"
+#include "dead_reckoning.h"
+#include "kalman_filter.h"
+#include "heading_fusion.h"
+#include "sonar_schedule.h"
+#include "occupancy.h"
+#include "obstacle.h"
+
+/* task_config.h as the firmware builds it: FreeRTOSConfig.h priorities,
+   trace on (mode.h) */
+#define configMAX_PRIORITIES    11
+#define TRACE_MODE              1
+#include "task_config.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+#define HOUR_MS             3600000u
+
+/* Distance frame period of the sonar array (ms) */
+#define SONAR_FRAME_MS      100
+
+/* Sonar simulation length (ms) and targets in front of each sensor (cm) */
+#define SONAR_SIM_MS        10000u
+static const uint16_t SONAR_TARGETS[SONAR_SENSORS] = { 120, 300, 80 };
+
+/* Periodic tasks of main.c: name, period (ms), execution (us), priority */
+static const periodicSimTask PERIODIC_TASKS[] = {
+    { "trace",     TRACE_DRAIN_MS,           300,  TASK_TRACE_PRIO },
+    { "sound",     TASK_SOUND_PERIOD_MS,     2000, TASK_SOUND_PRIO },
+    { "direction", TASK_DIRECTION_PERIOD_MS, 4000, TASK_DIRECTION_PRIO },
+    { "motion",    TASK_MOTION_PERIOD_MS,    1000, TASK_MOTION_PRIO },
+    { "path",      TASK_PATH_PERIOD_MS,      1500, TASK_PATH_PRIO },
+};
+
+#define PERIODIC_COUNT      ( sizeof(PERIODIC_TASKS) / sizeof(PERIODIC_TASKS[0]) )
+
+/*******************************************************************************
+*   Variables
+*******************************************************************************/
+static int failures = 0;
+
+/*******************************************************************************
+* Function Name: check
+********************************************************************************
+* Summary:
+*    Compares a result with its limit ("<=", ">=", "==" or ">"), prints it
+*    and counts a failure if the comparison does not hold.
+*******************************************************************************/
+static void check(const char *what, unsigned long value, const char *op, unsigned long limit)
+{
+    int pass;
+
+    switch (op[0])
+    {
+        case '<': pass = (value <= limit); break;
+        case '=': pass = (value == limit); break;
+        default:  pass = (op[1] == '=') ? (value >= limit) : (value > limit); break;
+    }
+
+    printf("  %-4s %-34s %8lu  %-2s %lu\n", pass ? "ok" : "FAIL", what, value, op, limit);
+    if (!pass)
+    {
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: heap_in_use
+********************************************************************************
+* Summary:
+*    Bytes allocated with malloc, 0 where the C library cannot tell.
+*******************************************************************************/
+static unsigned long heap_in_use(void)
+{
+    #if defined(__GLIBC__)
+        return (unsigned long)mallinfo2().uordblks;
+    #else
+        return 0;
+    #endif
+}
+
+/*******************************************************************************
+* Function Name: test_navigation
+********************************************************************************
+* Summary:
+*    Navigation sessions must all end in IDLE with no errors and leave
+*    the heap as it was.
+*******************************************************************************/
+static void test_navigation(void)
+{
+    navSimResult result;
+    unsigned long before, after;
+
+    printf("navigation: 10000 sessions with stray events\n");
+    before = heap_in_use();
+    navigationSimulate(10000, &result);
+    after = heap_in_use();
+
+    check("errors", result.errors, "==", 0);
+    check("sessions back to IDLE", result.sessions, "==", 10000);
+    check("heap bytes gained", after - before, "==", 0);
+}
+
+/*******************************************************************************
+* Function Name: test_periodic
+********************************************************************************
+* Summary:
+*    The main.c periodic tasks on vTaskDelayUntil must meet every
+*    deadline.
+*******************************************************************************/
+static void test_periodic(void)
+{
+    periodicTask timing[PERIODIC_COUNT];
+    unsigned long misses = 0, jitter = 0;
+    unsigned int i;
+
+    printf("periodic: main.c tasks for 10 s on vTaskDelayUntil\n");
+    periodicSimulate(PERIODIC_TASKS, timing, PERIODIC_COUNT, 10000, 1);
+
+    for (i = 0; i < PERIODIC_COUNT; i++)
+    {
+        misses += timing[i].misses;
+        if (timing[i].worstJitterUs > jitter)
+        {
+            jitter = timing[i].worstJitterUs;
+        }
+    }
+    check("deadline misses", misses, "==", 0);
+    check("worst release jitter (us)", jitter, "<=", 10000);
+}
+
+/*******************************************************************************
+* Function Name: test_fuel_gauge
+********************************************************************************
+* Summary:
+*    The load compensated gauge must track the simulated pack.
+*******************************************************************************/
+static void test_fuel_gauge(void)
+{
+    fuelSimResult result;
+
+    printf("fuel gauge: 20000 sample discharge, load compensated\n");
+    fuelGaugeSimulate(20000, 1, &result);
+
+    check("worst level error (%)", result.worstError, "<=", 5);
+    check("mean level error (% * 100)", result.meanErrorX100, "<=", 100);
+}
+
+/*******************************************************************************
+* Function Name: test_rate_policy
+********************************************************************************
+* Summary:
+*    Each battery band must classify motion and wake to full rate in
+*    time, and save current.
+*******************************************************************************/
+static void test_rate_policy(void)
+{
+    static const uint8_t LEVELS[] = { 80, 25, 10 };   // ok, low, critical
+    rateSimResult result;
+    unsigned int i;
+
+    for (i = 0; i < sizeof(LEVELS); i++)
+    {
+        printf("rate policy: one hour of walks and stops at %u %% battery\n", LEVELS[i]);
+        rateSimulate(HOUR_MS, LEVELS[i], &result);
+
+        check("time classified right (%)", result.correctPct, ">=", 85);
+        check("worst wake to full rate (ms)", result.worstWakeMs, "<=", 1000);
+        check("mean saving (uA)", result.savedUa, ">", 0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_dead_reckoning
+********************************************************************************
+* Summary:
+*    Steps must be counted and dead reckoning must beat holding the
+*    last fix.
+*******************************************************************************/
+static void test_dead_reckoning(void)
+{
+    deadReckonSimResult result;
+    unsigned long missed;
+
+    printf("dead reckoning: one hour on a square, fixes every 5 s\n");
+    deadReckonSimulate(HOUR_MS, 5000, &result);
+
+    missed = (result.steps > result.strides) ? result.steps - result.strides
+                                             : result.strides - result.steps;
+    check("steps miscounted", missed, "<=", result.strides / 100);
+    check("mean error (mm)", result.meanErrorMm, "<=", 3000);
+    check("mean error, last fix held (mm)", result.holdMeanErrorMm, ">", result.meanErrorMm);
+}
+
+/*******************************************************************************
+* Function Name: test_kalman_filter
+********************************************************************************
+* Summary:
+*    Filtered fixes must beat raw fixes without rejecting good ones.
+*******************************************************************************/
+static void test_kalman_filter(void)
+{
+    kalmanReplayResult result;
+
+    printf("kalman filter: 3600 fixes at 1 s replayed\n");
+    kalmanReplay(3600, 1000, 5, &result);
+
+    check("mean error, filtered (mm)", result.filteredErrorMm, "<=", 3000);
+    check("mean error, raw (mm)", result.rawErrorMm, ">", result.filteredErrorMm);
+    check("standing jitter, filtered (mm)", result.filteredJumpMm, "<=", 2000);
+    check("fixes rejected", result.rejects, "<=", result.fixes / 20);
+}
+
+/*******************************************************************************
+* Function Name: test_heading_fusion
+********************************************************************************
+* Summary:
+*    The fused heading must beat the compass and flag disturbances.
+*******************************************************************************/
+static void test_heading_fusion(void)
+{
+    headingSimResult result;
+
+    printf("heading fusion: one hour on a square with disturbances\n");
+    headingSimulate(HOUR_MS, &result);
+
+    check("mean error, fused (0.1 deg)", result.fusedErrorDdeg, "<=", 50);
+    check("mean error, compass (0.1 deg)", result.compassErrorDdeg, ">", result.fusedErrorDdeg);
+    check("swings, fused", result.fusedSwings, "<=", 10);
+    check("disturbed time flagged (%)", result.detectedPct, ">=", 90);
+    check("clean time flagged (%)", result.falsePct, "<=", 1);
+}
+
+/*******************************************************************************
+* Function Name: sonar_run
+********************************************************************************
+* Summary:
+*    Runs one trigger policy against the simulated array with each
+*    crosstalk pattern. Fills corrupted[] and returns the readings and
+*    worst reading age of the run without crosstalk.
+*******************************************************************************/
+static void sonar_run(sonarPolicy policy, unsigned long corrupted[3], sonarSimResult *p_clean)
+{
+    static const sonarCrosstalk CROSSTALK[3] = {
+        SONAR_SIM_NO_CROSSTALK, SONAR_SIM_ADJACENT, SONAR_SIM_ALL
+    };
+    sonarSimResult result;
+    uint8_t sensor, i;
+
+    for (sensor = 0; sensor < SONAR_SENSORS; sensor++)
+    {
+        sonarSimSetDistance(sensor, SONAR_TARGETS[sensor]);
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        sonarScheduleStart(policy);
+        sonarSimulate(SONAR_SIM_MS, CROSSTALK[i], &result);
+        corrupted[i] = result.corrupted;
+        if (i == 0)
+        {
+            *p_clean = result;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_sonar_schedule
+********************************************************************************
+* Summary:
+*    Chain must never be corrupted, interleaved only by the outer pair
+*    hearing each other, and both must keep every sensor's reading fresh;
+*    interleaved must deliver at least the readings of chain.
+*******************************************************************************/
+static void test_sonar_schedule(void)
+{
+    unsigned long together[3], chain[3], interleaved[3];
+    sonarSimResult togetherRun, chainRun, interleavedRun;
+
+    printf("sonar schedule: 10 s at 120/300/80 cm, no/adjacent/all crosstalk\n");
+    sonar_run(SONAR_TOGETHER, together, &togetherRun);
+    sonar_run(SONAR_CHAIN, chain, &chainRun);
+    sonar_run(SONAR_INTERLEAVED, interleaved, &interleavedRun);
+
+    check("together, corrupted no crosstalk", together[0], "==", 0);
+    check("together, corrupted adjacent", together[1], ">", 0);
+    check("chain, corrupted no crosstalk", chain[0], "==", 0);
+    check("chain, corrupted adjacent", chain[1], "==", 0);
+    check("chain, corrupted all pairs", chain[2], "==", 0);
+    check("interleaved, corrupted adjacent", interleaved[1], "==", 0);
+    check("interleaved, corrupted all pairs", interleaved[2], "<=", together[2] / 2);
+    check("together, readings", togetherRun.readings, ">=", interleavedRun.readings);
+    check("interleaved, readings", interleavedRun.readings, ">=", chainRun.readings);
+    check("chain, readings", chainRun.readings, ">=", SONAR_SIM_MS / 1000 * 19);
+    check("together, worst age (ms)", togetherRun.worstAgeMs, "<=", 100);
+    check("chain, worst age (ms)", chainRun.worstAgeMs, "<=", 150);
+    check("interleaved, worst age (ms)", interleavedRun.worstAgeMs, "<=", 100);
+}
+
+/*******************************************************************************
+* Function Name: test_occupancy
+********************************************************************************
+* Summary:
+*    An obstacle must stay where it is on the compass as the user turns,
+*    move to the motor now facing it, expire after OCC_WINDOW_MS and keep
+*    its place across the 359 -> 0 degree wrap.
+*******************************************************************************/
+static void test_occupancy(void)
+{
+    uint32_t time;
+    unsigned long left = 0, centre = 0;
+
+    printf("occupancy: turn 60 deg right past an obstacle at 1 m, then 350 -> 10 deg\n");
+    occupancyReset();
+    occupancySetHeading(0);
+    for (time = 0; time <= 1000; time += SONAR_FRAME_MS)
+    {
+        occupancyUpdate(0, OCC_RANGE_CLEAR, time);
+        occupancyUpdate(1, 100, time);
+        occupancyUpdate(2, OCC_RANGE_CLEAR, time);
+    }
+    check("centre arc, facing it (cm)", occupancyCueRange(1, 1000), "==", 100);
+    check("left arc, facing it (cm)", occupancyCueRange(0, 1000), "==", OCC_RANGE_CLEAR);
+
+    /* Turned away, the sensors only see clear sectors beside it */
+    occupancySetHeading(60);
+    for (time = 1100; time <= 3000; time += SONAR_FRAME_MS)
+    {
+        occupancyUpdate(0, OCC_RANGE_CLEAR, time);
+        occupancyUpdate(1, OCC_RANGE_CLEAR, time);
+        occupancyUpdate(2, OCC_RANGE_CLEAR, time);
+        if (time == 1100)
+        {
+            left = occupancyCueRange(0, time);
+            centre = occupancyCueRange(1, time);
+        }
+    }
+    check("left arc, turned 60 right (cm)", left, "==", 100);
+    check("centre arc, turned 60 right (cm)", centre, "==", OCC_RANGE_CLEAR);
+    check("left arc, at the window (cm)",
+          occupancyCueRange(0, 1000 + OCC_WINDOW_MS), "==", 100);
+    check("left arc, past the window (cm)",
+          occupancyCueRange(0, 1000 + OCC_WINDOW_MS + SONAR_FRAME_MS), "==", OCC_RANGE_CLEAR);
+
+    /* Across north: seen ahead at 350, still ahead at 10 */
+    occupancyReset();
+    occupancySetHeading(350);
+    occupancyUpdate(1, 80, 10000);
+    occupancySetHeading(370);
+    check("heading, 350 + 20 deg", (unsigned long)occupancyHeading(), "==", 10);
+    check("centre arc, 350 -> 10 deg (cm)", occupancyCueRange(1, 10100), "==", 80);
+    occupancyUpdate(0, 120, 10100);
+    check("left arc, seen at 340 deg (cm)", occupancyCueRange(0, 10100), "==", 120);
+}
+
+/*******************************************************************************
+* Function Name: obstacle_feed
+********************************************************************************
+* Summary:
+*    Feeds a range moving at rate (cm/s) to sensor 0 for a duration, one
+*    sample per sonar frame from *p_time. Returns the highest urgency.
+*******************************************************************************/
+static uint8_t obstacle_feed(int16_t range, int16_t rate, uint32_t ms, uint32_t *p_time)
+{
+    uint32_t t;
+    uint8_t urgency, worst = 0;
+
+    for (t = 0; t < ms; t += SONAR_FRAME_MS)
+    {
+        obstacleUpdate(0, (int16_t)(range + (int32_t)rate * (int32_t)t / 1000), *p_time);
+        urgency = obstacleUrgency(0);
+        if (urgency > worst)
+        {
+            worst = urgency;
+        }
+        *p_time += SONAR_FRAME_MS;
+    }
+    return worst;
+}
+
+/*******************************************************************************
+* Function Name: test_obstacle
+********************************************************************************
+* Summary:
+*    Range steps (boot, turning towards a wall, an arc clearing) must not be
+*    taken for a closing speed; a real approach must still be felt early.
+*******************************************************************************/
+static void test_obstacle(void)
+{
+    obstacleTrack track;
+    uint32_t time = 0;
+    unsigned long worst;
+
+    printf("obstacle: still walls entering the arc, then an approach at 1 m/s\n");
+    obstacleReset();
+    worst = obstacle_feed(200, 0, 2000, &time);                 // boot facing a wall
+    check("urgency, wall at 2 m from boot", worst, "==", 0);
+
+    obstacle_feed(OCC_RANGE_CLEAR, 0, 2000, &time);
+    worst = obstacle_feed(200, 0, 3000, &time);                 // turn to face it
+    check("urgency, clear to wall at 2 m", worst, "==", 0);
+
+    obstacle_feed(400, 0, 2000, &time);
+    worst = obstacle_feed(200, 0, 3000, &time);                 // nearer wall in the arc
+    check("urgency, wall at 4 m to 2 m", worst, "==", 0);
+
+    obstacle_feed(400, 0, 1000, &time);
+    obstacle_feed(400, -100, 1500, &time);                      // walk towards it
+    obstacleGet(0, &track);
+    check("closing speed at 2.5 m (cm/s)", (unsigned long)-track.rate, ">=", 80);
+    check("urgency at 2.5 m", track.urgency, ">", 0);
+}
+
+int main(void)
+{
+    test_navigation();
+    test_periodic();
+    test_fuel_gauge();
+    test_rate_policy();
+    test_dead_reckoning();
+    test_kalman_filter();
+    test_heading_fusion();
+    test_sonar_schedule();
+    test_occupancy();
+    test_obstacle();
+
+    printf("%d failed\n", failures);
+    return failures ? 1 : 0;
+}
+
+/* [] END OF FILE */
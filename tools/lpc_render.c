@@ -0,0 +1,279 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    lpc_render.c
+* Version: 1.0.0
+*
+* Brief: Host renderer for the LPC decoder. Renders every utterance of a
+*        speech store image to a WAV file, times lpc_render(), compares the
+*        output byte for byte against golden files and checks the block
+*        lattice kernel is bit exact with the C reference.
+*
+* Build:
+*    gcc -O2 -DSPEECH_STORE_HOST=1 -I../components -o lpc_render lpc_render.c
+*        ../components/lpc_decoder.c ../components/speech_store.c
+*
+* Usage:
+*    speech_image speech.img
+*    lpc_render speech.img out             render to out/<name>.wav
+*    lpc_render speech.img out golden      also compare with golden/<name>.wav
+*
+* Notes:
+*    Files are 8 kHz 16-bit mono WAV, the 9-bit decoder samples shifted up
+*    by 7 bits. Utterances play at normal rate, one lpc_read_frame() and one
+*    frame of lpc_render() at a time as synth_core() does, until the end
+*    frame. Output is deterministic, so the golden files in tools/golden
+*    only change when the decoder does; rerun without the golden directory
+*    into tools/golden to accept a deliberate change.
+*    lpc_lattice_compare() runs last, as on the target with
+*    SYNTH_PROFILE_MODE, but with the portable saturation of the host build.
+*    Exits with 1 if a file is missing or differs, or the kernel mismatches.
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lpc_decoder.h"
+#include "speech_store.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+#define MAX_SECONDS     30
+#define MAX_SAMPLES     ( SAMPLE_RATE * MAX_SECONDS )
+#define WAV_HEADER      44
+#define SAMPLE_SHIFT    7
+#define BENCH_REPEATS   20
+#define PATH_LENGTH     256
+
+/* File names of the utterances in speechId order (custom_synth.h) */
+static const char *NAMES[] = {
+    "welcome", "pause", "hargrave", "campbell", "centre", "arrived", "fix",
+    "ten", "twenty", "thirty", "fourty", "fifty", "sixty", "seventy",
+    "eighty", "ninety", "percent",
+};
+
+#define NAME_COUNT      ( sizeof(NAMES) / sizeof(NAMES[0]) )
+
+/*******************************************************************************
+*   Variables
+*******************************************************************************/
+static int16_t samples[MAX_SAMPLES];
+static uint8_t wav[WAV_HEADER + 2 * MAX_SAMPLES];
+static uint8_t golden[WAV_HEADER + 2 * MAX_SAMPLES + 1];
+
+/*******************************************************************************
+* Function Name: seconds
+********************************************************************************
+* Summary:
+*    Monotonic time in seconds.
+*******************************************************************************/
+static double seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+/*******************************************************************************
+* Function Name: render
+********************************************************************************
+* Summary:
+*    Renders one utterance into samples[], adding the time spent in
+*    lpc_render() to *p_time. Returns the number of samples.
+*******************************************************************************/
+static unsigned long render(uint16_t id, double *p_time)
+{
+    unsigned long count = 0;
+    double start;
+
+    lpc_start_stored(id);
+
+    while (count + LPC_FRAME_SAMPLES <= MAX_SAMPLES && lpc_read_frame())
+    {
+        start = seconds();
+        lpc_render(&samples[count], LPC_FRAME_SAMPLES);
+        *p_time += seconds() - start;
+        count += LPC_FRAME_SAMPLES;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: put_le
+********************************************************************************
+* Summary:
+*    Stores value as a little endian field of the given number of bytes.
+*******************************************************************************/
+static uint8_t *put_le(uint8_t *p_out, unsigned long value, int bytes)
+{
+    while (bytes-- > 0)
+    {
+        *p_out++ = (uint8_t)(value & 0xFF);
+        value >>= 8;
+    }
+    return p_out;
+}
+
+/*******************************************************************************
+* Function Name: make_wav
+********************************************************************************
+* Summary:
+*    Builds the WAV file of count samples in wav[]. Returns its size.
+*******************************************************************************/
+static unsigned long make_wav(unsigned long count)
+{
+    unsigned long data = 2 * count;
+    unsigned long i;
+    uint8_t *p = wav;
+
+    memcpy(p, "RIFF", 4);               p += 4;
+    p = put_le(p, 36 + data, 4);
+    memcpy(p, "WAVEfmt ", 8);           p += 8;
+    p = put_le(p, 16, 4);               // format chunk size
+    p = put_le(p, 1, 2);                // PCM
+    p = put_le(p, 1, 2);                // mono
+    p = put_le(p, SAMPLE_RATE, 4);
+    p = put_le(p, 2 * SAMPLE_RATE, 4);  // bytes per second
+    p = put_le(p, 2, 2);                // bytes per sample
+    p = put_le(p, 16, 2);               // bits per sample
+    memcpy(p, "data", 4);               p += 4;
+    p = put_le(p, data, 4);
+
+    for (i = 0; i < count; i++)
+    {
+        p = put_le(p, (uint16_t)(samples[i] * (1 << SAMPLE_SHIFT)), 2);
+    }
+
+    return WAV_HEADER + data;
+}
+
+/*******************************************************************************
+* Function Name: compare
+********************************************************************************
+* Summary:
+*    Compares size bytes of wav[] with a golden file. Returns 1 if they are
+*    identical, otherwise prints where they differ and returns 0.
+*******************************************************************************/
+static int compare(const char *path, unsigned long size)
+{
+    FILE *p_file = fopen(path, "rb");
+    unsigned long length, i;
+
+    if (p_file == NULL)
+    {
+        printf("  %s: missing\n", path);
+        return 0;
+    }
+    length = fread(golden, 1, sizeof(golden), p_file);
+    fclose(p_file);
+
+    for (i = 0; i < size && i < length; i++)
+    {
+        if (wav[i] != golden[i])
+        {
+            printf("  %s: differs at byte %lu\n", path, i);
+            return 0;
+        }
+    }
+    if (length != size)
+    {
+        printf("  %s: %lu bytes, rendered %lu\n", path, length, size);
+        return 0;
+    }
+
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    char name[32], path[PATH_LENGTH];
+    unsigned long count, size, total = 0;
+    double time = 0;
+    int failures = 0, repeat;
+    uint16_t mismatches;
+    uint16_t id;
+    FILE *p_out;
+
+    if (argc < 3 || argc > 4)
+    {
+        fprintf(stderr, "usage: %s <image> <out dir> [golden dir]\n", argv[0]);
+        return 1;
+    }
+
+    if (!speechStoreOpenImage(argv[1]) || !speechStoreStart())
+    {
+        fprintf(stderr, "%s: not a speech store image\n", argv[1]);
+        return 1;
+    }
+
+    for (id = 0; speechStoreOpen(id); id++)
+    {
+        if (id < NAME_COUNT)
+        {
+            snprintf(name, sizeof(name), "%s", NAMES[id]);
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "utterance%u", (unsigned int)id);
+        }
+
+        /* Rendering is deterministic, keep the last of the timed runs */
+        for (repeat = 0; repeat < BENCH_REPEATS; repeat++)
+        {
+            count = render(id, &time);
+        }
+        total += count * BENCH_REPEATS;
+        size = make_wav(count);
+
+        snprintf(path, sizeof(path), "%s/%s.wav", argv[2], name);
+        p_out = fopen(path, "wb");
+        if (p_out == NULL || fwrite(wav, 1, size, p_out) != size)
+        {
+            perror(path);
+            return 1;
+        }
+        fclose(p_out);
+
+        printf("%-10s %6lu samples  %5lu ms", name, count, count * 1000 / SAMPLE_RATE);
+        if (argc == 4)
+        {
+            snprintf(path, sizeof(path), "%s/%s.wav", argv[3], name);
+            if (compare(path, size))
+            {
+                printf("  matches golden\n");
+            }
+            else
+            {
+                failures++;
+            }
+        }
+        else
+        {
+            printf("\n");
+        }
+    }
+
+    if (time > 0)
+    {
+        printf("lpc_render: %lu samples in %.3f s, %.0f samples/s (%.0fx real time)\n",
+               total, time, total / time, total / time / SAMPLE_RATE);
+    }
+    if (argc == 4)
+    {
+        printf("%d of %u utterances differ from golden\n", failures, (unsigned int)id);
+    }
+
+    mismatches = lpc_lattice_compare();
+    printf("Lattice kernel mismatches: %u\n", (unsigned int)mismatches);
+
+    return (failures || mismatches) ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,220 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    ram_map.c
+* Version: 1.0.0
+*
+* Brief: Host RAM report for the firmware. Reads the symbol table of the
+*        build output and prints the RAM used by each task, queue and
+*        semaphore, the heap, and the largest other variables.
+*
+* Build:
+*    gcc -O2 -o ram_map ram_map.c
+*
+* Usage:
+*    arm-none-eabi-nm -S --size-sort sound-map.elf | ram_map > ram_map.txt
+*    Run it as the PSoC Creator post-build command (Build Settings > User
+*    Commands) to get a fresh report with every build.
+*
+* Notes:
+*    Kernel objects are grouped by the names main.c gives their static
+*    memory: <object>Stack and <object>Tcb for tasks, <object>Storage and
+*    <object>Buffer for queues and semaphores, with the object named xName or
+*    vTaskName like its handle or task function. The main stack and newlib
+*    heap reserved by the linker script are not symbols and not counted.
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+#define SRAM_BYTES      65536   // CY8C5888 SRAM
+#define MAX_OBJECTS     64
+#define MAX_OTHERS      512
+#define NAME_LENGTH     64
+#define OTHERS_LISTED   15
+
+enum { STACK, CONTROL, STORAGE, PARTS };
+
+/* Name suffix of each part of a kernel object */
+static const struct { const char *suffix; int part; } SUFFIXES[] = {
+    { "Stack", STACK }, { "Tcb", CONTROL }, { "Buffer", CONTROL }, { "Storage", STORAGE },
+};
+
+/*******************************************************************************
+*   Structures
+*******************************************************************************/
+typedef struct object{
+    char name[NAME_LENGTH];
+    unsigned long bytes[PARTS];
+    unsigned long total;
+} object;
+
+typedef struct symbol{
+    char name[NAME_LENGTH];
+    unsigned long bytes;
+} symbol;
+
+/*******************************************************************************
+*   Variables
+*******************************************************************************/
+static object objects[MAX_OBJECTS];
+static int objectCount = 0;
+static symbol others[MAX_OTHERS];
+static int otherCount = 0;
+
+/*******************************************************************************
+* Function Name: is_kernel_name
+********************************************************************************
+* Summary:
+*    Kernel objects are named like their handles and task functions, xName
+*    or vTaskName, which keeps buffers such as outputBuffer out of the table.
+*******************************************************************************/
+static int is_kernel_name(const char *name)
+{
+    return (name[0] == 'x' || name[0] == 'v') && name[1] >= 'A' && name[1] <= 'Z';
+}
+
+/*******************************************************************************
+* Function Name: add_part
+********************************************************************************
+* Summary:
+*    Adds a symbol to the object its name belongs to. Returns 0 if the name
+*    has no object suffix.
+*******************************************************************************/
+static int add_part(const char *name, unsigned long bytes)
+{
+    size_t length = strlen(name), suffix;
+    unsigned i;
+    int j;
+
+    for (i = 0; i < sizeof(SUFFIXES) / sizeof(SUFFIXES[0]); i++)
+    {
+        suffix = strlen(SUFFIXES[i].suffix);
+        if (length <= suffix || strcmp(name + length - suffix, SUFFIXES[i].suffix) != 0 ||
+            !is_kernel_name(name))
+        {
+            continue;
+        }
+
+        for (j = 0; j < objectCount; j++)
+        {
+            if (strlen(objects[j].name) == length - suffix &&
+                strncmp(objects[j].name, name, length - suffix) == 0)
+            {
+                break;
+            }
+        }
+        if (j == objectCount)
+        {
+            if (objectCount == MAX_OBJECTS)
+            {
+                return 0;
+            }
+            memcpy(objects[j].name, name, length - suffix);
+            objects[j].name[length - suffix] = 0;
+            objectCount++;
+        }
+        objects[j].bytes[SUFFIXES[i].part] += bytes;
+        objects[j].total += bytes;
+        return 1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: by_total, by_bytes
+********************************************************************************
+* Summary:
+*    qsort comparisons, largest first.
+*******************************************************************************/
+static int by_total(const void *a, const void *b)
+{
+    const object *x = a, *y = b;
+    return (x->total < y->total) - (x->total > y->total);
+}
+
+static int by_bytes(const void *a, const void *b)
+{
+    const symbol *x = a, *y = b;
+    return (x->bytes < y->bytes) - (x->bytes > y->bytes);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*    Reads "address size type name" lines, keeps RAM symbols (bss, data,
+*    common), groups them and prints the report.
+*******************************************************************************/
+int main(void)
+{
+    char line[256], name[NAME_LENGTH], type;
+    unsigned long address, bytes, kernel = 0, heap = 0, other = 0;
+    char *dot;
+    int i;
+
+    while (fgets(line, sizeof(line), stdin))
+    {
+        if (sscanf(line, "%lx %lx %c %63s", &address, &bytes, &type, name) != 4 ||
+            strchr("bBdDcC", type) == NULL)
+        {
+            continue;
+        }
+
+        /* Function statics are named name.1234 */
+        dot = strchr(name, '.');
+        if (dot != NULL)
+        {
+            *dot = 0;
+        }
+
+        if (strcmp(name, "ucHeap") == 0)
+        {
+            heap += bytes;
+        }
+        else if (add_part(name, bytes))
+        {
+            kernel += bytes;
+        }
+        else
+        {
+            if (otherCount < MAX_OTHERS)
+            {
+                strcpy(others[otherCount].name, name);
+                others[otherCount++].bytes = bytes;
+            }
+            other += bytes;
+        }
+    }
+
+    qsort(objects, objectCount, sizeof(object), by_total);
+    qsort(others, otherCount, sizeof(symbol), by_bytes);
+
+    printf("%-28s %7s %7s %7s %7s\n", "Object", "Stack", "Control", "Storage", "Total");
+    for (i = 0; i < objectCount; i++)
+    {
+        printf("%-28s %7lu %7lu %7lu %7lu\n", objects[i].name, objects[i].bytes[STACK],
+            objects[i].bytes[CONTROL], objects[i].bytes[STORAGE], objects[i].total);
+    }
+
+    printf("\nLargest other variables\n");
+    for (i = 0; i < otherCount && i < OTHERS_LISTED; i++)
+    {
+        printf("%-28s %7lu\n", others[i].name, others[i].bytes);
+    }
+
+    printf("\n%-28s %7lu\n", "Kernel objects", kernel);
+    printf("%-28s %7lu\n", "FreeRTOS heap", heap);
+    printf("%-28s %7lu\n", "Other variables", other);
+    printf("%-28s %7lu of %d bytes\n", "Total", kernel + heap + other, SRAM_BYTES);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,143 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    speech_image.c
+* Version: 1.0.0
+*
+* Brief: Host tool that writes the speech store image (see speech_store.h)
+*        from the utterances compiled into the firmware, ready to program
+*        into the external SPI flash / FRAM.
+*
+* Build:
+*    gcc -O2 -I../components -o speech_image speech_image.c
+*
+* Usage:
+*    speech_image speech.img
+*
+* Notes:
+*    The arrays come from components/speech_phrases.h, the same ones
+*    custom_synth.c plays with SPEECH_STORE_MODE 0, so both builds speak
+*    the same bitstreams. PHRASES[] is in speechId order (custom_synth.h)
+*    and has to be kept in step with it. The image has one language bank;
+*    further banks go after it in the index, language major.
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#define SPEECH_STORE_HOST 1
+#include "speech_phrases.h"
+#include "speech_store.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+#define HEADER_SIZE     8
+#define LANGUAGES       1
+#define OFFSET_LIMIT    0x1000000UL     // uint24 offsets
+
+/* Utterances in speechId order */
+static const struct { const uint8_t *data; unsigned long size; } PHRASES[] = {
+    { welcome,  sizeof(welcome)  },     // SPEECH_WELCOME
+    { PAUSE,    sizeof(PAUSE)    },     // SPEECH_PAUSE
+    { HARGRAVE, sizeof(HARGRAVE) },     // SPEECH_HARGRAVE
+    { CAMPBELL, sizeof(CAMPBELL) },     // SPEECH_CAMPBELL
+    { CENTRE,   sizeof(CENTRE)   },     // SPEECH_CENTRE
+    { ARRIVED,  sizeof(ARRIVED)  },     // SPEECH_ARRIVED
+    { FIX,      sizeof(FIX)      },     // SPEECH_FIX
+    { TEN,      sizeof(TEN)      },     // SPEECH_TEN
+    { TWENTY,   sizeof(TWENTY)   },     // SPEECH_TWENTY
+    { THIRTY,   sizeof(THIRTY)   },     // SPEECH_THIRTY
+    { FOURTY,   sizeof(FOURTY)   },     // SPEECH_FOURTY
+    { FIFTY,    sizeof(FIFTY)    },     // SPEECH_FIFTY
+    { SIXTY,    sizeof(SIXTY)    },     // SPEECH_SIXTY
+    { SEVENTY,  sizeof(SEVENTY)  },     // SPEECH_SEVENTY
+    { EIGHTY,   sizeof(EIGHTY)   },     // SPEECH_EIGHTY
+    { NINETY,   sizeof(NINETY)   },     // SPEECH_NINETY
+    { PERCENT,  sizeof(PERCENT)  },     // SPEECH_PERCENT
+};
+
+#define PHRASE_COUNT    ( sizeof(PHRASES) / sizeof(PHRASES[0]) )
+
+/*******************************************************************************
+* Function Name: put_le
+********************************************************************************
+* Summary:
+*    Writes value as a little endian field of the given number of bytes.
+*******************************************************************************/
+static void put_le(FILE *p_out, unsigned long value, int bytes)
+{
+    while (bytes-- > 0)
+    {
+        fputc((int)(value & 0xFF), p_out);
+        value >>= 8;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    FILE *p_out;
+    unsigned long offset;
+    unsigned int language, i;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <image>\n", argv[0]);
+        return 1;
+    }
+
+    p_out = fopen(argv[1], "wb");
+    if (p_out == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    /* Header */
+    fputs("LPCS", p_out);
+    put_le(p_out, SPEECH_STORE_VERSION, 1);
+    put_le(p_out, LANGUAGES, 1);
+    put_le(p_out, PHRASE_COUNT, 2);
+
+    /* Index, bitstreams follow it in the same order */
+    offset = HEADER_SIZE + (unsigned long)LANGUAGES * PHRASE_COUNT * SPEECH_STORE_ENTRY_SIZE;
+    for (language = 0; language < LANGUAGES; language++)
+    {
+        for (i = 0; i < PHRASE_COUNT; i++)
+        {
+            put_le(p_out, offset, 3);
+            put_le(p_out, PHRASES[i].size, 2);
+            offset += PHRASES[i].size;
+        }
+    }
+
+    if (offset > OFFSET_LIMIT)
+    {
+        fprintf(stderr, "image of %lu bytes does not fit 24-bit offsets\n", offset);
+        fclose(p_out);
+        return 1;
+    }
+
+    /* Bitstreams */
+    for (language = 0; language < LANGUAGES; language++)
+    {
+        for (i = 0; i < PHRASE_COUNT; i++)
+        {
+            fwrite(PHRASES[i].data, 1, PHRASES[i].size, p_out);
+        }
+    }
+
+    if (fclose(p_out) != 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    printf("%s: %u utterances, %u language, %lu bytes\n",
+           argv[1], (unsigned int)PHRASE_COUNT, LANGUAGES, offset);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,180 @@
+/*******************************************************************************
+* Contributed to sound-map after the original firmware, for PSoC5LP
+* Created on 18/10/2026
+*
+* File:    trace_decode.c
+* Version: 1.0.0
+*
+* Brief: Host decoder for the binary trace (components/trace.h). Reads a
+*        UART capture and prints every trace record as text, passing other
+*        text on the UART through unchanged.
+*
+* Build:
+*    gcc -O2 -I../components -o trace_decode trace_decode.c
+*
+* Usage:
+*    trace_decode < capture.bin
+*    Each record prints as "[ticks] text", with a note for missing sequence
+*    numbers (bytes lost on the UART).
+*
+*******************************************************************************
+*   Included Headers
+*******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "trace_formats.h"
+
+/*******************************************************************************
+*   Constant definitions
+*******************************************************************************/
+#define TRACE_FORMAT(id, format, types) format,
+static const char *FORMATS[] = { TRACE_FORMATS(TRACE_FORMAT) };
+#undef TRACE_FORMAT
+
+#define TRACE_TYPES(id, format, types) types,
+static const char *TYPES[] = { TRACE_FORMATS(TRACE_TYPES) };
+#undef TRACE_TYPES
+
+/*******************************************************************************
+* Function Name: read32
+********************************************************************************
+* Summary:
+*    Little endian word from a frame.
+*******************************************************************************/
+static uint32_t read32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+        ((uint32_t)p[3] << 24);
+}
+
+/*******************************************************************************
+* Function Name: is_frame
+********************************************************************************
+* Summary:
+*    Checks sync, id and checksum of a candidate frame.
+*******************************************************************************/
+static int is_frame(const uint8_t *p)
+{
+    uint8_t sum = 0;
+    int i;
+
+    if (p[0] != TRACE_SYNC || p[1] >= TRACE_ID_COUNT)
+    {
+        return 0;
+    }
+    for (i = 0; i < TRACE_FRAME_SIZE; i++)
+    {
+        sum += p[i];
+    }
+    return sum == 0;
+}
+
+/*******************************************************************************
+* Function Name: print_record
+********************************************************************************
+* Summary:
+*    Formats a record, one printf per conversion with the argument converted
+*    from its raw word by the format's type string.
+*******************************************************************************/
+static void print_record(const uint8_t *p)
+{
+    const char *format = FORMATS[p[1]];
+    const char *types = TYPES[p[1]];
+    char spec[16];
+    uint32_t raw;
+    float f;
+    int arg = 0;
+    size_t n;
+
+    printf("[%10lu] ", (unsigned long)read32(p + 4));
+
+    while (*format)
+    {
+        if (*format != '%')
+        {
+            putchar(*format++);
+            continue;
+        }
+        if (format[1] == '%')
+        {
+            putchar('%');
+            format += 2;
+            continue;
+        }
+
+        /* Copy the conversion up to and including its letter */
+        n = strcspn(format + 1, "diufeEgGxXc") + 2;
+        if (n >= sizeof(spec) || arg >= TRACE_MAX_ARGS || types[arg] == 0)
+        {
+            break;
+        }
+        memcpy(spec, format, n);
+        spec[n] = 0;
+        format += n;
+
+        raw = read32(p + 8 + 4 * arg);
+        switch (types[arg++])
+        {
+            case 'f':
+                memcpy(&f, &raw, sizeof(f));
+                printf(spec, (double)f);
+                break;
+            case 'c':
+                printf(spec, (int32_t)raw / 1e7);
+                break;
+            case 'u':
+                printf(spec, (unsigned)raw);
+                break;
+            default:
+                printf(spec, (int)(int32_t)raw);
+                break;
+        }
+    }
+    putchar('\n');
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*    Slides over the capture: a valid frame is decoded and skipped, any other
+*    byte is passed through as text.
+*******************************************************************************/
+int main(void)
+{
+    uint8_t window[TRACE_FRAME_SIZE];
+    int fill = 0;
+    int expected = -1;
+    int c;
+
+    while ((c = getchar()) != EOF)
+    {
+        window[fill++] = (uint8_t)c;
+        if (fill < TRACE_FRAME_SIZE)
+        {
+            continue;
+        }
+
+        if (is_frame(window))
+        {
+            if (expected >= 0 && window[2] != expected)
+            {
+                printf("[  lost %3d frames ]\n", (uint8_t)(window[2] - expected));
+            }
+            expected = (uint8_t)(window[2] + 1);
+            print_record(window);
+            fill = 0;
+        }
+        else
+        {
+            putchar(window[0]);
+            memmove(window, window + 1, TRACE_FRAME_SIZE - 1);
+            fill--;
+        }
+    }
+    fwrite(window, 1, fill, stdout);
+    return 0;
+}
+
+/* [] END OF FILE */